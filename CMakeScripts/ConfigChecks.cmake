@@ -6,6 +6,7 @@ include(CheckIncludeFileCXX)
 include(CheckFunctionExists)
 include(CheckStructHasMember)
 include(CheckCXXSymbolExists)
+include(CheckCXXSourceCompiles)
 
 set(CMAKE_REQUIRED_LIBRARIES ${CMAKE_REQUIRED_LIBRARIES} ${INKSCAPE_LIBS})
 set(CMAKE_REQUIRED_INCLUDES ${CMAKE_REQUIRED_INCLUDES} ${INKSCAPE_INCS_SYS})
@@ -22,6 +23,24 @@ CHECK_STRUCT_HAS_MEMBER("struct mallinfo" uordblks malloc.h HAVE_STRUCT_MALLINFO
 CHECK_STRUCT_HAS_MEMBER("struct mallinfo" usmblks  malloc.h HAVE_STRUCT_MALLINFO_USMBLKS  )
 CHECK_CXX_SYMBOL_EXISTS(sincos math.h HAVE_SINCOS)  # 2geom define
 
+# Floating point std::to_chars and std::from_chars came with GCC 11, and are not in the libc++ of
+# older macOS deployment targets. The policy that passes CMAKE_CXX_STANDARD to checks is newer
+# than the CMake we require, so the flag is given by hand.
+set(CMAKE_REQUIRED_FLAGS_SAVED ${CMAKE_REQUIRED_FLAGS})
+set(CMAKE_REQUIRED_FLAGS "${CMAKE_REQUIRED_FLAGS} ${CMAKE_CXX17_STANDARD_COMPILE_OPTION}")
+CHECK_CXX_SOURCE_COMPILES("
+#include <charconv>
+int main() {
+  char buf[32];
+  double d = 0;
+  auto const r = std::to_chars(buf, buf + sizeof(buf), 1.5, std::chars_format::fixed, 3);
+  std::from_chars(buf, r.ptr, d);
+  return d != 1.5;
+}
+"
+HAVE_FLOAT_CHARCONV)
+set(CMAKE_REQUIRED_FLAGS ${CMAKE_REQUIRED_FLAGS_SAVED})
+
 # Create the configuration files config.h in the binary root dir
 configure_file(${CMAKE_SOURCE_DIR}/config.h.cmake ${CMAKE_BINARY_DIR}/include/config.h)
 add_definitions(-DHAVE_CONFIG_H)
@@ -29,6 +29,9 @@
 /* Whether the Cairo PDF backend is available */
 #cmakedefine PANGO_ENABLE_ENGINE 1
 
+/* Define to 1 if std::to_chars and std::from_chars take floating point numbers. */
+#cmakedefine HAVE_FLOAT_CHARCONV 1
+
 /* Define to 1 if you have the <ieeefp.h> header file. */
 #cmakedefine HAVE_IEEEFP_H 1
 
@@ -0,0 +1,122 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+/** @file
+ * Thread pool for loops over many independent items, such as paths or texts.
+ *//*
+ * Authors: see git history
+ *
+ * Copyright (C) 2023 Authors
+ * Released under GNU GPL v2+, read the file 'COPYING' for more information.
+ */
+#ifndef INKSCAPE_ASYNC_WORKER_POOL_H
+#define INKSCAPE_ASYNC_WORKER_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include <boost/asio/post.hpp>
+#include <boost/asio/thread_pool.hpp>
+
+#include "preferences.h"
+
+namespace Inkscape::Async {
+
+/**
+ * Runs the iterations of loops on a thread pool sized by the threading preference, helped by the
+ * calling thread. The threads live as long as the object, so create one for a batch of loops
+ * rather than keeping it around.
+ */
+class WorkerPool
+{
+public:
+    WorkerPool()
+        : _numthreads(configuredThreads())
+    {
+        if (_numthreads > 1) {
+            _pool.emplace(_numthreads - 1);
+        }
+    }
+
+    /// The number of threads the preference asks for, including the calling one.
+    static int configuredThreads()
+    {
+        unsigned const hardware_threads = std::thread::hardware_concurrency();
+        return Inkscape::Preferences::get()->getIntLimited("/options/threading/numthreads",
+                                                           hardware_threads ? hardware_threads : 4, 1, 256);
+    }
+
+    int numThreads() const { return _numthreads; }
+
+    /**
+     * Call f(i) for every i in [0, count), and wait for all of them. The first exception thrown
+     * by f is rethrown once they have finished.
+     */
+    template <typename F>
+    void run(std::size_t count, F const &f)
+    {
+        std::atomic<std::size_t> next = 0;
+        std::exception_ptr error;
+        std::mutex mutex;
+
+        auto const work = [&] {
+            while (true) {
+                auto const i = next.fetch_add(1, std::memory_order_relaxed);
+                if (i >= count) {
+                    return;
+                }
+                try {
+                    f(i);
+                } catch (...) {
+                    auto lock = std::lock_guard(mutex);
+                    if (!error) {
+                        error = std::current_exception();
+                    }
+                }
+            }
+        };
+
+        std::vector<std::future<void>> helpers;
+        if (_pool && count > 1) {
+            auto const numhelpers = std::min<std::size_t>(_numthreads - 1, count - 1);
+            for (std::size_t i = 0; i < numhelpers; i++) {
+                auto task = std::make_shared<std::packaged_task<void()>>(work);
+                helpers.emplace_back(task->get_future());
+                boost::asio::post(*_pool, [task] { (*task)(); });
+            }
+        }
+        work();
+        for (auto &h : helpers) {
+            h.wait();
+        }
+
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+private:
+    int _numthreads;
+    std::optional<boost::asio::thread_pool> _pool;
+};
+
+} // namespace Inkscape::Async
+
+#endif // INKSCAPE_ASYNC_WORKER_POOL_H
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
@@ -78,6 +78,18 @@ CompositeUndoStackObserver::notifyUndoCommitEvent(Event* log)
 	this->_unlock();
 }
 
+void
+CompositeUndoStackObserver::notifyUndoExpiredEvent(Event* log)
+{
+	this->_lock();
+	for (auto &i : _active) {
+		if (!i.to_remove) {
+			i.issueUndoExpired(log);
+		}
+	}
+	this->_unlock();
+}
+
 void
 CompositeUndoStackObserver::notifyClearUndoEvent()
 {
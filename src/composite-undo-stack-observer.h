@@ -83,6 +83,17 @@ public:
 			this->_observer->notifyUndoCommitEvent(log);
 		}
 
+		/**
+		 * Issues an expired event to the UndoStackObserver that is associated with this
+		 * UndoStackObserverRecord.
+		 *
+		 * \param log The event log being dropped from the undo stack.
+		 */
+		void issueUndoExpired(Event* log)
+		{
+			this->_observer->notifyUndoExpiredEvent(log);
+		}
+
 		/**
 		 * Issue a clear undo event to the UndoStackObserver
 		 * that is associated with this
@@ -151,6 +162,7 @@ public:
 	 * \param log The event log being committed to the undo stack.
 	 */
 	void notifyUndoCommitEvent(Event* log) override;
+	void notifyUndoExpiredEvent(Event* log) override;
 
 	void notifyClearUndoEvent() override;
 	void notifyClearRedoEvent() override;
@@ -34,6 +34,12 @@ ConsoleOutputUndoObserver::notifyUndoCommitEvent(Event* /*log*/)
     //g_message("notifyUndoCommitEvent(SPDocumentUndo::maybe_done) called; log=%p\n", log->event);
 }
 
+void
+ConsoleOutputUndoObserver::notifyUndoExpiredEvent(Event* /*log*/)
+{
+    //g_message("notifyUndoExpiredEvent(DocumentUndo::maybeDone) called; log=%p\n", log->event);
+}
+
 void
 ConsoleOutputUndoObserver::notifyClearUndoEvent()
 {
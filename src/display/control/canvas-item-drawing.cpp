@@ -24,7 +24,9 @@
 #include "display/drawing-group.h"
 
 #include "helper/geom.h"
+#include "helper/mathfns.h"
 #include "ui/widget/canvas.h"
+#include "ui/widget/canvas/diskcache.h"
 #include "ui/widget/events/canvas-event.h"
 #include "ui/modifiers.h"
 
@@ -85,6 +87,15 @@ void CanvasItemDrawing::_update(bool)
 
     _bounds = expandedBy(_drawing->root()->drawbox(), 1); // Avoid aliasing artifacts
 
+    // Tiles can only be shared with other sessions while the document is identical to its file.
+    _disk_cache = get_canvas()->get_disk_cache();
+    _document_key.reset();
+    if (_disk_cache) {
+        if (auto desktop = get_canvas()->get_desktop()) {
+            _document_key = _disk_cache->document_key(desktop->getDocument());
+        }
+    }
+
     if (_cursor) {
         /* Mess with enter/leave notifiers */
         auto new_drawing_item = _drawing->pick(_c, _delta, _sticky * DrawingItem::PICK_STICKY | _pick_outline * DrawingItem::PICK_OUTLINE);
@@ -115,10 +126,58 @@ void CanvasItemDrawing::_update(bool)
  */
 void CanvasItemDrawing::_render(Inkscape::CanvasItemBuffer &buf) const
 {
+    if (_disk_cache && _document_key) {
+        _renderCached(buf);
+        return;
+    }
+
     auto dc = Inkscape::DrawingContext(buf.cr->cobj(), buf.rect.min());
     _drawing->render(dc, buf.rect, buf.outline_pass * DrawingItem::RENDER_OUTLINE);
 }
 
+/**
+ * Render drawing via the disk tile cache: every grid tile overlapping the buffer is loaded from
+ * the cache, or rendered in full and stored if missing, then composited into the buffer.
+ */
+void CanvasItemDrawing::_renderCached(Inkscape::CanvasItemBuffer &buf) const
+{
+    using UI::Widget::DiskTileCache;
+    using UI::Widget::DiskTileKey;
+    int constexpr size = DiskTileCache::tile_size;
+
+    auto const render_mode = DiskTileCache::render_key(*_drawing, buf.outline_pass);
+
+    int const x0 = Util::rounddown(buf.rect.left(), size) / size;
+    int const y0 = Util::rounddown(buf.rect.top(), size) / size;
+    int const x1 = Util::roundup(buf.rect.right(), size) / size;
+    int const y1 = Util::roundup(buf.rect.bottom(), size) / size;
+
+    for (int y = y0; y < y1; y++) {
+        for (int x = x0; x < x1; x++) {
+            auto const rect = Geom::IntRect::from_xywh(x * size, y * size, size, size);
+            auto const key = DiskTileKey::create(*_document_key, _drawing_affine, { x, y }, buf.device_scale, render_mode);
+
+            auto surface = Cairo::ImageSurface::create(Cairo::FORMAT_ARGB32, size * buf.device_scale, size * buf.device_scale);
+            cairo_surface_set_device_scale(surface->cobj(), buf.device_scale, buf.device_scale);
+
+            if (!_disk_cache->load(key, surface)) {
+                auto cr = Cairo::Context::create(surface);
+                auto dc = Inkscape::DrawingContext(cr->cobj(), rect.min());
+                _drawing->render(dc, rect, buf.outline_pass * DrawingItem::RENDER_OUTLINE);
+                _disk_cache->store(key, surface);
+            }
+
+            auto const part = rect & buf.rect;
+            buf.cr->save();
+            buf.cr->rectangle(part->left() - buf.rect.left(), part->top() - buf.rect.top(), part->width(), part->height());
+            buf.cr->clip();
+            buf.cr->set_source(surface, rect.left() - buf.rect.left(), rect.top() - buf.rect.top());
+            buf.cr->paint();
+            buf.cr->restore();
+        }
+    }
+}
+
 /**
  * Handle events directed at the drawing. We first attempt to handle them here.
  */
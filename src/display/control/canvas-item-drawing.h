@@ -17,9 +17,10 @@
  * Released under GNU GPL v2+, read the file 'COPYING' for more information.
  */
 
+#include <memory>
+#include <optional>
 #include <sigc++/sigc++.h>
 
-
 #include "canvas-item.h"
 
 namespace Inkscape {
@@ -28,6 +29,8 @@ class Drawing;
 class DrawingItem;
 class Updatecontext;
 
+namespace UI::Widget { class DiskTileCache; }
+
 class CanvasItemDrawing final : public CanvasItem
 {
 public:
@@ -58,6 +61,7 @@ protected:
 
     void _update(bool propagate) override;
     void _render(Inkscape::CanvasItemBuffer &buf) const override;
+    void _renderCached(Inkscape::CanvasItemBuffer &buf) const;
 
     // Selection
     Geom::Point _c;
@@ -69,6 +73,10 @@ protected:
     std::unique_ptr<Inkscape::Drawing> _drawing;
     Geom::Affine _drawing_affine;
 
+    // Persistent tile cache, if enabled and the document is eligible.
+    std::shared_ptr<UI::Widget::DiskTileCache> _disk_cache;
+    std::optional<uint64_t> _document_key;
+
     // Events
     bool _cursor = false;
     bool _sticky = false; // Pick anything, even if hidden.
@@ -10,6 +10,13 @@
  * Released under GNU GPL v2+, read the file 'COPYING' for more information.
  */
 
+#include <algorithm>
+#include <iterator>
+#include <vector>
+#include <boost/geometry/geometries/box.hpp>
+#include <boost/geometry/geometries/point.hpp>
+#include <boost/geometry/index/rtree.hpp>
+
 #include "drawing-group.h"
 #include "cairo-utils.h"
 #include "drawing-context.h"
@@ -20,9 +27,24 @@
 
 namespace Inkscape {
 
+// Groups with fewer children are picked by testing each of them.
+static std::size_t constexpr PICK_INDEX_THRESHOLD = 64;
+
+struct DrawingGroup::PickIndex
+{
+    using Point = boost::geometry::model::point<double, 2, boost::geometry::cs::cartesian>;
+    using Box = boost::geometry::model::box<Point>;
+    using Value = std::pair<Box, unsigned>; ///< Box and position among the children.
+
+    std::vector<DrawingItem *> children;
+    boost::geometry::index::rtree<Value, boost::geometry::index::quadratic<16>> tree;
+};
+
 DrawingGroup::DrawingGroup(Drawing &drawing)
     : DrawingItem(drawing) {}
 
+DrawingGroup::~DrawingGroup() = default;
+
 /**
  * Set whether the group returns children from pick calls.
  * Previously this feature was called "transparent groups".
@@ -61,9 +83,15 @@ unsigned DrawingGroup::_updateItem(Geom::IntRect const &area, UpdateContext cons
     }
 
     _bbox = {};
+    _pick_index.reset();
+
+    // Large groups update their children concurrently; the results are gathered below in order.
+    bool const updated = _drawing._updateChildrenParallel(*this, area, child_ctx, flags, reset);
 
     for (auto &c : _children) {
-        c.update(area, child_ctx, flags, reset);
+        if (!updated) {
+            c.update(area, child_ctx, flags, reset);
+        }
         if (c.visible()) {
             _bbox.unionWith(outline ? c.bbox() : c.drawbox());
         }
@@ -108,6 +136,40 @@ void DrawingGroup::_clipItem(DrawingContext &dc, RenderContext &rc, Geom::IntRec
 
 DrawingItem *DrawingGroup::_pickItem(Geom::Point const &p, double delta, unsigned flags)
 {
+    if (!_pick_index && _children.size() >= PICK_INDEX_THRESHOLD) {
+        // Index the union of the boxes DrawingItem::pick() may test, so that the children whose
+        // box does not come within delta of the point can be skipped.
+        _pick_index = std::make_unique<PickIndex>();
+        std::vector<PickIndex::Value> values;
+        for (auto &c : _children) {
+            auto box = c.bbox();
+            box.unionWith(c.drawbox());
+            if (auto glyphs = cast<DrawingGlyphs>(&c)) {
+                box.unionWith(glyphs->getPickBox());
+            }
+            if (box) {
+                values.emplace_back(PickIndex::Box({box->left(), box->top()}, {box->right(), box->bottom()}),
+                                    _pick_index->children.size());
+            }
+            _pick_index->children.push_back(&c);
+        }
+        _pick_index->tree = decltype(_pick_index->tree)(values.begin(), values.end());
+    }
+
+    if (_pick_index) {
+        std::vector<PickIndex::Value> values;
+        auto const query = PickIndex::Box({p.x() - delta, p.y() - delta}, {p.x() + delta, p.y() + delta});
+        _pick_index->tree.query(boost::geometry::index::intersects(query), std::back_inserter(values));
+        // Test the candidates in the order of the children, as below.
+        std::sort(values.begin(), values.end(), [] (auto const &a, auto const &b) { return a.second < b.second; });
+        for (auto const &value : values) {
+            if (auto picked = _pick_index->children[value.second]->pick(p, delta, flags)) {
+                return _pick_children ? picked : this;
+            }
+        }
+        return nullptr;
+    }
+
     for (auto &i : _children) {
         DrawingItem *picked = i.pick(p, delta, flags);
         if (picked) {
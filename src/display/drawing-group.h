@@ -13,6 +13,7 @@
 #ifndef INKSCAPE_DISPLAY_DRAWING_GROUP_H
 #define INKSCAPE_DISPLAY_DRAWING_GROUP_H
 
+#include <memory>
 #include "display/drawing-item.h"
 
 namespace Inkscape {
@@ -30,15 +31,21 @@ public:
     void setChildTransform(Geom::Affine const &);
 
 protected:
-    ~DrawingGroup() override = default;
+    ~DrawingGroup() override;
 
     unsigned _updateItem(Geom::IntRect const &area, UpdateContext const &ctx, unsigned flags, unsigned reset) override;
     unsigned _renderItem(DrawingContext &dc, RenderContext &rc, Geom::IntRect const &area, unsigned flags, DrawingItem const *stop_at) const override;
     void _clipItem(DrawingContext &dc, RenderContext &rc, Geom::IntRect const &area) const override;
     DrawingItem *_pickItem(Geom::Point const &p, double delta, unsigned flags) override;
     bool _canClip() const override { return true; }
+    void _childrenChanged() override { _pick_index.reset(); }
 
     std::unique_ptr<Geom::Affine> _child_transform;
+
+    // Spatial index of the children for picking in large groups. Built on first use, and
+    // discarded whenever the children or their boxes may have changed.
+    struct PickIndex;
+    std::unique_ptr<PickIndex> _pick_index;
 };
 
 } // namespace Inkscape
@@ -270,6 +270,7 @@ void DrawingItem::_setCached(bool cached, bool persistent)
         return;
     }
 
+    auto lock = _drawing._lockIfParallel();
     if (cached) {
         _cache = std::make_unique<CacheData>();
         _drawing._cached_items.insert(this);
@@ -414,6 +415,7 @@ void DrawingItem::setZOrder(unsigned zorder)
         auto it2 = _parent->_children.begin();
         std::advance(it2, std::min<unsigned>(zorder, _parent->_children.size()));
         _parent->_children.insert(it2, *this);
+        _parent->_childrenChanged();
         _markForRendering();
     });
 }
@@ -468,8 +470,7 @@ void DrawingItem::update(Geom::IntRect const &area, UpdateContext const &ctx, un
     bool const forcecache = _filter && filters;
 
     // Set reset flags according to propagation status
-    reset |= _propagate_state;
-    _propagate_state = 0;
+    reset |= _propagate_state.exchange(0);
 
     _state &= ~reset; // reset state of this item
 
@@ -612,31 +613,35 @@ void DrawingItem::update(Geom::IntRect const &area, UpdateContext const &ctx, un
         }
     }
     if (to_update & STATE_CACHE) {
-        // Remove old cache iterator.
-        if (_has_cache_iterator) {
-            _drawing._candidate_items.erase(_cache_iterator);
-            _has_cache_iterator = false;
-        }
-
         // Determine whether this item is cachable.
         bool isolated = _mask || _filter || _opacity < 0.995
             || _blend_mode != SP_CSS_BLEND_NORMAL
             || _isolation == SP_CSS_ISOLATION_ISOLATE
             || _child_type == ChildType::ROOT;
         bool cacheable = !_contains_unisolated_blend || isolated;
-
-        // Determine whether to make this item eligible for caching, by creating a cache iterator.
         double score = _cacheScore();
-        if (score >= CACHE_SCORE_THRESHOLD && cacheable) {
-            CacheRecord cr;
-            cr.score = score;
-            // if _cacheRect() is empty, a negative score will be returned from _cacheScore(),
-            // so this will not execute (cache score threshold must be positive)
-            cr.cache_size = _cacheRect()->area() * 4;
-            cr.item = this;
-            auto it = std::lower_bound(_drawing._candidate_items.begin(), _drawing._candidate_items.end(), cr, std::greater<CacheRecord>());
-            _cache_iterator = _drawing._candidate_items.insert(it, cr);
-            _has_cache_iterator = true;
+
+        {
+            auto lock = _drawing._lockIfParallel();
+
+            // Remove old cache iterator.
+            if (_has_cache_iterator) {
+                _drawing._candidate_items.erase(_cache_iterator);
+                _has_cache_iterator = false;
+            }
+
+            // Determine whether to make this item eligible for caching, by creating a cache iterator.
+            if (score >= CACHE_SCORE_THRESHOLD && cacheable) {
+                CacheRecord cr;
+                cr.score = score;
+                // if _cacheRect() is empty, a negative score will be returned from _cacheScore(),
+                // so this will not execute (cache score threshold must be positive)
+                cr.cache_size = _cacheRect()->area() * 4;
+                cr.item = this;
+                auto it = std::lower_bound(_drawing._candidate_items.begin(), _drawing._candidate_items.end(), cr, std::greater<CacheRecord>());
+                _cache_iterator = _drawing._candidate_items.insert(it, cr);
+                _has_cache_iterator = true;
+            }
         }
 
         /* Update cache if enabled.
@@ -690,6 +695,21 @@ struct MaskLuminanceToAlpha
     }
 };
 
+/**
+ * Round a filter rendering area outwards to a grid anchored at the corner of the drawbox.
+ * Subsampling filters (e.g. low quality blurs) then sample the same pixels whichever part of
+ * a cached item is re-rendered, so the updated parts match the rest of the cache seamlessly.
+ */
+static Geom::IntRect align_filter_area(Geom::IntRect const &area, Geom::IntRect const &drawbox)
+{
+    int constexpr grid = 64;
+    auto const offset = area.min() - drawbox.min(); // Non-negative as area lies within drawbox.
+    auto const min = drawbox.min() + Geom::IntPoint(offset.x() / grid * grid, offset.y() / grid * grid);
+    auto const max = min + Geom::IntPoint((area.max().x() - min.x() + grid - 1) / grid * grid,
+                                          (area.max().y() - min.y() + grid - 1) / grid * grid);
+    return *Geom::intersect(Geom::IntRect(min, max), drawbox);
+}
+
 /**
  * Rasterize items.
  * This method submits the drawing operations required to draw this item
@@ -763,7 +783,7 @@ unsigned DrawingItem::render(DrawingContext &dc, RenderContext &rc, Geom::IntRec
             }
             _cache->surface->prepare();
             dc.setOperator(ink_css_blend_to_cairo_operator(_blend_mode));
-            _cache->surface->paintFromCache(dc, carea, forcecache);
+            _cache->surface->paintFromCache(dc, carea);
             if (!carea) {
                 dc.setSource(0, 0, 0, 0);
                 return RENDER_OK;
@@ -823,7 +843,16 @@ unsigned DrawingItem::render(DrawingContext &dc, RenderContext &rc, Geom::IntRec
         return _renderItem(dc, rc, *carea, flags & ~RENDER_FILTER_BACKGROUND, stop_at);
     }
 
-    DrawingSurface intermediate(*carea, device_scale);
+    // rarea is the area to render. A filter reads its input from around the pixels it outputs,
+    // so when only part of the cache is dirty, that part is rendered with the margin the filter
+    // needs and just carea is painted back; the clean rest of the cache is not filtered again.
+    auto rarea = *carea;
+    if (forcecache && _cache && !(flags & RENDER_BYPASS_CACHE)) {
+        _filter->area_enlarge(rarea, this);
+        rarea = align_filter_area(*(rarea & _drawbox), *_drawbox);
+    }
+
+    DrawingSurface intermediate(rarea, device_scale);
     DrawingContext ict(intermediate);
     cairo_set_antialias(ict.raw(), cairo_get_antialias(dc.raw())); // propagate antialias setting
 
@@ -848,7 +877,7 @@ unsigned DrawingItem::render(DrawingContext &dc, RenderContext &rc, Geom::IntRec
     ict.paint();
     if (_clip) {
         ict.pushGroup();
-        _clip->clip(ict, rc, *carea);
+        _clip->clip(ict, rc, rarea);
         ict.popGroupToSource();
         ict.setOperator(CAIRO_OPERATOR_IN);
         ict.paint();
@@ -858,7 +887,7 @@ unsigned DrawingItem::render(DrawingContext &dc, RenderContext &rc, Geom::IntRec
     // 2. Render the mask if present and compose it with the clipping path + opacity.
     if (_mask) {
         ict.pushGroup();
-        _mask->render(ict, rc, *carea, flags);
+        _mask->render(ict, rc, rarea, flags);
 
         cairo_surface_t *mask_s = ict.rawTarget();
         // Convert mask's luminance to alpha
@@ -872,7 +901,7 @@ unsigned DrawingItem::render(DrawingContext &dc, RenderContext &rc, Geom::IntRec
     // 3. Render object itself
     ict.pushGroup();
     apply_antialias(ict, antialias);
-    render_result = _renderItem(ict, rc, *carea, flags, stop_at);
+    render_result = _renderItem(ict, rc, rarea, flags, stop_at);
 
     // 4. Apply filter.
     if (_filter && render_filters) {
@@ -883,9 +912,9 @@ unsigned DrawingItem::render(DrawingContext &dc, RenderContext &rc, Geom::IntRec
                 if (bg_root->_background_new || bg_root->_filter) break;
             }
             if (bg_root) {
-                DrawingSurface bg(*carea, device_scale);
+                DrawingSurface bg(rarea, device_scale);
                 DrawingContext bgdc(bg);
-                bg_root->render(bgdc, rc, *carea, flags | RENDER_FILTER_BACKGROUND, this);
+                bg_root->render(bgdc, rc, rarea, flags | RENDER_FILTER_BACKGROUND, this);
                 _filter->render(this, ict, &bgdc, rc);
                 rendered = true;
             }
@@ -1027,6 +1056,8 @@ DrawingItem *DrawingItem::pick(Geom::Point const &p, double delta, unsigned flag
         g_warning("Invalid state when picking: STATE_BBOX = %d, STATE_PICK = %d", _state & STATE_BBOX, _state & STATE_PICK);
         return nullptr;
     }
+    _drawing._pick_visited_count++;
+
     // ignore invisible and insensitive items unless sticky
     if (!(flags & PICK_STICKY) && !(_visible && _sensitive)) {
         return nullptr;
@@ -1106,6 +1137,13 @@ void DrawingItem::recursivePrintTree(unsigned level) const
  */
 void DrawingItem::_markForRendering()
 {
+    if (_drawing._parallel_update) {
+        // Ancestors and the canvas are shared between threads, so leave this until the end.
+        auto lock = std::lock_guard(_drawing._update_mutex);
+        _drawing._deferred_render_marks.emplace_back(this);
+        return;
+    }
+
     bool outline = _drawing.renderMode() == RenderMode::OUTLINE || _drawing.outlineOverlay();
     Geom::OptIntRect dirty = outline ? _bbox : _drawbox;
     if (!dirty) return;
@@ -1170,9 +1208,8 @@ void DrawingItem::_markForUpdate(unsigned flags, bool propagate)
     }
 
     if (_state & flags) {
-        unsigned oldstate = _state;
-        _state &= ~flags;
-        if (oldstate != _state && _parent) {
+        unsigned oldstate = _state.fetch_and(~flags);
+        if ((oldstate & flags) && _parent) {
             // If we actually reset anything in state, recurse on the parent.
             _parent->_markForUpdate(flags, false);
         } else {
@@ -1305,6 +1342,7 @@ void DrawingItem::unlink()
             case ChildType::NORMAL: {
                 auto it = _parent->_children.iterator_to(*this);
                 _parent->_children.erase(it);
+                _parent->_childrenChanged();
                 break;
             }
             case ChildType::CLIP:
@@ -13,6 +13,7 @@
 #ifndef INKSCAPE_DISPLAY_DRAWING_ITEM_H
 #define INKSCAPE_DISPLAY_DRAWING_ITEM_H
 
+#include <atomic>
 #include <memory>
 #include <list>
 #include <exception>
@@ -191,6 +192,7 @@ protected:
     virtual void _clipItem(DrawingContext &dc, RenderContext &rc, Geom::IntRect const &area) const {}
     virtual DrawingItem *_pickItem(Geom::Point const &p, double delta, unsigned flags) { return nullptr; }
     virtual bool _canClip() const { return false; }
+    virtual void _childrenChanged() {} ///< Called when children are reordered or removed outside of an update.
     virtual void _dropPatternCache() {}
 
     Drawing &_drawing;
@@ -235,8 +237,10 @@ protected:
     bool style_vector_effect_rotate : 1;
     bool style_vector_effect_fixed  : 1;
 
-    unsigned _state : 8;
-    unsigned _propagate_state : 8;
+    // Kept out of the bitfields below, since they are modified on ancestors by _markForUpdate(),
+    // and so must not share a memory location with anything a concurrent update writes.
+    std::atomic<unsigned char> _state;
+    std::atomic<unsigned char> _propagate_state;
     ChildType _child_type : 3;
     unsigned _background_new : 1; ///< Whether enable-background: new is set for this element
     unsigned _background_accumulate : 1; ///< Whether this element accumulates background 
@@ -230,7 +230,7 @@ void DrawingCache::prepare()
  * Paints the clean area from cache and modifies the @a area
  * parameter to the bounds of the region that must be repainted.
  */
-void DrawingCache::paintFromCache(DrawingContext &dc, Geom::OptIntRect &area, bool is_filter)
+void DrawingCache::paintFromCache(DrawingContext &dc, Geom::OptIntRect &area)
 {
     if (!area) return;
 
@@ -244,14 +244,6 @@ void DrawingCache::paintFromCache(DrawingContext &dc, Geom::OptIntRect &area, bo
     cairo_region_t *cache_region = cairo_region_copy(dirty_region);
     cairo_region_subtract(dirty_region, _clean_region);
 
-    if (is_filter && !cairo_region_is_empty(dirty_region)) { // To allow fast panning on high zoom on filters
-        cairo_region_destroy(cache_region);
-        cairo_region_destroy(dirty_region);
-        cairo_region_destroy(_clean_region);
-        _clean_region = cairo_region_create();
-        return;
-    }
-
     if (cairo_region_is_empty(dirty_region)) {
         area = Geom::OptIntRect();
     } else {
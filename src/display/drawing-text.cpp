@@ -10,6 +10,7 @@
  * Released under GNU GPL v2+, read the file 'COPYING' for more information.
  */
 
+#include <vector>
 #include "2geom/pathvector.h"
 
 #include "dither-lock.h"
@@ -20,6 +21,7 @@
 #include "drawing-surface.h"
 #include "drawing-text.h"
 #include "drawing.h"
+#include "glyph-cache.h"
 
 #include "helper/geom.h"
 
@@ -521,6 +523,11 @@ unsigned DrawingText::_renderItem(DrawingContext &dc, RenderContext &rc, Geom::I
         }
     }
 
+    // Plain filled text is composited from the glyph cache, if the drawing has one.
+    if (has_fill && !has_stroke && !decorate && _renderGlyphsCached(dc, has_fill)) {
+        return RENDER_OK;
+    }
+
     if (has_fill || has_stroke || has_td_fill || has_td_stroke) {
 
         // Determine order for fill and stroke.
@@ -722,6 +729,124 @@ unsigned DrawingText::_renderItem(DrawingContext &dc, RenderContext &rc, Geom::I
     return RENDER_OK;
 }
 
+/**
+ * Fill the glyphs through a coverage mask of the whole text, which is put together from the
+ * cached masks of its glyphs rather than by filling their outlines.
+ *
+ * The masks are added with saturation, so glyphs that overlap or touch, such as kerned pairs,
+ * combining marks and joined scripts, are filled once like their outlines are, without seams or
+ * twice the opacity where they meet. Glyphs too large to be cached are added from their outlines.
+ * The fill is then painted once through the mask. Cached glyphs are placed to the nearest
+ * 1/GlyphCache::subpixel_steps of a device pixel.
+ *
+ * @return False if the glyph cache is disabled or cannot be used for this text, in which case
+ * nothing was drawn.
+ */
+bool DrawingText::_renderGlyphsCached(DrawingContext &dc, CairoPatternUniqPtr const &fill) const
+{
+    auto const cache = _drawing.glyphCache();
+    if (!cache) {
+        return false;
+    }
+    for (auto &i : _children) {
+        auto g = cast<DrawingGlyphs>(&i);
+        if (!g) throw InvalidItemException();
+        if (g->pixbuf) {
+            return false; // SVG font glyphs are painted, not filled.
+        }
+    }
+
+    // Masks are rendered and composited in device pixels, which may differ from user space
+    // pixels by a device scale and offset.
+    double scale_x, scale_y, offset_x, offset_y;
+    cairo_surface_get_device_scale(dc.rawTarget(), &scale_x, &scale_y);
+    cairo_surface_get_device_offset(dc.rawTarget(), &offset_x, &offset_y);
+    cairo_matrix_t cm;
+    cairo_get_matrix(dc.raw(), &cm);
+    Geom::Affine to_device;
+    ink_matrix_to_2geom(to_device, cm);
+    to_device *= Geom::Scale(scale_x, scale_y) * Geom::Translate(offset_x, offset_y);
+
+    Inkscape::DrawingContext::Save save(dc);
+    dc.transform(_ctm);
+    auto dl = DitherLock(dc, _nrstyle.data.fill.ditherable() && _drawing.useDithering());
+    _nrstyle.applyFill(dc, fill); // The source stays locked to the user space of the text.
+    auto const fill_rule = cairo_get_fill_rule(dc.raw());
+    auto const antialias = cairo_get_antialias(dc.raw());
+
+    // From here on, user space is device pixels less the device offset.
+    cairo_identity_matrix(dc.raw());
+    dc.scale(1.0 / scale_x, 1.0 / scale_y);
+    double x0, y0, x1, y1;
+    cairo_clip_extents(dc.raw(), &x0, &y0, &x1, &y1);
+    auto const clip = Geom::Rect(x0 + offset_x, y0 + offset_y, x1 + offset_x, y1 + offset_y).roundOutwards();
+
+    auto const steps = GlyphCache::subpixel_steps;
+    auto const floor_div = [=] (int a) { return a / steps - (a % steps < 0); };
+
+    struct Placed
+    {
+        DrawingGlyphs const *glyphs;
+        std::shared_ptr<GlyphCache::Mask const> mask; ///< Null if filled from the outline.
+        Geom::IntPoint at;
+    };
+    std::vector<Placed> placed;
+    Geom::OptIntRect area;
+
+    for (auto &i : _children) {
+        auto g = static_cast<DrawingGlyphs const *>(&i);
+        if (!g->pathvec || g->pathvec->empty() || g->_ctm.isSingular()) continue;
+
+        // Split the glyph origin into whole pixels and a quantised subpixel position.
+        auto const glyph_to_device = g->_ctm * to_device;
+        auto const position = (glyph_to_device.translation() * steps).round();
+        auto const whole = Geom::IntPoint(floor_div(position.x()), floor_div(position.y()));
+        auto const subpixel = position - Geom::IntPoint(whole.x() * steps, whole.y() * steps);
+
+        auto mask = cache->get(g->_font_data, g->_glyph, *g->pathvec, glyph_to_device.withoutTranslation(), subpixel,
+                               fill_rule, antialias);
+        if (mask) {
+            auto const at = whole + mask->origin;
+            area.unionWith(Geom::IntRect::from_xywh(at, {mask->surface->get_width(), mask->surface->get_height()}));
+            placed.push_back({g, std::move(mask), at});
+        } else if (auto bounds = bounds_exact_transformed(*g->pathvec, glyph_to_device)) {
+            auto box = bounds->roundOutwards();
+            box.expandBy(1); // Room for antialiasing.
+            area.unionWith(box);
+            placed.push_back({g, nullptr, {}});
+        }
+    }
+    area.intersectWith(clip);
+    if (!area) {
+        return true;
+    }
+
+    auto const coverage = Cairo::ImageSurface::create(Cairo::FORMAT_A8, area->width(), area->height());
+    {
+        auto cdc = DrawingContext(coverage->cobj(), area->min());
+        cdc.setOperator(CAIRO_OPERATOR_ADD); // Saturates at full coverage.
+        cdc.setFillRule(fill_rule);
+        cairo_set_antialias(cdc.raw(), antialias);
+        for (auto const &p : placed) {
+            if (p.mask) {
+                cairo_set_source_surface(cdc.raw(), p.mask->surface->cobj(), p.at.x(), p.at.y());
+                cdc.paint();
+            } else {
+                // A fill per glyph, so that overlapping glyphs are added rather than wound.
+                Inkscape::DrawingContext::Save save(cdc);
+                cdc.transform(p.glyphs->_ctm * to_device);
+                cdc.path(*p.glyphs->pathvec);
+                cdc.setSource(0.0, 0.0, 0.0, 1.0);
+                cdc.fill();
+            }
+        }
+    }
+    coverage->flush();
+
+    cairo_mask_surface(dc.raw(), coverage->cobj(), area->left() - offset_x, area->top() - offset_y);
+    return true;
+}
+
 void DrawingText::_clipItem(DrawingContext &dc, RenderContext &rc, Geom::IntRect const &/*area*/) const
 {
     Inkscape::DrawingContext::Save save(dc);
@@ -77,6 +77,7 @@ protected:
     DrawingItem *_pickItem(Geom::Point const &p, double delta, unsigned flags) override;
     bool _canClip() const override { return true; }
 
+    bool _renderGlyphsCached(DrawingContext &dc, CairoPatternUniqPtr const &fill) const;
     void decorateItem(DrawingContext &dc, double phase_length, bool under) const;
     void decorateStyle(DrawingContext &dc, double vextent, double xphase, Geom::Point const &p1, Geom::Point const &p2, double thickness) const;
     NRStyle _nrstyle;
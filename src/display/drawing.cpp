@@ -11,10 +11,15 @@
  * Released under GNU GPL v2+, read the file 'COPYING' for more information.
  */
 
+#include <algorithm>
 #include <array>
+#include <future>
 #include <thread>
+#include <boost/asio/post.hpp>
+#include <boost/asio/thread_pool.hpp>
 #include "display/drawing.h"
 #include "display/control/canvas-item-drawing.h"
+#include "display/glyph-cache.h"
 #include "nr-filter-gaussian.h"
 #include "nr-filter-types.h"
 
@@ -48,6 +53,16 @@ static auto default_numthreads()
     return ret == 0 ? 4 : ret; // Sensible fallback if not reported.
 }
 
+/// Number of descendants, as estimated by their update complexity, above which the children
+/// of a group are updated in parallel.
+static int constexpr parallel_update_threshold = 256;
+
+struct Drawing::UpdatePool
+{
+    UpdatePool(int numthreads) : pool(numthreads) {}
+    boost::asio::thread_pool pool;
+};
+
 Drawing::Drawing(Inkscape::CanvasItemDrawing *canvas_item_drawing)
     : _canvas_item_drawing(canvas_item_drawing)
     , _grayscale_matrix(std::vector<double>(grayscale_matrix.begin(), grayscale_matrix.end()))
@@ -60,6 +75,12 @@ Drawing::~Drawing()
     delete _root;
 }
 
+std::optional<double> Drawing::firstRenderTime() const
+{
+    auto const time = _first_render_time.load(std::memory_order_relaxed);
+    return time < 0.0 ? std::optional<double>() : time;
+}
+
 void Drawing::setRoot(DrawingItem *root)
 {
     delete _root;
@@ -196,6 +217,19 @@ void Drawing::setCacheBudget(size_t bytes)
     });
 }
 
+void Drawing::setGlyphCacheBudget(size_t bytes)
+{
+    defer([=] {
+        if (bytes == 0) {
+            _glyph_cache.reset();
+        } else if (_glyph_cache) {
+            _glyph_cache->setBudget(bytes);
+        } else {
+            _glyph_cache = std::make_unique<GlyphCache>(bytes);
+        }
+    });
+}
+
 void Drawing::setCacheLimit(Geom::OptIntRect const &rect)
 {
     defer([=] {
@@ -233,6 +267,9 @@ void Drawing::update(Geom::IntRect const &area, Geom::Affine const &affine, unsi
         // Process the updated cache scores.
         _pickItemsForCaching();
     }
+    if (_root && !_first_update_time) {
+        _first_update_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - _creation_time).count();
+    }
 }
 
 void Drawing::render(DrawingContext &dc, Geom::IntRect const &area, unsigned flags) const
@@ -251,10 +288,17 @@ void Drawing::render(DrawingContext &dc, Geom::IntRect const &area, unsigned fla
     if (_clip) {
         dc.restore();
     }
+
+    if (_first_render_time.load(std::memory_order_relaxed) < 0.0) {
+        auto expected = -1.0;
+        auto const time = std::chrono::duration<double>(std::chrono::steady_clock::now() - _creation_time).count();
+        _first_render_time.compare_exchange_strong(expected, time, std::memory_order_relaxed);
+    }
 }
 
 DrawingItem *Drawing::pick(Geom::Point const &p, double delta, unsigned flags)
 {
+    _pick_count++;
     return _root->pick(p, delta, flags);
 }
 
@@ -271,6 +315,101 @@ void Drawing::unsnapshot()
     _funclog();
 }
 
+/**
+ * Update the children of a large group concurrently, if enabled and worthwhile.
+ *
+ * The children are handed out one at a time to the threads of a pool, the calling thread among
+ * them, so that a few large subtrees do not leave the other threads idle. Updates within the
+ * subtrees are serial. Work that touches shared state is either protected by _update_mutex
+ * (the cache lists) or deferred until all threads have finished (_markForRendering(), which
+ * dirties the caches of ancestors and requests redraws from the canvas).
+ *
+ * @return Whether the children were updated.
+ */
+bool Drawing::_updateChildrenParallel(DrawingItem &parent, Geom::IntRect const &area, UpdateContext const &ctx, unsigned flags, unsigned reset)
+{
+    if (_parallel_update || _numthreads <= 1) {
+        return false;
+    }
+
+    std::vector<DrawingItem*> children;
+    int work = 0;
+    for (auto &c : parent._children) {
+        children.emplace_back(&c);
+        work += std::max(c._update_complexity, 1);
+    }
+    if (children.size() < 2 || work < parallel_update_threshold) {
+        return false;
+    }
+
+    if (!_update_pool) {
+        _update_pool = std::make_unique<UpdatePool>(_numthreads - 1);
+    }
+
+    _parallel_update = true;
+
+    std::atomic<size_t> next{0};
+    std::exception_ptr error;
+    auto run = [&] {
+        while (true) {
+            auto const i = next.fetch_add(1, std::memory_order_relaxed);
+            if (i >= children.size()) {
+                return;
+            }
+            try {
+                children[i]->update(area, ctx, flags, reset);
+            } catch (...) {
+                auto lock = std::lock_guard(_update_mutex);
+                if (!error) {
+                    error = std::current_exception();
+                }
+            }
+        }
+    };
+
+    auto const numhelpers = std::min<size_t>(_numthreads - 1, children.size() - 1);
+    std::vector<std::future<void>> helpers;
+    for (size_t i = 0; i < numhelpers; i++) {
+        auto task = std::make_shared<std::packaged_task<void()>>(run);
+        helpers.emplace_back(task->get_future());
+        boost::asio::post(_update_pool->pool, [task] { (*task)(); });
+    }
+    run();
+    for (auto &h : helpers) {
+        h.wait();
+    }
+
+    _parallel_update = false;
+
+    for (auto item : _deferred_render_marks) {
+        item->_markForRendering();
+    }
+    _deferred_render_marks.clear();
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+
+    return true;
+}
+
+/// Lock the shared state of the drawing if a parallel update is in progress.
+std::unique_lock<std::mutex> Drawing::_lockIfParallel()
+{
+    return _parallel_update ? std::unique_lock(_update_mutex) : std::unique_lock<std::mutex>();
+}
+
+void Drawing::_setNumThreads(int numthreads)
+{
+    // Set the global variable governing the number of filter threads, and track it too. (This is ugly, but hopefully transitional.)
+    set_num_filter_threads(numthreads);
+
+    if (numthreads != _numthreads) {
+        _numthreads = numthreads;
+        _update_pool.reset();
+    }
+}
+
 void Drawing::_pickItemsForCaching()
 {
     // Build sorted list of items that should be cached.
@@ -328,12 +467,12 @@ void Drawing::_loadPrefs()
     if (_canvas_item_drawing) {
         // Preference is stored in MiB; convert to bytes, taking care not to overflow.
         _cache_budget = (size_t{1} << 20) * prefs->getIntLimited("/options/renderingcache/size", 64, 0, 4096);
+        setGlyphCacheBudget((size_t{1} << 20) * prefs->getIntLimited("/options/glyphcache/size", 0, 0, 1024));
     } else {
         _cache_budget = 0;
     }
 
-    // Set the global variable governing the number of filter threads, and track it too. (This is ugly, but hopefully transitional.)
-    set_num_filter_threads(prefs->getIntLimited("/options/threading/numthreads", default_numthreads(), 1, 256));
+    _setNumThreads(prefs->getIntLimited("/options/threading/numthreads", default_numthreads(), 1, 256));
 
     // Similarly, enable preference tracking only for the Canvas's drawing.
     if (_canvas_item_drawing) {
@@ -350,7 +489,8 @@ void Drawing::_loadPrefs()
         actions.emplace("/options/cursortolerance/value",        [this] (auto &entry) { setCursorTolerance(entry.getDouble(1.0)); });
         actions.emplace("/options/selection/zeroopacity",        [this] (auto &entry) { setSelectZeroOpacity(entry.getBool(false)); });
         actions.emplace("/options/renderingcache/size",          [this] (auto &entry) { setCacheBudget((1 << 20) * entry.getIntLimited(64, 0, 4096)); });
-        actions.emplace("/options/threading/numthreads",         [this] (auto &entry) { set_num_filter_threads(entry.getIntLimited(default_numthreads(), 1, 256)); });
+        actions.emplace("/options/glyphcache/size",              [this] (auto &entry) { setGlyphCacheBudget((1 << 20) * entry.getIntLimited(0, 0, 1024)); });
+        actions.emplace("/options/threading/numthreads",         [this] (auto &entry) { _setNumThreads(entry.getIntLimited(default_numthreads(), 1, 256)); });
 
         _pref_tracker = Inkscape::Preferences::PreferencesObserver::create("/options", [actions = std::move(actions)] (auto &entry) {
             auto it = actions.find(entry.getPath());
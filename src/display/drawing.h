@@ -13,6 +13,9 @@
 #ifndef INKSCAPE_DISPLAY_DRAWING_H
 #define INKSCAPE_DISPLAY_DRAWING_H
 
+#include <atomic>
+#include <chrono>
+#include <mutex>
 #include <optional>
 #include <set>
 #include <cstdint>
@@ -33,6 +36,7 @@ namespace Inkscape {
 class DrawingItem;
 class CanvasItemDrawing;
 class DrawingContext;
+class GlyphCache;
 
 class Drawing
 {
@@ -60,6 +64,7 @@ public:
     void setCursorTolerance(double tol) { _cursor_tolerance = tol; }
     void setSelectZeroOpacity(bool select_zero_opacity) { _select_zero_opacity = select_zero_opacity; }
     void setCacheBudget(size_t bytes);
+    void setGlyphCacheBudget(size_t bytes);
     void setCacheLimit(Geom::OptIntRect const &rect);
     void setClip(std::optional<Geom::PathVector> &&clip);
     void setAntialiasingOverride(std::optional<Antialiasing> antialiasing_override);
@@ -78,6 +83,18 @@ public:
     double cursorTolerance() const { return _cursor_tolerance; }
     bool selectZeroOpacity() const { return _select_zero_opacity; }
     Geom::OptIntRect const &cacheLimit() const { return _cache_limit; }
+    GlyphCache *glyphCache() const { return _glyph_cache.get(); } ///< Null if glyph caching is disabled.
+    bool clipped() const { return _clip.has_value(); }
+    std::optional<Antialiasing> antialiasingOverride() const { return _antialiasing_override; }
+
+    /// Seconds from construction until the first update finished, if one has.
+    std::optional<double> firstUpdateTime() const { return _first_update_time; }
+    /// Seconds from construction until the first render finished, if one has. Used to measure time-to-first-paint.
+    std::optional<double> firstRenderTime() const;
+    /// Number of calls to pick(), for profiling.
+    std::size_t pickCount() const { return _pick_count; }
+    /// Number of items visited by those calls, for profiling.
+    std::size_t pickVisitedCount() const { return _pick_visited_count; }
 
     void update(Geom::IntRect const &area = Geom::IntRect::infinite(), Geom::Affine const &affine = Geom::identity(),
                 unsigned flags = DrawingItem::STATE_ALL, unsigned reset = 0);
@@ -97,6 +114,9 @@ private:
     void _pickItemsForCaching();
     void _clearCache();
     void _loadPrefs();
+    void _setNumThreads(int numthreads);
+    bool _updateChildrenParallel(DrawingItem &parent, Geom::IntRect const &area, UpdateContext const &ctx, unsigned flags, unsigned reset);
+    std::unique_lock<std::mutex> _lockIfParallel();
 
     DrawingItem *_root = nullptr;
     CanvasItemDrawing *_canvas_item_drawing = nullptr;
@@ -123,6 +143,8 @@ private:
     std::set<DrawingItem*> _cached_items; // modified by DrawingItem::_setCached()
     CacheList _candidate_items;           // keep this list always sorted with std::greater
 
+    std::unique_ptr<GlyphCache> _glyph_cache;
+
     /*
      * Simple cacheline separator compatible with x86 (64 bytes) and M* (128 bytes).
      * Ideally alignas(std::hardware_destructive_interference_size) could be used instead,
@@ -133,10 +155,25 @@ private:
     bool _snapshotted = false;
     Util::FuncLog _funclog;
 
+    // Parallel update; see _updateChildrenParallel().
+    struct UpdatePool;
+    int _numthreads = 0;
+    std::unique_ptr<UpdatePool> _update_pool; ///< Created on first use.
+    bool _parallel_update = false; ///< Whether a parallel update is in progress.
+    std::mutex _update_mutex; ///< Protects the cache lists and the following during a parallel update.
+    std::vector<DrawingItem*> _deferred_render_marks; ///< Items to call _markForRendering() on afterwards.
+
+    std::chrono::steady_clock::time_point const _creation_time = std::chrono::steady_clock::now();
+    std::optional<double> _first_update_time;
+    mutable std::atomic<double> _first_render_time{-1.0}; ///< Negative if no render has finished yet.
+    std::size_t _pick_count = 0;
+    std::size_t _pick_visited_count = 0;
+
     template<typename F>
     void defer(F &&f) { _snapshotted ? _funclog.emplace(std::forward<F>(f)) : f(); }
 
     friend class DrawingItem;
+    friend class DrawingGroup;
 };
 
 } // namespace Inkscape
@@ -0,0 +1,118 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+/**
+ * @file
+ * Cache of rasterised glyph coverage masks, shared by all text in a drawing.
+ *//*
+ * Copyright (C) 2023 Authors
+ * Released under GNU GPL v2+, read the file 'COPYING' for more information.
+ */
+
+#include <cstring>
+#include <functional>
+#include <2geom/int-rect.h>
+#include <2geom/pathvector.h>
+#include <2geom/transforms.h>
+
+#include "glyph-cache.h"
+#include "drawing-context.h"
+#include "helper/geom.h"
+
+namespace Inkscape {
+
+// Glyphs larger than this on screen are cheap to fill compared to their mask, and would
+// quickly use up the budget, so they are not cached.
+static int constexpr max_mask_pixels = 256 * 256;
+
+bool GlyphCache::Key::operator==(Key const &other) const
+{
+    return font == other.font && glyph == other.glyph &&
+           std::memcmp(linear, other.linear, sizeof(linear)) == 0 &&
+           subpixel_x == other.subpixel_x && subpixel_y == other.subpixel_y &&
+           fill_rule == other.fill_rule && antialias == other.antialias;
+}
+
+std::size_t GlyphCache::KeyHash::operator()(Key const &key) const
+{
+    auto combine = [] (std::size_t seed, std::size_t value) {
+        return seed ^ (value + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2));
+    };
+    auto hash = std::hash<void const *>()(key.font);
+    hash = combine(hash, key.glyph);
+    for (auto c : key.linear) {
+        hash = combine(hash, std::hash<double>()(c));
+    }
+    hash = combine(hash, key.subpixel_x * GlyphCache::subpixel_steps + key.subpixel_y);
+    hash = combine(hash, key.fill_rule * 16 + key.antialias);
+    return hash;
+}
+
+GlyphCache::GlyphCache(std::size_t budget)
+    : _glyphs(budget)
+{
+}
+
+std::shared_ptr<GlyphCache::Mask const> GlyphCache::get(std::shared_ptr<void const> const &font, int glyph,
+                                                        Geom::PathVector const &path, Geom::Affine const &linear,
+                                                        Geom::IntPoint const &subpixel,
+                                                        cairo_fill_rule_t fill_rule, cairo_antialias_t antialias)
+{
+    Key key{};
+    key.font = font.get();
+    key.glyph = glyph;
+    for (int i = 0; i < 4; i++) {
+        key.linear[i] = linear[i] + 0.0; // Normalise negative zero.
+    }
+    key.subpixel_x = subpixel.x();
+    key.subpixel_y = subpixel.y();
+    key.fill_rule = fill_rule;
+    key.antialias = antialias;
+
+    std::shared_ptr<Mask const> cached;
+    if (_glyphs.visit(key, [&] (Glyph const &glyph) { cached = glyph.mask; })) {
+        return cached;
+    }
+
+    // Render outside the lock; another thread rendering the same glyph meanwhile is harmless.
+    auto const affine = linear * Geom::Translate(Geom::Point(subpixel) / subpixel_steps);
+    auto const bounds = bounds_exact_transformed(path, affine);
+    if (!bounds) {
+        return {};
+    }
+    auto box = bounds->roundOutwards();
+    box.expandBy(1); // Room for antialiasing.
+    if (static_cast<double>(box.width()) * box.height() > max_mask_pixels) {
+        return {};
+    }
+
+    auto mask = std::make_shared<Mask>();
+    mask->surface = Cairo::ImageSurface::create(Cairo::FORMAT_A8, box.width(), box.height());
+    mask->origin = box.min();
+    {
+        auto dc = DrawingContext(mask->surface->cobj(), box.min());
+        dc.transform(affine);
+        dc.path(path);
+        dc.setFillRule(fill_rule);
+        cairo_set_antialias(dc.raw(), antialias);
+        dc.setSource(0.0, 0.0, 0.0, 1.0);
+        dc.fill();
+    }
+    mask->surface->flush();
+
+    auto const size = static_cast<std::size_t>(mask->surface->get_stride()) * box.height() + sizeof(Glyph);
+    _glyphs.insert(key, {font, mask}, size);
+
+    return mask;
+}
+
+} // namespace Inkscape
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
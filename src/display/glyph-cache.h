@@ -0,0 +1,105 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+/**
+ * @file
+ * Cache of rasterised glyph coverage masks, shared by all text in a drawing.
+ *//*
+ * Copyright (C) 2023 Authors
+ * Released under GNU GPL v2+, read the file 'COPYING' for more information.
+ */
+
+#ifndef INKSCAPE_DISPLAY_GLYPH_CACHE_H
+#define INKSCAPE_DISPLAY_GLYPH_CACHE_H
+
+#include <cstddef>
+#include <memory>
+#include <cairo.h>
+#include <cairomm/surface.h>
+#include <2geom/affine.h>
+#include <2geom/forward.h>
+#include <2geom/int-point.h>
+
+#include "util/lru-cache.h"
+
+namespace Inkscape {
+
+/**
+ * A GlyphCache holds the alpha masks of glyphs rendered at a given transform, so that text
+ * which is shown repeatedly at the same zoom level can be composited from them rather than
+ * having each glyph outline filled again by Cairo.
+ *
+ * Masks are keyed by font, glyph, the linear part of the transform to device pixels, and the
+ * subpixel position of the glyph origin, quantised to 1/subpixel_steps of a pixel. The least
+ * recently used masks are discarded when the total size exceeds the budget.
+ */
+class GlyphCache
+{
+public:
+    static int constexpr subpixel_steps = 4;
+
+    struct Mask
+    {
+        Cairo::RefPtr<Cairo::ImageSurface> surface; ///< A8 coverage.
+        Geom::IntPoint origin; ///< Position of the surface relative to the whole-pixel glyph origin.
+    };
+
+    explicit GlyphCache(std::size_t budget);
+    GlyphCache(GlyphCache const &) = delete;
+    GlyphCache &operator=(GlyphCache const &) = delete;
+
+    void setBudget(std::size_t bytes) { _glyphs.setBudget(bytes); }
+    std::size_t size() const { return _glyphs.size(); }
+
+    /**
+     * Return the mask of a glyph, rendering and caching it if necessary.
+     *
+     * @param font Identity of the font. It is kept alive while the mask is cached.
+     * @param glyph Glyph index within the font.
+     * @param path Outline of the glyph.
+     * @param linear Transform from glyph to device pixels, without translation.
+     * @param subpixel Position of the glyph origin within its pixel, in 1/subpixel_steps.
+     * @return The mask, or null if the glyph is empty or too large to be worth caching.
+     */
+    std::shared_ptr<Mask const> get(std::shared_ptr<void const> const &font, int glyph, Geom::PathVector const &path,
+                                    Geom::Affine const &linear, Geom::IntPoint const &subpixel,
+                                    cairo_fill_rule_t fill_rule, cairo_antialias_t antialias);
+
+private:
+    struct Key
+    {
+        void const *font;
+        int glyph;
+        double linear[4];
+        int subpixel_x, subpixel_y;
+        int fill_rule, antialias;
+
+        bool operator==(Key const &other) const;
+    };
+
+    struct KeyHash
+    {
+        std::size_t operator()(Key const &key) const;
+    };
+
+    struct Glyph
+    {
+        std::shared_ptr<void const> font; ///< Keeps the font in the key alive.
+        std::shared_ptr<Mask const> mask;
+    };
+
+    Util::LRUCache<Key, Glyph, KeyHash> _glyphs;
+};
+
+} // namespace Inkscape
+
+#endif // INKSCAPE_DISPLAY_GLYPH_CACHE_H
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
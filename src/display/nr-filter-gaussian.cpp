@@ -21,11 +21,25 @@
 #include <complex>
 #include <cstdlib>
 #include <glib.h>
+#include <climits>
+#include <cstdint>
+#include <cstring>
 #include <limits>
+#include <vector>
 #if HAVE_OPENMP
 #include <omp.h>
 #endif //HAVE_OPENMP
 
+// Vectorized kernels for ARGB32 surfaces. SSE2 is part of the x86-64 baseline and NEON of the
+// AArch64 one, so these are selected at compile time without any runtime CPU detection.
+#if defined(__SSE2__)
+# include <emmintrin.h>
+# define INK_GAUSSIAN_SIMD 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+# include <arm_neon.h>
+# define INK_GAUSSIAN_SIMD 1
+#endif
+
 #include "display/cairo-utils.h"
 #include "display/nr-filter-primitive.h"
 #include "display/nr-filter-gaussian.h"
@@ -468,9 +482,252 @@ INK_UNUSED(num_threads); // suppresses unused argument compiler warning
     }
 }
 
+#ifdef INK_GAUSSIAN_SIMD
+
+// Thin wrappers over the SSE2 / NEON intrinsics used by the vectorized kernels.
+// A pixel is held as two vectors of two doubles (IIR) or one vector of four 32-bit integers (FIR).
+namespace {
+
+#if defined(__SSE2__)
+using f64x2 = __m128d;
+using u32x4 = __m128i;
+
+inline f64x2 f64x2_set1(double v)             { return _mm_set1_pd(v); }
+inline f64x2 f64x2_load(double const *p)      { return _mm_loadu_pd(p); }
+inline void  f64x2_store(double *p, f64x2 v)  { _mm_storeu_pd(p, v); }
+inline f64x2 f64x2_add(f64x2 a, f64x2 b)      { return _mm_add_pd(a, b); }
+inline f64x2 f64x2_mul(f64x2 a, f64x2 b)      { return _mm_mul_pd(a, b); }
+inline f64x2 f64x2_min(f64x2 a, f64x2 b)      { return _mm_min_pd(a, b); }
+inline f64x2 f64x2_max(f64x2 a, f64x2 b)      { return _mm_max_pd(a, b); }
+
+inline u32x4 u32x4_zero()                     { return _mm_setzero_si128(); }
+inline u32x4 u32x4_add(u32x4 a, u32x4 b)      { return _mm_add_epi32(a, b); }
+
+// Widen the four bytes of a pixel and multiply them by a 16-bit kernel coefficient.
+inline u32x4 u32x4_mul_pixel(uint32_t px, uint16_t k)
+{
+    auto const p16 = _mm_unpacklo_epi8(_mm_cvtsi32_si128(px), _mm_setzero_si128());
+    auto const k16 = _mm_set1_epi16(static_cast<short>(k));
+    return _mm_unpacklo_epi16(_mm_mullo_epi16(p16, k16), _mm_mulhi_epu16(p16, k16));
+}
+
+// Round a 16.16 fixed point sum of each channel and narrow it back to a pixel.
+inline uint32_t u32x4_round_pixel(u32x4 sum)
+{
+    auto const v = _mm_srli_epi32(_mm_add_epi32(sum, _mm_set1_epi32(1 << 15)), 16);
+    auto const v16 = _mm_packs_epi32(v, v);
+    return _mm_cvtsi128_si32(_mm_packus_epi16(v16, v16));
+}
+#else
+using f64x2 = float64x2_t;
+using u32x4 = uint32x4_t;
+
+inline f64x2 f64x2_set1(double v)             { return vdupq_n_f64(v); }
+inline f64x2 f64x2_load(double const *p)      { return vld1q_f64(p); }
+inline void  f64x2_store(double *p, f64x2 v)  { vst1q_f64(p, v); }
+inline f64x2 f64x2_add(f64x2 a, f64x2 b)      { return vaddq_f64(a, b); }
+inline f64x2 f64x2_mul(f64x2 a, f64x2 b)      { return vmulq_f64(a, b); }
+inline f64x2 f64x2_min(f64x2 a, f64x2 b)      { return vminq_f64(a, b); }
+inline f64x2 f64x2_max(f64x2 a, f64x2 b)      { return vmaxq_f64(a, b); }
+
+inline u32x4 u32x4_zero()                     { return vdupq_n_u32(0); }
+inline u32x4 u32x4_add(u32x4 a, u32x4 b)      { return vaddq_u32(a, b); }
+
+inline u32x4 u32x4_mul_pixel(uint32_t px, uint16_t k)
+{
+    auto const p16 = vget_low_u16(vmovl_u8(vreinterpret_u8_u32(vdup_n_u32(px))));
+    return vmull_n_u16(p16, k);
+}
+
+inline uint32_t u32x4_round_pixel(u32x4 sum)
+{
+    auto const v16 = vmovn_u32(vshrq_n_u32(vaddq_u32(sum, vdupq_n_u32(1 << 15)), 16));
+    return vget_lane_u32(vreinterpret_u32_u8(vmovn_u16(vcombine_u16(v16, v16))), 0);
+}
+#endif
+
+/// The four channels of a pixel as doubles, for the IIR filter.
+struct PixelD
+{
+    f64x2 lo, hi;
+
+    static PixelD load(double const *p) { return { f64x2_load(p), f64x2_load(p + 2) }; }
+    static PixelD load(unsigned char const *p)
+    {
+        double const v[4] = { double(p[0]), double(p[1]), double(p[2]), double(p[3]) };
+        return load(v);
+    }
+    void store(double *p) const { f64x2_store(p, lo); f64x2_store(p + 2, hi); }
+
+    PixelD operator*(f64x2 s) const { return { f64x2_mul(lo, s), f64x2_mul(hi, s) }; }
+    PixelD operator+(PixelD const &o) const { return { f64x2_add(lo, o.lo), f64x2_add(hi, o.hi) }; }
+
+    /// Clamp to [0, alpha], round and store as premultiplied bytes; same result as the scalar path.
+    void store_premultiplied(unsigned char *dst, unsigned alpha_PC) const
+    {
+        double v[4];
+        store(v);
+        unsigned char const alpha = clip_round_cast<unsigned char>(v[alpha_PC]);
+        auto const zero = f64x2_set1(0.0);
+        auto const amax = f64x2_set1(alpha);
+        auto const half = f64x2_set1(0.5);
+        f64x2_store(v,     f64x2_add(f64x2_min(f64x2_max(lo, zero), amax), half));
+        f64x2_store(v + 2, f64x2_add(f64x2_min(f64x2_max(hi, zero), amax), half));
+        for (unsigned c = 0; c < 4; ++c) {
+            dst[c] = static_cast<unsigned char>(v[c]);
+        }
+        dst[alpha_PC] = alpha;
+    }
+};
+
+} // namespace
+
+// Vectorized equivalent of filter2D_IIR<unsigned char, 4, true>.
+static void
+filter2D_IIR_ARGB32_simd(unsigned char *const dest, int const dstr1, int const dstr2,
+                         unsigned char const *const src, int const sstr1, int const sstr2,
+                         int const n1, int const n2, IIRValue const b[N+1], double const M[N*N],
+                         IIRValue *const tmpdata[], int const num_threads)
+{
+    assert(src && dest);
+
+#if G_BYTE_ORDER == G_LITTLE_ENDIAN
+    static unsigned int const alpha_PC = 3;
+#else
+    static unsigned int const alpha_PC = 0;
+#endif
+
+    f64x2 bv[N+1];
+    for (unsigned i = 0; i < N+1; i++) bv[i] = f64x2_set1(b[i]);
+
+INK_UNUSED(num_threads); // to suppress unused argument compiler warning
+#if HAVE_OPENMP
+#pragma omp parallel for num_threads(num_threads)
+#endif // HAVE_OPENMP
+    for ( int c2 = 0 ; c2 < n2 ; c2++ ) {
+#if HAVE_OPENMP
+        unsigned int tid = omp_get_thread_num();
+#else
+        unsigned int tid = 0;
+#endif // HAVE_OPENMP
+        // corresponding line in the source and output buffer
+        unsigned char const *srcimg = src  + c2*sstr2;
+        unsigned char       *dstimg = dest + c2*dstr2 + n1*dstr1;
+        IIRValue *const tmp = tmpdata[tid];
+        // Border constants
+        IIRValue iplus[4]; copy_n(srcimg + (n1-1)*sstr1, 4, iplus);
+        // Forward pass
+        PixelD u[N+1];
+        for (unsigned i = 0; i < N; i++) u[i] = PixelD::load(srcimg);
+        for ( int c1 = 0 ; c1 < n1 ; c1++ ) {
+            for (unsigned i = N; i > 0; i--) u[i] = u[i-1];
+            u[0] = PixelD::load(srcimg) * bv[0];
+            srcimg += sstr1;
+            for (unsigned i = 1; i < N+1; i++) u[0] = u[0] + u[i] * bv[i];
+            u[0].store(tmp + c1*4);
+        }
+        // Backward pass
+        IIRValue uold[N][4], vold[N][4];
+        for (unsigned i = 0; i < N; i++) u[i].store(uold[i]);
+        calcTriggsSdikaInitialization<4>(M, uold, iplus, iplus, b[0], vold);
+        PixelD v[N+1];
+        for (unsigned i = 0; i < N; i++) v[i] = PixelD::load(vold[i]);
+        dstimg -= dstr1;
+        v[0].store_premultiplied(dstimg, alpha_PC);
+        int c1=n1-1;
+        while(c1-->0) {
+            for (unsigned i = N; i > 0; i--) v[i] = v[i-1];
+            v[0] = PixelD::load(tmp + c1*4) * bv[0];
+            for (unsigned i = 1; i < N+1; i++) v[0] = v[0] + v[i] * bv[i];
+            dstimg -= dstr1;
+            v[0].store_premultiplied(dstimg, alpha_PC);
+        }
+    }
+}
+
+// Vectorized equivalent of filter2D_FIR<unsigned char, 4>, processing all four channels at once.
+// Returns false without touching the image if the kernel does not fit the 16-bit multiplies.
+static bool
+filter2D_FIR_ARGB32_simd(unsigned char *const dst, int const dstr1, int const dstr2,
+                         unsigned char const *const src, int const sstr1, int const sstr2,
+                         int const n1, int const n2, FIRValue const *const kernel, int const scr_len, int const num_threads)
+{
+    assert(src && dst);
+
+    // Raw 16.16 kernel coefficients.
+    std::vector<uint16_t> k(scr_len + 1);
+    for (int i = 0; i <= scr_len; i++) {
+        auto const raw = std::lround(std::ldexp(static_cast<double>(kernel[i]), 16));
+        if (raw > std::numeric_limits<uint16_t>::max()) {
+            return false;
+        }
+        k[i] = raw;
+    }
+
+    auto const load = [] (unsigned char const *p) { uint32_t px; std::memcpy(&px, p, 4); return px; };
+
+INK_UNUSED(num_threads); // suppresses unused argument compiler warning
+#if HAVE_OPENMP
+#pragma omp parallel for num_threads(num_threads)
+#endif // HAVE_OPENMP
+    for ( int c2 = 0 ; c2 < n2 ; c2++ ) {
+        // Past pixels seen (to enable in-place operation)
+        std::vector<uint32_t> history(scr_len + 1, load(src + c2 * sstr2));
+
+        unsigned char const *const srcline = src + c2 * sstr2;
+        unsigned char *const dstline = dst + c2 * dstr2;
+
+        int skip = INT_MIN;
+
+        for ( int c1 = 0 ; c1 < n1 ; c1++ ) {
+            // update history
+            std::copy_backward(history.begin(), history.end() - 1, history.end());
+            history[0] = load(srcline + c1 * sstr1);
+
+            if (skip > c1) continue;
+
+            uint32_t const first = history[0];
+            bool flat = true;
+            u32x4 sum = u32x4_zero();
+
+            // go over our point's neighbours in the history
+            for ( int i = 0 ; i <= scr_len ; i++ ) {
+                flat = flat && history[i] == first;
+                sum = u32x4_add(sum, u32x4_mul_pixel(history[i], k[i]));
+            }
+
+            // go over our point's neighborhood on x axis in the in buffer
+            for ( int i = 1 ; i <= scr_len ; i++ ) {
+                uint32_t const px = load(srcline + std::min(c1 + i, n1 - 1) * sstr1);
+                flat = flat && px == first;
+                sum = u32x4_add(sum, u32x4_mul_pixel(px, k[i]));
+            }
+
+            uint32_t const out = u32x4_round_pixel(sum);
+            std::memcpy(dstline + c1 * dstr1, &out, 4);
+
+            // optimization: if there was no variation within this point's neighborhood,
+            // skip ahead while we keep seeing the same pixel:
+            // blurring flat color would not change it anyway
+            if (flat) {
+                int pos = c1 + 1;
+                while (pos + scr_len < n1 && load(srcline + (pos + scr_len) * sstr1) == first) {
+                    std::memcpy(dstline + pos * dstr1, &first, 4);
+                    pos++;
+                }
+                skip = pos;
+            }
+        }
+    }
+
+    return true;
+}
+
+#endif // INK_GAUSSIAN_SIMD
+
 static void
 gaussian_pass_IIR(Geom::Dim2 d, double deviation, cairo_surface_t *src, cairo_surface_t *dest,
-    IIRValue **tmpdata, int num_threads)
+    IIRValue **tmpdata, int num_threads, bool use_simd = true)
 {
     // Filter variables
     IIRValue b[N+1];  // scaling coefficient + filter coefficients (can be 10.21 fixed point)
@@ -503,6 +760,15 @@ gaussian_pass_IIR(Geom::Dim2 d, double deviation, cairo_surface_t *src, cairo_su
             w, h, b, M, tmpdata, num_threads);
         break;
     case CAIRO_FORMAT_ARGB32: ///< Premultiplied 8 bit RGBA
+#ifdef INK_GAUSSIAN_SIMD
+        if (use_simd) {
+            filter2D_IIR_ARGB32_simd(
+                cairo_image_surface_get_data(dest), d == Geom::X ? 4 : stride, d == Geom::X ? stride : 4,
+                cairo_image_surface_get_data(src),  d == Geom::X ? 4 : stride, d == Geom::X ? stride : 4,
+                w, h, b, M, tmpdata, num_threads);
+            break;
+        }
+#endif // INK_GAUSSIAN_SIMD
         filter2D_IIR<unsigned char,4,true>(
             cairo_image_surface_get_data(dest), d == Geom::X ? 4 : stride, d == Geom::X ? stride : 4,
             cairo_image_surface_get_data(src),  d == Geom::X ? 4 : stride, d == Geom::X ? stride : 4,
@@ -515,7 +781,7 @@ gaussian_pass_IIR(Geom::Dim2 d, double deviation, cairo_surface_t *src, cairo_su
 
 static void
 gaussian_pass_FIR(Geom::Dim2 d, double deviation, cairo_surface_t *src, cairo_surface_t *dest,
-    int num_threads)
+    int num_threads, bool use_simd = true)
 {
     int scr_len = _effect_area_scr(deviation);
     // Filter kernel for x direction
@@ -536,6 +802,14 @@ gaussian_pass_FIR(Geom::Dim2 d, double deviation, cairo_surface_t *src, cairo_su
             w, h, &kernel[0], scr_len, num_threads);
         break;
     case CAIRO_FORMAT_ARGB32: ///< Premultiplied 8 bit RGBA
+#ifdef INK_GAUSSIAN_SIMD
+        if (use_simd && filter2D_FIR_ARGB32_simd(
+                cairo_image_surface_get_data(dest), d == Geom::X ? 4 : stride, d == Geom::X ? stride : 4,
+                cairo_image_surface_get_data(src),  d == Geom::X ? 4 : stride, d == Geom::X ? stride : 4,
+                w, h, &kernel[0], scr_len, num_threads)) {
+            break;
+        }
+#endif // INK_GAUSSIAN_SIMD
         filter2D_FIR<unsigned char,4>(
             cairo_image_surface_get_data(dest), d == Geom::X ? 4 : stride, d == Geom::X ? stride : 4,
             cairo_image_surface_get_data(src),  d == Geom::X ? 4 : stride, d == Geom::X ? stride : 4,
@@ -546,6 +820,32 @@ gaussian_pass_FIR(Geom::Dim2 d, double deviation, cairo_surface_t *src, cairo_su
     };
 }
 
+void gaussian_blur_pass(cairo_surface_t *surface, Geom::Dim2 d, double deviation, bool use_simd)
+{
+    if (_effect_area_scr(deviation) <= 0) {
+        return;
+    }
+
+    int const threads = get_num_filter_threads();
+    cairo_surface_flush(surface);
+
+    // Same threshold as in FilterGaussian::render_cairo()
+    if (deviation > 3) {
+        int const w = cairo_image_surface_get_width(surface);
+        int const h = cairo_image_surface_get_height(surface);
+        std::vector<std::vector<IIRValue>> buffers(threads, std::vector<IIRValue>(std::max(w, h) * 4));
+        std::vector<IIRValue *> tmpdata;
+        for (auto &buffer : buffers) {
+            tmpdata.push_back(buffer.data());
+        }
+        gaussian_pass_IIR(d, deviation, surface, surface, tmpdata.data(), threads, use_simd);
+    } else {
+        gaussian_pass_FIR(d, deviation, surface, surface, threads, use_simd);
+    }
+
+    cairo_surface_mark_dirty(surface);
+}
+
 void FilterGaussian::render_cairo(FilterSlot &slot) const
 {
     cairo_surface_t *in = slot.getcairo(_input);
@@ -15,9 +15,12 @@
  * Released under GNU GPL v2+, read the file 'COPYING' for more information.
  */
 
+#include <2geom/coord.h>
 #include <2geom/forward.h>
 #include "display/nr-filter-primitive.h"
 
+typedef struct _cairo_surface cairo_surface_t;
+
 enum
 {
     BLUR_QUALITY_BEST = 2,
@@ -66,6 +69,14 @@ private:
     double _deviation_y;
 };
 
+/**
+ * Blur an A8 or ARGB32 image surface in place along one axis, choosing between the FIR and IIR
+ * filters in the same way as FilterGaussian. ARGB32 surfaces are processed with the vectorized
+ * kernels where the platform has them, unless use_simd is false, which selects the scalar
+ * reference implementation.
+ */
+void gaussian_blur_pass(cairo_surface_t *surface, Geom::Dim2 d, double deviation, bool use_simd = true);
+
 } // namespace Filters
 } // namespace Inkscape
 
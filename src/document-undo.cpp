@@ -54,8 +54,10 @@
 #include "inkscape.h"
 
 #include "debug/event-tracker.h"
+#include "debug/logger.h"
 #include "debug/simple-event.h"
 #include "debug/timestamp.h"
+#include "preferences.h"
 #include "util/optstr.h"
 #include "xml/repr.h"
 #include "object/sp-root.h"
@@ -136,6 +138,18 @@ public:
     }
 };
 
+class UndoMemoryEvent : public SimpleEvent<Event::DOCUMENT> {
+public:
+
+    UndoMemoryEvent(SPDocument *doc, std::size_t memory, std::size_t steps)
+    : SimpleEvent<Event::DOCUMENT>("undo-memory")
+    {
+        _addProperty("document", doc->serial());
+        _addProperty("bytes", static_cast<long>(memory));
+        _addProperty("steps", static_cast<long>(steps));
+    }
+};
+
 }
 
 // 'key' is used to coalesce changes of the same type.
@@ -170,15 +184,25 @@ void Inkscape::DocumentUndo::maybeDone(SPDocument *doc,
 	}
 
 	if (key && !doc->actionkey.empty() && (doc->actionkey == key) && !doc->undo.empty()) {
-                (doc->undo.back())->event =
-                    sp_repr_coalesce_log ((doc->undo.back())->event, log);
+        Inkscape::Event *event = doc->undo.back();
+        event->event = sp_repr_optimize_log(sp_repr_coalesce_log(event->event, log));
+        event->memory = sp_repr_log_memory(event->event);
 	} else {
-        Inkscape::Event *event = new Inkscape::Event(log, event_description, icon_name);
+        if (!doc->undo.empty()) {
+            // Nothing is merged into the previous step anymore, so it can be stored compactly.
+            Inkscape::Event *previous = doc->undo.back();
+            sp_repr_compact_log(previous->event);
+            previous->memory = sp_repr_log_memory(previous->event);
+        }
+        Inkscape::Event *event = new Inkscape::Event(sp_repr_optimize_log(log), event_description, icon_name);
+        event->memory = sp_repr_log_memory(event->event);
         doc->undo.push_back(event);
 		doc->history_size++;
 		doc->undoStackObservers.notifyUndoCommitEvent(event);
 	}
 
+    limit_memory(*doc);
+
     if ( key ) {
         doc->actionkey = key;
     } else {
@@ -211,6 +235,7 @@ void Inkscape::DocumentUndo::finish_incomplete_transaction(SPDocument &doc) {
         if (!doc.undo.empty()) {
             Inkscape::Event* undo_stack_top = doc.undo.back();
             undo_stack_top->event = sp_repr_coalesce_log(undo_stack_top->event, doc.partial);
+            undo_stack_top->memory = sp_repr_log_memory(undo_stack_top->event);
         } else {
             sp_repr_free_log(doc.partial);
         }
@@ -234,12 +259,45 @@ void Inkscape::DocumentUndo::perform_document_update(SPDocument &doc) {
         if (!doc.undo.empty()) {
             Inkscape::Event* undo_stack_top = doc.undo.back();
             undo_stack_top->event = sp_repr_coalesce_log(undo_stack_top->event, update_log);
+            undo_stack_top->memory = sp_repr_log_memory(undo_stack_top->event);
         } else {
             sp_repr_free_log(update_log);
         }
     }
 }
 
+std::size_t Inkscape::DocumentUndo::getUndoMemory(SPDocument const *doc)
+{
+    std::size_t memory = 0;
+    for (auto event : doc->undo) {
+        memory += event->memory;
+    }
+    for (auto event : doc->redo) {
+        memory += event->memory;
+    }
+    return memory;
+}
+
+// Member function for friend access to SPDocument privates.
+void Inkscape::DocumentUndo::limit_memory(SPDocument &doc)
+{
+    auto memory = getUndoMemory(&doc);
+    auto const limit = static_cast<std::size_t>(Inkscape::Preferences::get()->getIntLimited("/options/undo/memorylimit", 256, 0, 65536)) << 20;
+
+    // Forget the oldest steps, but always keep the last one.
+    std::size_t expired = 0;
+    while (limit > 0 && memory > limit && expired + 1 < doc.undo.size()) {
+        Inkscape::Event *e = doc.undo[expired++];
+        doc.undoStackObservers.notifyUndoExpiredEvent(e);
+        memory -= e->memory;
+        delete e;
+        doc.history_size--;
+    }
+    doc.undo.erase(doc.undo.begin(), doc.undo.begin() + expired);
+
+    Inkscape::Debug::Logger::write<UndoMemoryEvent>(&doc, memory, doc.undo.size() + doc.redo.size());
+}
+
 gboolean Inkscape::DocumentUndo::undo(SPDocument *doc)
 {
     using Inkscape::Debug::EventTracker;
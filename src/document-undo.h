@@ -10,6 +10,7 @@
 #ifndef SEEN_SP_DOCUMENT_UNDO_H
 #define SEEN_SP_DOCUMENT_UNDO_H
 
+#include <cstddef>
 #include <glib.h>   // gboolean, gchar
 
 namespace Glib {
@@ -42,11 +43,21 @@ public:
 
     static void maybeDone(SPDocument *document, const gchar *keyconst, Glib::ustring const &event_description, Glib::ustring const &undo_icon);
 
+    /**
+     * Estimate of the memory used by the undo and redo stacks, in bytes.
+     *
+     * The stacks are kept within the memory limit set by the preference /options/undo/memorylimit
+     * (in MiB) by forgetting the oldest undo steps.
+     */
+    static std::size_t getUndoMemory(SPDocument const *document);
+
 private:
     static void finish_incomplete_transaction(SPDocument &document);
 
     static void perform_document_update(SPDocument &document);
 
+    static void limit_memory(SPDocument &document);
+
 public:
     static void resetKey(SPDocument *document);
 
@@ -37,6 +37,9 @@
 #define noSP_DOCUMENT_DEBUG_IDLE
 #define noSP_DOCUMENT_DEBUG_UNDO
 
+#include <algorithm>
+#include <chrono>
+#include <exception>
 #include <vector>
 #include <string>
 #include <cstring>
@@ -53,6 +56,7 @@
 #include "inkscape.h"
 #include "inkscape-window.h"
 #include "profile-manager.h"
+#include "preferences.h"
 #include "rdf.h"
 
 #include "live_effects/effect.h"
@@ -62,6 +66,8 @@
 #include "actions/actions-pages.h"
 #include "actions/actions-svg-processing.h"
 
+#include "async/worker-pool.h"
+
 #include "display/drawing.h"
 #include "display/control/canvas-item-drawing.h"
 #include "ui/widget/canvas.h"
@@ -75,6 +81,8 @@
 #include "layer-manager.h"
 #include "page-manager.h"
 #include "live_effects/lpeobject.h"
+#include "object/item-index.h"
+#include "object/selector-index.h"
 #include "object/persp3d.h"
 #include "object/sp-defs.h"
 #include "object/sp-factory.h"
@@ -83,6 +91,12 @@
 #include "object/sp-symbol.h"
 #include "object/sp-page.h"
 
+#include "debug/logger.h"
+#include "debug/simple-event.h"
+
+#include "object/sp-text.h"
+
+
 #include "widgets/desktop-widget.h"
 
 #include "xml/croco-node-iface.h"
@@ -108,6 +122,9 @@ static gint doc_mem_count = 0;
 
 static unsigned long next_serial = 0;
 
+/// Number of texts waiting for their layout above which they are laid out in parallel.
+static int constexpr parallel_text_layout_threshold = 16;
+
 SPDocument::SPDocument() :
     keepalive(false),
     virgin(true),
@@ -130,6 +147,8 @@ SPDocument::SPDocument() :
     // This is kept here so that members are not accessed before they are initialized
 
     _event_log = std::make_unique<Inkscape::EventLog>(this);
+    _item_index = std::make_unique<Inkscape::ItemIndex>();
+    _selector_index = std::make_unique<Inkscape::SelectorIndex>();
     _selection = std::make_unique<Inkscape::Selection>(this);
 
     _desktop_activated_connection = INKSCAPE.signal_activate_desktop.connect(
@@ -705,7 +724,7 @@ SPDocument *SPDocument::createNewDoc(gchar const *filename, bool keepalive, bool
     if (filename) {
         Inkscape::XML::Node *rroot;
         /* Try to fetch repr from file */
-        rdoc = sp_repr_read_file(filename, SP_SVG_NS_URI);
+        rdoc = sp_repr_read_file_stream(filename, SP_SVG_NS_URI);
         /* If file cannot be loaded, return NULL without warning */
         if (rdoc == nullptr) return nullptr;
         rroot = rdoc->root();
@@ -1146,14 +1165,13 @@ void SPDocument::bindObjectToId(char const *id, SPObject *object)
 
     if (object) {
         if(object->getId()) {
-            iddef.erase(object->getId());
+            iddef.erase(std::string_view(object->getId()));
         }
-        auto ret = iddef.emplace(id, object);
-        g_assert(ret.second);
+        bool inserted = iddef.insert(id, object);
+        g_assert(inserted);
     } else {
-        auto it = iddef.find(id);
-        g_assert(it != iddef.end());
-        iddef.erase(it);
+        bool erased = iddef.erase(std::string_view(id));
+        g_assert(erased);
     }
 
     auto pos = id_changed_signals.find(idq);
@@ -1166,12 +1184,12 @@ void SPDocument::bindObjectToId(char const *id, SPObject *object)
     }
 }
 
-SPObject *SPDocument::getObjectById(std::string const &id) const
+SPObject *SPDocument::getObjectById(std::string_view id) const
 {
     if (iddef.empty()) return nullptr;
 
-    if (auto rv = iddef.find(id); rv != iddef.end()) {
-        return rv->second;
+    if (auto rv = iddef.find(id)) {
+        return *rv;
     } else if (_parent_document) {
         return _parent_document->getObjectById(id);
     } else if (_ref_document) {
@@ -1181,26 +1199,21 @@ SPObject *SPDocument::getObjectById(std::string const &id) const
     return nullptr;
 }
 
-SPObject *SPDocument::getObjectById(char const *id) const
+SPObject *SPDocument::getObjectById(std::string const &id) const
 {
-    if (!id || iddef.empty()) return nullptr;
-
-    if (auto rv = iddef.find(id); rv != iddef.end()) {
-        return rv->second;
-    } else if (_parent_document) {
-        return _parent_document->getObjectById(id);
-    } else if (_ref_document) {
-        return _ref_document->getObjectById(id);
-    }
+    return getObjectById(std::string_view(id));
+}
 
-    return nullptr;
+SPObject *SPDocument::getObjectById(char const *id) const
+{
+    if (!id) return nullptr;
+    return getObjectById(std::string_view(id));
 }
 
 SPObject *SPDocument::getObjectByHref(std::string const &href) const
 {
-    if (iddef.empty()) return nullptr;
-    auto id = href.substr(1);
-    return getObjectById(id);
+    if (iddef.empty() || href.empty()) return nullptr;
+    return getObjectById(std::string_view(href).substr(1));
 }
 
 SPObject *SPDocument::getObjectByHref(char const *href) const
@@ -1332,20 +1345,19 @@ std::string SPDocument::generate_unique_id(char const *prefix)
 void SPDocument::bindObjectToRepr(Inkscape::XML::Node *repr, SPObject *object)
 {
     if (object) {
-        auto ret = reprdef.emplace(repr, object);
-        g_assert(ret.second);
+        bool inserted = reprdef.insert(repr, object);
+        g_assert(inserted);
     } else {
-        auto it = reprdef.find(repr);
-        g_assert(it != reprdef.end());
-        reprdef.erase(it);
+        bool erased = reprdef.erase(repr);
+        g_assert(erased);
     }
 }
 
 SPObject *SPDocument::getObjectByRepr(Inkscape::XML::Node *repr) const
 {
     if (!repr) return nullptr;
-    auto it = reprdef.find(repr);
-    return it == reprdef.end() ? nullptr : it->second;
+    auto rv = reprdef.find(repr);
+    return rv ? *rv : nullptr;
 }
 
 /** Returns preferred document languages (from most to least preferred)
@@ -1442,7 +1454,11 @@ SPDocument::_updateDocument(int update_flags)
 
             DocumentUndo::ScopedInsensitive _no_undo(this);
 
+            // With a single thread, texts are laid out in their own update as before.
+            _defer_text_layouts = Inkscape::Async::WorkerPool::configuredThreads() > 1;
             this->root->updateDisplay((SPCtx *)&ctx, update_flags);
+            _defer_text_layouts = false;
+            layoutDeferredTexts();
         }
         this->_emitModified();
     }
@@ -1451,6 +1467,97 @@ SPDocument::_updateDocument(int update_flags)
 }
 
 
+namespace {
+
+class TextLayoutEvent : public Inkscape::Debug::SimpleEvent<Inkscape::Debug::Event::DOCUMENT> {
+public:
+    TextLayoutEvent(SPDocument *doc, std::size_t texts, int threads, double milliseconds)
+    : SimpleEvent<Inkscape::Debug::Event::DOCUMENT>("text-layout")
+    {
+        _addProperty("document", doc->serial());
+        _addProperty("texts", static_cast<long>(texts));
+        _addProperty("threads", static_cast<long>(threads));
+        _addFormattedProperty("milliseconds", "%.3f", milliseconds);
+    }
+};
+
+} // namespace
+
+bool SPDocument::deferTextLayout(SPText *text)
+{
+    if (!_defer_text_layouts) {
+        return false;
+    }
+    if (!text->_layout_pending) {
+        text->_layout_pending = true;
+        sp_object_ref(text);
+        _deferred_text_layouts.push_back(text);
+    }
+    return true;
+}
+
+/**
+ * Lays out the texts queued by deferTextLayout() that are descendants of the given item, or all
+ * of them if none is given.
+ *
+ * SPItem::update() calls this before it computes the bounding boxes of the item, so that those of
+ * the ancestors of texts, such as the areas of their filters and paint servers, take the new
+ * layouts into account. As the update walks the tree depth first, the descendants of the item are
+ * the last texts queued.
+ *
+ * The layouts of different texts are independent, so if there are many they are handed out to
+ * the threads of a WorkerPool, which only exists while they are laid out. Calls into Pango and
+ * FreeType are serialized by the lock of the FontFactory; line breaking, shaping results from the
+ * cache, flowing into shapes and positioning run concurrently. Showing the layouts creates drawing items, which is done afterwards on the
+ * calling thread.
+ */
+void SPDocument::layoutDeferredTexts(SPItem const *ancestor)
+{
+    auto first = _deferred_text_layouts.end();
+    while (first != _deferred_text_layouts.begin() && (!ancestor || ancestor->isAncestorOf(*(first - 1)))) {
+        --first;
+    }
+    if (first == _deferred_text_layouts.end()) {
+        return;
+    }
+    auto const texts = std::vector<SPText *>(first, _deferred_text_layouts.end());
+    _deferred_text_layouts.erase(first, _deferred_text_layouts.end());
+
+    auto const start = std::chrono::steady_clock::now();
+
+    int threads = 1;
+    std::exception_ptr error;
+    try {
+        if (texts.size() >= parallel_text_layout_threshold) {
+            Inkscape::Async::WorkerPool workers;
+            threads = std::min<std::size_t>(workers.numThreads(), texts.size());
+            workers.run(texts.size(), [&] (std::size_t i) { texts[i]->rebuildLayout(); });
+        } else {
+            for (auto text : texts) {
+                text->rebuildLayout();
+            }
+        }
+    } catch (...) {
+        error = std::current_exception();
+    }
+
+    for (auto text : texts) {
+        text->_layout_pending = false;
+        // A text which was deleted in the meantime has no views left to show the layout in.
+        if (!error && text->parent) {
+            text->showLayout();
+        }
+        sp_object_unref(text);
+    }
+
+    auto const elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+    Inkscape::Debug::Logger::write<TextLayoutEvent>(this, texts.size(), threads, elapsed.count());
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
 /**
  * Repeatedly works on getting the document updated, since sometimes
  * it takes more than one pass to get the document updated.  But it
@@ -1588,6 +1695,72 @@ static std::vector<SPItem*> &find_items_in_area(std::vector<SPItem*> &s,
     return s;
 }
 
+/**
+ * Whether find_items_in_area() starting from @a root visits @a item, i.e. whether every group
+ * between them is one it enters. The arguments are those of find_items_in_area().
+ */
+static bool is_visited_in_area(SPItem const *item, SPGroup const *root, unsigned int dkey,
+                               bool take_hidden, bool take_insensitive, bool enter_groups, bool enter_layers)
+{
+    for (auto object = item->parent; object != root; object = object->parent) {
+        auto group = cast<SPGroup>(object);
+        if (!group || !group->parent) {
+            return false;
+        }
+        if ((!take_insensitive && group->isLocked()) || (!take_hidden && group->isHidden())) {
+            return false;
+        }
+        bool is_layer = group->effectiveLayerMode(dkey) == SPGroup::LAYER;
+        if (!(enter_layers && is_layer) && !enter_groups) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Return the same items as find_items_in_area() starting from the root, in the same order,
+ * but only visit the items whose bounds the spatial index finds near the area.
+ */
+static std::vector<SPItem*> find_indexed_items_in_area(Inkscape::ItemIndex &index, SPGroup *root,
+                                                       unsigned int dkey, Geom::Rect const &area,
+                                                       bool (*test)(Geom::Rect const &, Geom::Rect const &),
+                                                       bool take_hidden, bool take_insensitive,
+                                                       bool take_groups, bool enter_groups, bool enter_layers)
+{
+    std::vector<SPItem*> s;
+
+    for (auto item : index.intersecting(root, area)) {
+        if (!take_insensitive && item->isLocked()) {
+            continue;
+        }
+
+        if (!take_hidden && item->isHidden()) {
+            continue;
+        }
+
+        if (auto group = cast<SPGroup>(item)) {
+            bool is_layer = group->effectiveLayerMode(dkey) == SPGroup::LAYER;
+            if (!take_groups || (enter_layers && is_layer)) {
+                continue;
+            }
+        }
+
+        if (!is_visited_in_area(item, root, dkey, take_hidden, take_insensitive, enter_groups, enter_layers)) {
+            continue;
+        }
+
+        Geom::OptRect box = item->documentVisualBounds();
+        if (box && test(area, *box)) {
+            s.push_back(item);
+        }
+    }
+
+    // Document order, with groups after their children, as find_items_in_area() returns them.
+    std::sort(s.begin(), s.end(), sp_object_compare_position_bool);
+    return s;
+}
+
 SPItem *SPDocument::getItemFromListAtPointBottom(unsigned dkey, SPGroup *group, std::vector<SPItem*> const &list, Geom::Point const &p, bool take_insensitive)
 {
     if (!group) {
@@ -1627,10 +1800,13 @@ SPItem *SPDocument::getItemFromListAtPointBottom(unsigned dkey, SPGroup *group,
 /**
 Turn the SVG DOM into a flat list of nodes that can be searched from top-down.
 The list can be persisted, which improves "find at multiple points" speed.
+Nodes are added to _node_cache if into_groups is set, and to _toplevel_node_cache if not.
 */
 // TODO: study add `gboolean with_groups = false` as parameter.
 void SPDocument::build_flat_item_list(unsigned int dkey, SPGroup *group, gboolean into_groups) const
 {
+    auto &node_cache = into_groups ? _node_cache : _toplevel_node_cache;
+
     for (auto& o: group->children) {
         if (!is<SPItem>(&o)) {
             continue;
@@ -1641,7 +1817,7 @@ void SPDocument::build_flat_item_list(unsigned int dkey, SPGroup *group, gboolea
         } else {
             auto child = cast<SPItem>(&o);
             if (child->isVisibleAndUnlocked(dkey)) {
-                _node_cache.push_front(child);
+                node_cache.push_front(child);
             }
         }
     }
@@ -1740,6 +1916,11 @@ static SPItem *find_group_at_point(unsigned dkey, SPGroup *group, Geom::Point co
 
 std::vector<SPItem*> SPDocument::getItemsInBox(unsigned int dkey, Geom::Rect const &box, bool take_hidden, bool take_insensitive, bool take_groups, bool enter_groups, bool enter_layers) const
 {
+    // The index learns of changed bounds when the document is updated, so it can only be used
+    // when no update is pending.
+    if (!root->uflags) {
+        return find_indexed_items_in_area(*_item_index, root, dkey, box, is_within, take_hidden, take_insensitive, take_groups, enter_groups, enter_layers);
+    }
     std::vector<SPItem*> x;
     return find_items_in_area(x, this->root, dkey, box, is_within, take_hidden, take_insensitive, take_groups, enter_groups, enter_layers);
 }
@@ -1757,6 +1938,9 @@ std::vector<SPItem*> SPDocument::getItemsInBox(unsigned int dkey, Geom::Rect con
 
 std::vector<SPItem*> SPDocument::getItemsPartiallyInBox(unsigned int dkey, Geom::Rect const &box, bool take_hidden, bool take_insensitive, bool take_groups, bool enter_groups, bool enter_layers) const
 {
+    if (!root->uflags) {
+        return find_indexed_items_in_area(*_item_index, root, dkey, box, overlaps, take_hidden, take_insensitive, take_groups, enter_groups, enter_layers);
+    }
     std::vector<SPItem*> x;
     return find_items_in_area(x, this->root, dkey, box, overlaps, take_hidden, take_insensitive, take_groups, enter_groups, enter_layers);
 }
@@ -1810,10 +1994,10 @@ SPItem *SPDocument::getItemAtPoint( unsigned const key, Geom::Point const &p,
                                     bool const into_groups, SPItem *upto) const
 {
     // Build a flattened SVG DOM for find_item_at_point.
-    std::deque<SPItem*> bak(_node_cache);
-    if(!into_groups){
-        _node_cache.clear();
-        build_flat_item_list(key, this->root, into_groups);
+    if(!_toplevel_node_cache_valid && !into_groups){
+        _toplevel_node_cache.clear();
+        build_flat_item_list(key, this->root, false);
+        _toplevel_node_cache_valid=true;
     }
     if(!_node_cache_valid && into_groups){
         _node_cache.clear();
@@ -1821,10 +2005,7 @@ SPItem *SPDocument::getItemAtPoint( unsigned const key, Geom::Point const &p,
         _node_cache_valid=true;
     }
 
-    SPItem *res = find_item_at_point(_node_cache, key, p, upto);
-    if(!into_groups)
-        _node_cache = bak;
-    return res;
+    return find_item_at_point(into_groups ? _node_cache : _toplevel_node_cache, key, p, upto);
 }
 
 SPItem *SPDocument::getGroupAtPoint(unsigned int key, Geom::Point const &p) const
@@ -2271,6 +2452,7 @@ void SPDocument::_emitModified() {
     root->emitModified(0);
     modified_signal.emit(flags);
     _node_cache_valid=false;
+    _toplevel_node_cache_valid=false;
 }
 
 void
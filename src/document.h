@@ -23,6 +23,7 @@
 #include <deque>
 #include <map>
 #include <memory>
+#include <string_view>
 #include <vector>
 #include <queue>
 
@@ -43,6 +44,7 @@
 #include "gc-finalized.h"
 
 #include "inkgc/gc-managed.h"
+#include "util/flat_hash_map.h"
 
 #include "composite-undo-stack-observer.h"
 // XXX only for testing!
@@ -74,12 +76,15 @@ class SPItem;
 class SPObject;
 class SPGroup;
 class SPRoot;
+class SPText;
 class SPNamedView;
 
 namespace Inkscape {
     class Selection; 
     class UndoStackObserver;
     class EventLog;
+    class ItemIndex;
+    class SelectorIndex;
     class ProfileManager;
     class PageManager;
     namespace XML {
@@ -163,6 +168,17 @@ public:
     bool _updateDocument(int flags); // Used by stand-alone sp_document_idle_handler
     int ensureUpToDate();
 
+    /**
+     * Called by texts when their layout needs to be rebuilt. While the document is updated with
+     * several threads, the text is queued and its layout is calculated together with those of its
+     * queued siblings and cousins when the update reaches their common ancestor item, in parallel
+     * if there are many.
+     *
+     * @return Whether the text was queued; otherwise it must lay itself out right away.
+     */
+    bool deferTextLayout(SPText *text);
+    void layoutDeferredTexts(SPItem const *ancestor = nullptr);
+
     bool addResource(char const *key, SPObject *object);
     bool removeResource(char const *key, SPObject *object);
     std::vector<SPObject *> const getResourceList(char const *key);
@@ -224,6 +240,8 @@ public:
 
     // Styling
     CRCascade    *getStyleCascade() { return style_cascade; }
+    /// Index of the rulesets of the style cascade, through which SPStyle matches them.
+    Inkscape::SelectorIndex &getSelectorIndex() { return *_selector_index; }
 
     // File information --------------------
 
@@ -279,6 +297,7 @@ public:
 
     // Find items -----------------------------
     void bindObjectToId(char const *id, SPObject *object);
+    SPObject *getObjectById(std::string_view id) const;
     SPObject *getObjectById(std::string const &id) const;
     SPObject *getObjectById(char const *id) const;
     SPObject *getObjectByHref(std::string const &href) const;
@@ -329,6 +348,9 @@ public:
     std::vector<SPItem*> getItemsAtPoints(unsigned const key, std::vector<Geom::Point> points, bool all_layers = true, bool topmost_only = true, size_t limit = 0) const;
     SPItem *getGroupAtPoint(unsigned int key,  Geom::Point const &p) const;
 
+    /// Spatial index behind getItemsInBox() and getItemsPartiallyInBox().
+    Inkscape::ItemIndex &getItemIndex() const { return *_item_index; }
+
     /**
      * Returns the bottommost item from the list which is at the point, or NULL if none.
      */
@@ -403,6 +425,7 @@ private:
 
     // Styling
     CRCascade *style_cascade;
+    std::unique_ptr<Inkscape::SelectorIndex> _selector_index;
 
     // Desktop geometry
     mutable Geom::Affine _doc2dt;
@@ -413,12 +436,19 @@ private:
     char *document_name;  ///< basename or other human-readable label for the document.
 
     // Find items ----------------------------
-    std::map<std::string, SPObject *> iddef;
-    std::map<Inkscape::XML::Node *, SPObject *> reprdef;
+    Inkscape::Util::flat_hash_map<std::string, SPObject *, Inkscape::Util::string_hash, std::equal_to<>> iddef;
+    Inkscape::Util::flat_hash_map<Inkscape::XML::Node *, SPObject *> reprdef;
 
     // Find items by geometry --------------------
     mutable std::deque<SPItem*> _node_cache; // Used to speed up search.
     mutable bool _node_cache_valid;
+    mutable std::deque<SPItem*> _toplevel_node_cache; // As above, but without entering groups.
+    mutable bool _toplevel_node_cache_valid = false;
+    std::unique_ptr<Inkscape::ItemIndex> _item_index;
+
+    // Text layout ----------------------------
+    std::vector<SPText *> _deferred_text_layouts;
+    bool _defer_text_layouts = false;
 
     // Box tool ----------------------------
     Persp3D *current_persp3d; /**< Currently 'active' perspective (to which, e.g., newly created boxes are attached) */
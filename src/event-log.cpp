@@ -346,6 +346,51 @@ EventLog::notifyUndoCommitEvent(Event* log)
     updateUndoVerbs();
 }
 
+void
+EventLog::notifyUndoExpiredEvent(Event *log)
+{
+    auto &_columns = getColumns();
+
+    // the oldest event follows the initial pseudo event
+    auto const first = _event_list_store->children().begin();
+    auto oldest = first;
+    ++oldest;
+    g_return_if_fail ( oldest != _event_list_store->children().end() && (*oldest)[_columns.event] == log );
+
+    // The initial pseudo event now stands for the state after the oldest event, which is gone.
+    if (_last_saved == first) {
+        _last_saved = (iterator)nullptr;
+    } else if (_last_saved == oldest) {
+        _last_saved = first;
+    }
+    if (_curr_event == oldest) {
+        _curr_event = first;
+    }
+
+    if (oldest->children().empty()) {
+        _event_list_store->erase(oldest);
+    } else {
+        // the first child event of the branch takes the place of its parent
+        auto child = oldest->children().begin();
+        Event *event = (*child)[_columns.event];
+        Glib::ustring description = (*child)[_columns.description];
+        (*oldest)[_columns.event] = event;
+        (*oldest)[_columns.description] = description;
+
+        for (auto it : {&_curr_event, &_last_event, &_last_saved}) {
+            if (*it == child) {
+                *it = oldest;
+            }
+        }
+        _event_list_store->erase(child);
+
+        (*oldest)[_columns.child_count] = oldest->children().size() + 1;
+        if (oldest->children().empty() && _curr_event_parent == oldest) {
+            _curr_event_parent = (iterator)nullptr;
+        }
+    }
+}
+
 void
 EventLog::notifyClearUndoEvent()
 {
@@ -17,6 +17,7 @@
 
 #include <glibmm/ustring.h>
 
+#include <cstddef>
 #include <utility>
 
 #include "xml/event-fns.h"
@@ -39,6 +40,7 @@ public:
     virtual ~Event() { sp_repr_free_log (event); }
 
     XML::Event *event;
+    std::size_t memory = 0;   // Estimate of the memory used by event, see sp_repr_log_memory().
     unsigned int type = 0;
     Glib::ustring description; // The description to use in the Undo dialog.
     Glib::ustring icon_name;   // The icon to use in the Undo dialog.
@@ -15,6 +15,18 @@
  */
 
 
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <boost/asio/post.hpp>
+#include <boost/asio/thread_pool.hpp>
+#include <2geom/int-rect.h>
 #include <2geom/rect.h>
 #include <2geom/transforms.h>
 
@@ -51,15 +63,44 @@
  * working PNG reader/writer, see pngtest.c, included in this distribution.
  */
 
+/**
+ * A horizontal strip of the export area, rendered and converted to PNG rows by a worker thread.
+ */
+struct SPExportStrip {
+    int row = 0;
+    int num_rows = 0;
+    std::vector<guchar const *> rows; ///< Pointers into data, one per row.
+    guchar const *data = nullptr;     ///< PNG pixel data, freed by the consumer.
+};
+
 struct SPEBP {
     unsigned long int width, height, sheight;
     guint32 background;
-    Inkscape::Drawing *drawing; // it is assumed that all unneeded items are hidden
-    guchar *px;
+    Inkscape::Drawing *drawing; // it is assumed that all unneeded items are hidden, and that it is snapshotted
+    Geom::IntPoint origin{0, 0}; ///< Position of the image in the drawing, which may be shared by several images.
     unsigned (*status)(float, void *);
     void *data;
+
+    // Strips are rendered concurrently on the pool, but handed to libpng strictly in order.
+    std::optional<boost::asio::thread_pool> pool;
+    unsigned max_pending;                            ///< Upper bound on strips in flight, limits memory use.
+    std::deque<std::pair<unsigned long, std::future<SPExportStrip>>> pending; ///< Queued strips by first row, in order.
+    unsigned long next_row = 0;                      ///< First row not yet queued.
+
+    void drain();
 };
 
+/**
+ * Wait for all queued strips to finish and discard their results.
+ */
+void SPEBP::drain()
+{
+    for (auto &strip : pending) {
+        g_free(const_cast<guchar *>(strip.second.get().data));
+    }
+    pending.clear();
+}
+
 /* write a png file */
 
 struct SPPNGBD {
@@ -214,6 +255,10 @@ sp_png_write_rgba_striped(SPDocument *doc,
 
     textList.add("Software", "www.inkscape.org"); // Made by Inkscape comment
     {
+        // The RDF getters return a static buffer, and batch exports write several files at once.
+        static std::mutex rdf_mutex;
+        auto lock = std::lock_guard(rdf_mutex);
+
         const gchar* pngToDc[] = {"Title", "title",
                                "Author", "creator",
                                "Description", "description",
@@ -320,55 +365,111 @@ sp_png_write_rgba_striped(SPDocument *doc,
 
 
 /**
- *
+ * Render one strip of the export area. Called from worker threads; the drawing must be snapshotted.
  */
-static int
-sp_export_get_rows(guchar const **rows, void **to_free, int row, int num_rows, void *data, int color_type, int bit_depth)
+static SPExportStrip
+sp_export_render_strip(SPEBP const &ebp, int row, int num_rows, int color_type, int bit_depth)
 {
-    struct SPEBP *ebp = (struct SPEBP *) data;
-
-    if (ebp->status) {
-        if (!ebp->status((float) row / ebp->height, ebp->data)) return 0;
-    }
-
-    num_rows = MIN(num_rows, static_cast<int>(ebp->sheight));
-    num_rows = MIN(num_rows, static_cast<int>(ebp->height - row));
-
     /* Set area of interest */
-    // bbox is now set to the entire image to prevent discontinuities
+    // The drawing has been updated for the entire image to prevent discontinuities
     // in the image when blur is used (the borders may still be a bit
     // off, but that's less noticeable).
-    Geom::IntRect bbox = Geom::IntRect::from_xywh(0, row, ebp->width, num_rows);
-
-    /* Update to renderable state */
-    ebp->drawing->update(bbox);
+    Geom::IntRect bbox = Geom::IntRect::from_xywh(ebp.origin.x(), ebp.origin.y() + row, ebp.width, num_rows);
 
-    int stride = cairo_format_stride_for_width(CAIRO_FORMAT_ARGB32, ebp->width);
+    int stride = cairo_format_stride_for_width(CAIRO_FORMAT_ARGB32, ebp.width);
     unsigned char *px = g_new(guchar, num_rows * stride);
 
     cairo_surface_t *s = cairo_image_surface_create_for_data(
-        px, CAIRO_FORMAT_ARGB32, ebp->width, num_rows, stride);
+        px, CAIRO_FORMAT_ARGB32, ebp.width, num_rows, stride);
     Inkscape::DrawingContext dc(s, bbox.min());
-    dc.setSource(ebp->background);
+    dc.setSource(ebp.background);
     dc.setOperator(CAIRO_OPERATOR_SOURCE);
     dc.paint();
     dc.setOperator(CAIRO_OPERATOR_OVER);
 
     /* Render */
-    ebp->drawing->render(dc, bbox, 0);
+    ebp.drawing->render(dc, bbox, 0);
     cairo_surface_destroy(s);
 
     // PNG stores data as unpremultiplied big-endian RGBA, which means
     // it's identical to the GdkPixbuf format.
-    convert_pixels_argb32_to_pixbuf(px, ebp->width, num_rows, stride,
-                                    /* RGBA to ARGB with A=0 */ ebp->background >> 8);
-    
+    convert_pixels_argb32_to_pixbuf(px, ebp.width, num_rows, stride,
+                                    /* RGBA to ARGB with A=0 */ ebp.background >> 8);
+
     // If a custom bit depth or color type is asked, then convert rgb to grayscale, etc.
-    const guchar* new_data = pixbuf_to_png(rows, px, num_rows, ebp->width, stride, color_type, bit_depth);
-    *to_free = (void*) new_data;
-    free(px);
+    SPExportStrip strip;
+    strip.row = row;
+    strip.num_rows = num_rows;
+    strip.rows.resize(num_rows);
+    strip.data = pixbuf_to_png(strip.rows.data(), px, num_rows, ebp.width, stride, color_type, bit_depth);
+    g_free(px);
+
+    return strip;
+}
+
+/**
+ *
+ */
+static int
+sp_export_get_rows(guchar const **rows, void **to_free, int row, int num_rows, void *data, int color_type, int bit_depth)
+{
+    struct SPEBP *ebp = (struct SPEBP *) data;
 
-    return num_rows;
+    if (ebp->status) {
+        if (!ebp->status((float) row / ebp->height, ebp->data)) {
+            ebp->drain();
+            return 0;
+        }
+    }
+
+    // Each interlace pass starts again from the top, so anything queued must match the requested row.
+    if (ebp->pending.empty()) {
+        ebp->next_row = row;
+    } else if (ebp->pending.front().first != static_cast<unsigned long>(row)) {
+        ebp->drain();
+        ebp->next_row = row;
+    }
+
+    // Keep the pool busy with the strips following this one.
+    while (ebp->pending.size() < ebp->max_pending && ebp->next_row < ebp->height) {
+        int strip_row = ebp->next_row;
+        int strip_rows = MIN(ebp->sheight, ebp->height - ebp->next_row);
+        auto task = std::make_shared<std::packaged_task<SPExportStrip()>>([=] {
+            return sp_export_render_strip(*ebp, strip_row, strip_rows, color_type, bit_depth);
+        });
+        ebp->pending.emplace_back(strip_row, task->get_future());
+        boost::asio::post(*ebp->pool, [task] { (*task)(); });
+        ebp->next_row += strip_rows;
+    }
+
+    if (ebp->pending.empty()) {
+        return 0;
+    }
+
+    auto strip = ebp->pending.front().second.get();
+    ebp->pending.pop_front();
+
+    std::copy(strip.rows.begin(), strip.rows.end(), rows);
+    *to_free = (void *) strip.data;
+
+    return strip.num_rows;
+}
+
+/**
+ * Render the strips of an image one after the other on the calling thread, for batch exports,
+ * which get their concurrency from rendering several images at once.
+ */
+static int
+sp_export_get_rows_serial(guchar const **rows, void **to_free, int row, int num_rows, void *data, int color_type, int bit_depth)
+{
+    auto const ebp = static_cast<SPEBP const *>(data);
+
+    auto strip = sp_export_render_strip(*ebp, row, MIN(static_cast<int>(ebp->sheight), num_rows), color_type, bit_depth);
+
+    std::copy(strip.rows.begin(), strip.rows.end(), rows);
+    *to_free = (void *) strip.data;
+
+    return strip.num_rows;
 }
 
 ExportResult sp_export_png_file(SPDocument *doc, gchar const *filename,
@@ -456,15 +557,25 @@ ExportResult sp_export_png_file(SPDocument *doc, gchar const *filename,
     ebp.status = status;
     ebp.data   = data;
 
-    bool write_status = false;;
-
     ebp.sheight = 64;
-    ebp.px = g_try_new(guchar, 4 * ebp.sheight * width);
 
-    if (ebp.px) {
-        write_status = sp_png_write_rgba_striped(doc, filename, width, height, xdpi, ydpi, sp_export_get_rows, &ebp, interlace, color_type, bit_depth, zlib);
-        g_free(ebp.px);
-    }
+    /* Update to renderable state once for the whole image, then freeze the drawing so
+     * that the strips can be rendered concurrently. */
+    drawing.update(Geom::IntRect::from_xywh(0, 0, width, height));
+    drawing.snapshot();
+
+    auto prefs = Inkscape::Preferences::get();
+    unsigned const hardware_threads = std::thread::hardware_concurrency();
+    int const numthreads = prefs->getIntLimited("/options/threading/numthreads", hardware_threads ? hardware_threads : 4, 1, 256);
+    ebp.pool.emplace(numthreads);
+    ebp.max_pending = 2 * numthreads;
+
+    bool write_status = sp_png_write_rgba_striped(doc, filename, width, height, xdpi, ydpi, sp_export_get_rows, &ebp, interlace, color_type, bit_depth, zlib);
+
+    // Strips may still be in flight if libpng bailed out or the export was cancelled.
+    ebp.drain();
+    ebp.pool->join();
+    drawing.unsnapshot();
 
     // Hide items, this releases arenaitem
     doc->getRoot()->invoke_hide(dkey);
@@ -472,6 +583,116 @@ ExportResult sp_export_png_file(SPDocument *doc, gchar const *filename,
     return write_status ? EXPORT_OK : EXPORT_ERROR;
 }
 
+void sp_export_png_batch(SPDocument *doc, std::vector<SPExportPngJob> &jobs, bool interlace, int zlib, int antialiasing)
+{
+    g_return_if_fail(doc != nullptr);
+
+    doc->ensureUpToDate();
+
+    /* Create one drawing for all images */
+    Inkscape::Drawing drawing;
+    unsigned const dkey = SPItem::display_key_new(1);
+    drawing.setRoot(doc->getRoot()->invoke_show(drawing, dkey, SP_ITEM_SHOW_DISPLAY));
+    drawing.setExact(); // export with maximum blur rendering quality
+    drawing.setAntialiasingOverride(static_cast<Inkscape::Antialiasing>(antialiasing));
+
+    auto prefs = Inkscape::Preferences::get();
+    unsigned const hardware_threads = std::thread::hardware_concurrency();
+    int const numthreads = prefs->getIntLimited("/options/threading/numthreads", hardware_threads ? hardware_threads : 4, 1, 256);
+    boost::asio::thread_pool pool(numthreads);
+
+    std::vector<bool> done(jobs.size(), false);
+    for (size_t i = 0; i < jobs.size(); i++) {
+        if (done[i]) {
+            continue;
+        }
+
+        auto const &first = jobs[i];
+        if (first.width < 1 || first.height < 1 || first.area.hasZeroArea()) {
+            g_warning("sp_export_png_batch: Invalid dimensions for %s", first.filename.c_str());
+            done[i] = true;
+            continue;
+        }
+
+        auto const scale = Geom::Scale(first.width / first.area.width(), first.height / first.area.height());
+        Geom::Affine const affine(Geom::Translate(-first.area.min()) * scale);
+
+        // Gather the images that can be rendered from the same update as this one: those of the same
+        // scale, whose offset from this one is a whole number of pixels. On a regular sprite sheet,
+        // that is all of them.
+        std::vector<std::pair<size_t, Geom::IntPoint>> group;
+        Geom::OptIntRect update_area;
+        for (size_t j = i; j < jobs.size(); j++) {
+            auto const &job = jobs[j];
+            if (done[j] || job.width < 1 || job.height < 1 || job.area.hasZeroArea()) {
+                continue;
+            }
+            auto const job_scale = Geom::Scale(job.width / job.area.width(), job.height / job.area.height());
+            if (!Geom::are_near(job_scale[Geom::X], scale[Geom::X], 1e-9 * scale[Geom::X]) ||
+                !Geom::are_near(job_scale[Geom::Y], scale[Geom::Y], 1e-9 * scale[Geom::Y]))
+            {
+                continue;
+            }
+            auto const offset = (job.area.min() - first.area.min()) * scale;
+            auto const pixel_offset = offset.round();
+            if (!Geom::are_near(offset, pixel_offset, 1e-6)) {
+                continue;
+            }
+            done[j] = true;
+            group.emplace_back(j, pixel_offset);
+            update_area.unionWith(Geom::IntRect::from_xywh(pixel_offset, Geom::IntPoint(job.width, job.height)));
+        }
+
+        /* Update to renderable state once for the whole group, then freeze the drawing so
+         * that the images can be rendered concurrently. */
+        drawing.root()->setTransform(affine);
+        drawing.update(*update_area);
+        drawing.snapshot();
+
+        std::vector<std::future<void>> futures;
+        for (auto const &[index, origin] : group) {
+            auto task = std::make_shared<std::packaged_task<void()>>([&, index = index, origin = origin] {
+                auto &job = jobs[index];
+                auto const start = std::chrono::steady_clock::now();
+
+                struct SPEBP ebp;
+                ebp.width = job.width;
+                ebp.height = job.height;
+                ebp.sheight = 64;
+                ebp.background = job.bgcolor;
+                ebp.drawing = &drawing;
+                ebp.origin = origin;
+                ebp.status = nullptr;
+                ebp.data = nullptr;
+
+                bool const write_status = sp_png_write_rgba_striped(doc, job.filename.c_str(), job.width, job.height,
+                                                                    job.xdpi, job.ydpi, sp_export_get_rows_serial, &ebp,
+                                                                    interlace, job.color_type, job.bit_depth, zlib);
+
+                job.result = write_status ? EXPORT_OK : EXPORT_ERROR;
+                job.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            });
+            futures.push_back(task->get_future());
+            boost::asio::post(pool, [task] { (*task)(); });
+        }
+
+        // Wait for the whole group before the drawing is updated for the next one.
+        for (auto &future : futures) {
+            future.wait();
+        }
+        drawing.unsnapshot();
+
+        for (auto &future : futures) {
+            future.get(); // Rethrow exceptions from the workers.
+        }
+    }
+
+    pool.join();
+
+    // Hide items, this releases arenaitem
+    doc->getRoot()->invoke_hide(dkey);
+}
+
 
 /*
   Local Variables:
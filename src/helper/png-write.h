@@ -16,9 +16,11 @@
  */
 
 #include <glib.h> // Only for gchar.
+#include <string>
 #include <vector>
 
 #include <2geom/forward.h>
+#include <2geom/rect.h>
 
 class SPDocument;
 class SPItem;
@@ -48,4 +50,30 @@ ExportResult sp_export_png_file(SPDocument *doc, gchar const *filename,
 				unsigned int (*status) (float, void *), void *data, bool force_overwrite = false, const std::vector<SPItem*> &items_only = std::vector<SPItem*>(), 
                                 bool interlace = false, int color_type = 6, int bit_depth = 8, int zlib = 6, int antialiasing = 2);
 
+/**
+ * One image of a batch export, see sp_export_png_batch().
+ */
+struct SPExportPngJob {
+    std::string filename;
+    Geom::Rect area; ///< Area in document coordinates.
+    unsigned long width, height;
+    double xdpi, ydpi;
+    unsigned long bgcolor;
+    int color_type = 6;
+    int bit_depth = 8;
+
+    ExportResult result = EXPORT_ERROR; ///< Set by sp_export_png_batch().
+    double seconds = 0.0;               ///< Time taken to render and write the image, set by sp_export_png_batch().
+};
+
+/**
+ * Export several areas of a document to PNG files, overwriting existing files.
+ *
+ * Unlike repeated calls to sp_export_png_file(), the document is shown only once, the drawing is
+ * updated once for all images of the same scale and pixel alignment, and the images are rendered
+ * and written concurrently.
+ */
+void sp_export_png_batch(SPDocument *doc, std::vector<SPExportPngJob> &jobs,
+                         bool interlace = false, int zlib = 6, int antialiasing = 2);
+
 #endif // SEEN_SP_PNG_WRITE_H
@@ -15,10 +15,13 @@
 
 #include "file-export-cmd.h"
 
+#include <algorithm>
 #include <boost/algorithm/string.hpp>
+#include <chrono>
 #include <iostream>
 #include <png.h> // PNG export
 #include <string>
+#include <unordered_set>
 
 #include "document.h"
 #include "extension/db.h"
@@ -511,6 +514,11 @@ InkFileExportCmd::do_export_png(SPDocument *doc, std::string const &export_filen
         objects_found.push_back(object_id);
     }
 
+    // Unless other objects have to be hidden for each image, all images are exported at the end
+    // from a single drawing of the document.
+    std::vector<SPExportPngJob> batch;
+    auto const batch_ptr = export_id_only ? nullptr : &batch;
+
     // Export pages instead of objects
     if (!export_page.empty()) {
         auto &pm = doc->getPageManager();
@@ -526,9 +534,11 @@ InkFileExportCmd::do_export_png(SPDocument *doc, std::string const &export_filen
             // And if only one page is selected then we assume the user knows the filename they intended.
             std::string filename_out = base + (pages.size() > 1 ? "_p" + std::to_string(page_num) : "") + ".png";
             if (auto page = pm.getPage(page_num - 1)) {
-                do_export_png_now(doc, filename_out, page->getDesktopRect(), dpi, items);
+                do_export_png_now(doc, filename_out, page->getDesktopRect(), dpi, items, batch_ptr);
             }
         }
+        do_export_png_batch(doc, batch);
+        prefs->setBool("/options/dithering/value", old_dither);
         return 0;
     }
 
@@ -661,15 +671,20 @@ InkFileExportCmd::do_export_png(SPDocument *doc, std::string const &export_filen
             area = area.roundOutwards();
         }
         // End finding area.
-        do_export_png_now(doc, filename_out, area, dpi, items);
+        do_export_png_now(doc, filename_out, area, dpi, items, batch_ptr);
 
     } // End loop over objects.
+    do_export_png_batch(doc, batch);
     prefs->setBool("/options/dithering/value", old_dither);
     return 0;
 }
 
+/**
+ *  Export a single PNG image, or add it to a batch exported later by do_export_png_batch().
+ */
 void
-InkFileExportCmd::do_export_png_now(SPDocument *doc, std::string const &filename_out, Geom::Rect area, double dpi_in, const std::vector<SPItem *> &items)
+InkFileExportCmd::do_export_png_now(SPDocument *doc, std::string const &filename_out, Geom::Rect area, double dpi_in, const std::vector<SPItem *> &items,
+                                    std::vector<SPExportPngJob> *batch)
 {
     // -------------------------- DPI -------------------------------
 
@@ -774,6 +789,11 @@ InkFileExportCmd::do_export_png_now(SPDocument *doc, std::string const &filename
                   << width << " x " << height << " pixels (" << dpi << " dpi)" << std::endl;
 #endif
 
+        if (batch) {
+            batch->push_back({filename_out, area, width, height, xdpi, ydpi, bgcolor, color_type, bit_depth});
+            return;
+        }
+
         if( sp_export_png_file(doc, filename_out.c_str(), area, width, height, xdpi, ydpi,
                                bgcolor, nullptr, nullptr, true, export_id_only ? items : std::vector<SPItem*>(),
                                false, color_type, bit_depth) == 1 ) {
@@ -782,6 +802,55 @@ InkFileExportCmd::do_export_png_now(SPDocument *doc, std::string const &filename
         }
 }
 
+/**
+ *  Export the PNG images collected by do_export_png_now(), reporting the time taken by each.
+ */
+void
+InkFileExportCmd::do_export_png_batch(SPDocument *doc, std::vector<SPExportPngJob> &batch)
+{
+    // Later images overwrite earlier ones of the same name, as they would if exported one by one.
+    std::unordered_set<std::string> names;
+    std::vector<SPExportPngJob> unique;
+    for (auto it = batch.rbegin(); it != batch.rend(); ++it) {
+        if (names.insert(it->filename).second) {
+            unique.push_back(std::move(*it));
+        }
+    }
+    std::reverse(unique.begin(), unique.end());
+    batch = std::move(unique);
+
+    if (batch.empty()) {
+        return;
+    }
+
+    // A single image is better served by rendering its strips concurrently.
+    if (batch.size() == 1) {
+        auto const &job = batch.front();
+        if (sp_export_png_file(doc, job.filename.c_str(), job.area, job.width, job.height, job.xdpi, job.ydpi,
+                               job.bgcolor, nullptr, nullptr, true, {}, false, job.color_type, job.bit_depth) != EXPORT_OK) {
+            std::cerr << "InkFileExport::do_export_png: Failed to export to " << job.filename << std::endl;
+        }
+        return;
+    }
+
+    auto const start = std::chrono::steady_clock::now();
+    sp_export_png_batch(doc, batch);
+    auto const seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    int failed = 0;
+    for (auto const &job : batch) {
+        if (job.result == EXPORT_OK) {
+            std::cerr << "Exported " << job.filename << " (" << job.width << "x" << job.height << ") in "
+                      << job.seconds * 1000.0 << " ms" << std::endl;
+        } else {
+            std::cerr << "InkFileExport::do_export_png: Failed to export to " << job.filename << std::endl;
+            failed++;
+        }
+    }
+    std::cerr << "Exported " << batch.size() - failed << " of " << batch.size() << " images in "
+              << seconds * 1000.0 << " ms" << std::endl;
+}
+
 
 /**
  *  Perform a PDF/PS/EPS export
@@ -18,6 +18,7 @@
 
 class SPDocument;
 class SPItem;
+struct SPExportPngJob;
 namespace Inkscape {
 namespace Extension {
 class Output;
@@ -53,7 +54,9 @@ private:
     int do_export_extension(SPDocument *doc, std::string const &filename_in, Inkscape::Extension::Output *extension);
     Glib::ustring export_type_current;
 
-    void do_export_png_now(SPDocument *doc, std::string const &filename_out, Geom::Rect area, double dpi_in, const std::vector<SPItem *> &items);
+    void do_export_png_now(SPDocument *doc, std::string const &filename_out, Geom::Rect area, double dpi_in, const std::vector<SPItem *> &items,
+                           std::vector<SPExportPngJob> *batch = nullptr);
+    void do_export_png_batch(SPDocument *doc, std::vector<SPExportPngJob> &batch);
 public:
     // Should be private, but this is just temporary code (I hope!).
 
@@ -16,6 +16,7 @@
 #include "style.h"
 #include "font-instance.h"
 #include "font-factory.h"
+#include "shaping-cache.h"
 #include "svg/svg-length.h"
 #include "object/sp-object.h"
 #include "object/sp-flowdiv.h"
@@ -125,6 +126,8 @@ class Layout::Calculator
         void free()
         {
             if (item) {
+                // Releases the font, which the font map shares between threads.
+                auto engine_lock = std::lock_guard(FontFactory::get().mutex());
                 pango_item_free(item);
                 item = nullptr;
             }
@@ -904,6 +907,7 @@ void Layout::Calculator::_outputLine(ParagraphInfo const &para,
                         } else {
                             // Upright orientation
 
+                            auto engine_lock = std::lock_guard(FontFactory::get().mutex());
                             auto hb_font = pango_font_get_hb_font(font->get_font());
 
 #ifdef DEBUG_GLYPH
@@ -1331,6 +1335,9 @@ void  Layout::Calculator::_buildPangoItemizationForPara(ParagraphInfo *para) con
 
     TRACE(("itemizing para, first input %d\n", para->first_input_index));
 
+    // Text may be laid out on several threads, which share the font map.
+    auto engine_lock = std::lock_guard(FontFactory::get().mutex());
+
     PangoAttrList *attributes_list = pango_attr_list_new();
     for (unsigned input_index = para->first_input_index ; input_index < _flow._input_stream.size() ; input_index++) {
         if (_flow._input_stream[input_index]->Type() == CONTROL_CODE) {
@@ -1609,13 +1616,13 @@ unsigned Layout::Calculator::_buildSpansForPara(ParagraphInfo *para) const
                     auto gnew = std::string_view(para->text.data()         + para_text_index,           new_span.text_bytes);
                     assert (gold == gnew);
 
-                    // Convert characters to glyphs
-                    pango_shape_full(para->text.data() + para_text_index,
-                                     new_span.text_bytes,
-                                     para->text.data(),
-                                     -1,
-                                     &para->pango_items[pango_item_index].item->analysis,
-                                     new_span.glyph_string);
+                    // Convert characters to glyphs, or reuse those of an identical run of text
+                    ShapingCache::get().shape(para->text.data() + para_text_index,
+                                              new_span.text_bytes,
+                                              para->text.data(),
+                                              -1,
+                                              &para->pango_items[pango_item_index].item->analysis,
+                                              new_span.glyph_string);
 
                     if (para->pango_items[pango_item_index].item->analysis.level & 1) {
                         // Right to left text (Arabic, Hebrew, etc.)
@@ -223,6 +223,25 @@ FontFactory::~FontFactory()
     g_object_unref(fontServer);
 }
 
+PangoContext *FontFactory::get_font_context() const
+{
+    if (std::this_thread::get_id() == _main_thread) {
+        return fontContext;
+    }
+
+    // Contexts are not thread-safe, and text layout sets their gravity.
+    struct Unref
+    {
+        void operator()(PangoContext *context) const { g_object_unref(context); }
+    };
+    thread_local std::unique_ptr<PangoContext, Unref> context;
+    if (!context) {
+        auto lock = std::lock_guard(_mutex);
+        context.reset(pango_font_map_create_context(fontServer));
+    }
+    return context.get();
+}
+
 void FontFactory::refreshConfig()
 {
     pango_fc_font_map_config_changed(PANGO_FC_FONT_MAP(fontServer));
@@ -594,6 +613,19 @@ std::shared_ptr<FontInstance> FontFactory::FaceFromFontSpecification(char const
 }
 
 std::shared_ptr<FontInstance> FontFactory::Face(PangoFontDescription *descr, bool canFail)
+{
+    auto lock = std::lock_guard(_mutex);
+    auto face = _face(descr, canFail);
+
+    // The cache of loaded fonts is not thread-safe either, so release the face under the lock,
+    // on whichever thread drops the last reference to it.
+    return std::shared_ptr<FontInstance>(face.get(), [this, face] (FontInstance *) mutable {
+        auto lock = std::lock_guard(_mutex);
+        face.reset();
+    });
+}
+
+std::shared_ptr<FontInstance> FontFactory::_face(PangoFontDescription *descr, bool canFail)
 {
     // Mandatory huge size (hinting workaround).
     pango_font_description_set_size(descr, fontSize * PANGO_SCALE);
@@ -610,7 +642,7 @@ std::shared_ptr<FontInstance> FontFactory::Face(PangoFontDescription *descr, boo
             PANGO_DEBUG("Falling back from %s to 'sans-serif' because InstallFace failed\n", tc);
             g_free(tc);
             pango_font_description_set_family(descr, "sans-serif");
-            return Face(descr, false);
+            return _face(descr, false);
         } else {
             throw std::runtime_error(std::string("Could not load any face for font ") + pango_font_description_to_string(descr));
         }
@@ -14,6 +14,8 @@
 #include <algorithm>
 #include <utility>
 #include <memory>
+#include <mutex>
+#include <thread>
 
 #include <pango/pango.h>
 #include "style.h"
@@ -85,6 +87,7 @@ public:
     std::shared_ptr<FontInstance> FaceFromUIStrings(char const *uiFamily, char const *uiStyle);
     std::shared_ptr<FontInstance> FaceFromPangoString(char const *pangoString);
     std::shared_ptr<FontInstance> FaceFromFontSpecification(char const *fontSpecification);
+    /// Look up or load a font. Thread-safe, as are the lookups above, which all go through it.
     std::shared_ptr<FontInstance> Face(PangoFontDescription *descr, bool canFail = true);
 
 # ifdef _WIN32
@@ -97,12 +100,21 @@ public:
     /// Add a an additional font.
     void AddFontFile(char const *utf8file);
 
-    PangoContext *get_font_context() const { return fontContext; }
+    /// The Pango context of the calling thread; threads other than the main one get their own.
+    PangoContext *get_font_context() const;
+
+    /**
+     * Lock for whatever uses the font map or FreeType faces from threads other than the main one,
+     * such as itemisation and shaping during parallel text layout.
+     */
+    std::recursive_mutex &mutex() const { return _mutex; }
     PangoFontDescription *parsePostscriptName(std::string const &name, bool substitute);
 private:
     // Pango data. Backend-specific structures are cast to these opaque types.
     PangoFontMap *fontServer;
     PangoContext *fontContext;
+    std::thread::id _main_thread = std::this_thread::get_id();
+    mutable std::recursive_mutex _mutex;
 
     // A hashmap of all the loaded font instances, indexed by their PangoFontDescription.
     // Note: Since pango already does that, using the PangoFont could work too.
@@ -116,6 +128,8 @@ private:
     };
     Inkscape::Util::cached_map<PangoFontDescription*, FontInstance, Hash, Compare> loaded;
 
+    std::shared_ptr<FontInstance> _face(PangoFontDescription *descr, bool canFail);
+
     // The following two commented out maps were an attempt to allow Inkscape to use font faces
     // that could not be distinguished by CSS values alone. In practice, they never were that
     // useful as PangoFontDescription, which is used throughout our code, cannot distinguish
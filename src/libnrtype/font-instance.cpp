@@ -34,6 +34,7 @@
 
 #include <2geom/pathvector.h>
 #include <2geom/path-sink.h>
+#include "libnrtype/font-factory.h"
 #include "libnrtype/font-glyph.h"
 #include "libnrtype/font-instance.h"
 
@@ -390,8 +391,19 @@ FontGlyph const *FontInstance::LoadGlyph(int glyph_id)
         return nullptr; // bitmap font
     }
 
-    if (auto it = data->glyphs.find(glyph_id); it != data->glyphs.end()) {
-        return it->second.get(); // already loaded
+    auto const find = [&] () -> FontGlyph const * {
+        auto lock = std::shared_lock(data->glyphs_mutex);
+        auto it = data->glyphs.find(glyph_id);
+        return it != data->glyphs.end() ? it->second.get() : nullptr;
+    };
+    if (auto glyph = find()) {
+        return glyph; // already loaded
+    }
+
+    // FreeType faces are not thread-safe. Another thread may have loaded the glyph meanwhile.
+    auto engine_lock = std::lock_guard(FontFactory::get().mutex());
+    if (auto glyph = find()) {
+        return glyph;
     }
 
     Geom::PathBuilder path_builder;
@@ -458,6 +470,7 @@ FontGlyph const *FontInstance::LoadGlyph(int glyph_id)
         }
     }
 
+    auto lock = std::unique_lock(data->glyphs_mutex);
     auto ret = data->glyphs.emplace(glyph_id, std::move(n_g));
 
     return ret.first->second.get();
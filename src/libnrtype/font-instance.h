@@ -13,6 +13,7 @@
 #include <map>
 #include <vector>
 #include <optional>
+#include <shared_mutex>
 #include <unordered_map>
 
 #include <2geom/pathvector.h>
@@ -57,6 +58,7 @@ public:
 
     // Loads the given glyph's info. Glyphs are lazy-loaded, but never unloaded or modified
     // as long as the FontInstance still exists. Pointers to FontGlyphs also remain valid.
+    // Thread-safe, so that text can be laid out in parallel.
     FontGlyph const *LoadGlyph(int glyph_id);
 
     // nota: all coordinates returned by these functions are on a [0..1] scale; you need to multiply
@@ -165,6 +167,7 @@ private:
 
         // Lookup table mapping pango glyph ids to glyphs.
         std::unordered_map<int, std::unique_ptr<FontGlyph const>> glyphs;
+        std::shared_mutex glyphs_mutex;
     };
 
     std::shared_ptr<Data> data;
@@ -0,0 +1,155 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+/** @file
+ * Cache of shaped runs of text, shared by all text layouts.
+ *//*
+ * Copyright (C) 2023 Authors
+ * Released under GNU GPL v2+, read the file 'COPYING' for more information.
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#include "font-factory.h"
+#include "shaping-cache.h"
+#include "util/statics.h"
+
+namespace Inkscape {
+namespace Text {
+
+namespace {
+
+// Runs of paragraphs longer than this are not cached: each would carry the whole paragraph in
+// its key, and long paragraphs are rarely repeated anyway.
+int constexpr max_paragraph_bytes = 4096;
+
+template <typename T>
+void append(std::string &key, T const &value)
+{
+    key.append(reinterpret_cast<char const *>(&value), sizeof(value));
+}
+
+/**
+ * Make the key of a run, or return false if its shaping depends on something the key does not
+ * capture.
+ */
+bool make_key(std::string &key, char const *text, int length, char const *paragraph_text, int paragraph_length,
+              PangoAnalysis const *analysis)
+{
+    if (!analysis->font) {
+        return false;
+    }
+    if (length < 0) {
+        length = std::strlen(text);
+    }
+    if (paragraph_length < 0) {
+        paragraph_length = std::strlen(paragraph_text);
+    }
+    if (paragraph_length > max_paragraph_bytes || text < paragraph_text ||
+        text + length > paragraph_text + paragraph_length) {
+        return false;
+    }
+
+    key.reserve(64 + paragraph_length);
+    append(key, analysis->font); // Kept alive by the entry, so it cannot be reused for another font.
+    append(key, analysis->level);
+    append(key, analysis->gravity);
+    append(key, analysis->flags);
+    append(key, analysis->script);
+    append(key, analysis->language); // Interned by Pango.
+    append(key, static_cast<int>(text - paragraph_text));
+    append(key, length);
+
+    // Layout::Calculator only adds font features to what pango_itemize() passes on here.
+    for (auto l = analysis->extra_attrs; l; l = l->next) {
+        auto const attr = static_cast<PangoAttribute const *>(l->data);
+        if (attr->klass->type != PANGO_ATTR_FONT_FEATURES) {
+            return false;
+        }
+        append(key, attr->start_index);
+        append(key, attr->end_index);
+        key += reinterpret_cast<PangoAttrFontFeatures const *>(attr)->features;
+        key += '\0';
+    }
+
+    key.append(paragraph_text, paragraph_length);
+    return true;
+}
+
+void copy_glyphs(PangoGlyphString *dest, PangoGlyphString const *src)
+{
+    pango_glyph_string_set_size(dest, src->num_glyphs);
+    std::copy_n(src->glyphs, src->num_glyphs, dest->glyphs);
+    std::copy_n(src->log_clusters, src->num_glyphs, dest->log_clusters);
+}
+
+} // namespace
+
+ShapingCache &ShapingCache::get()
+{
+    // Like FontFactory, a Static so that the fonts are released before main() exits.
+    static auto cache = Inkscape::Util::Static<ShapingCache>();
+    return cache.get();
+}
+
+ShapingCache::ShapingCache(std::size_t budget)
+    : _runs(budget)
+{
+}
+
+void ShapingCache::shape(char const *text, int length, char const *paragraph_text, int paragraph_length,
+                         PangoAnalysis const *analysis, PangoGlyphString *glyphs)
+{
+    std::string key;
+    if (!make_key(key, text, length, paragraph_text, paragraph_length, analysis)) {
+        {
+            auto engine_lock = std::lock_guard(FontFactory::get().mutex());
+            pango_shape_full(text, length, paragraph_text, paragraph_length, analysis, glyphs);
+        }
+        _runs.countMiss();
+        return;
+    }
+
+    if (_runs.visit(key, [&] (Run const &run) { copy_glyphs(glyphs, run.glyphs.get()); })) {
+        return;
+    }
+
+    // Shape outside the lock of the cache; another thread shaping the same run meanwhile is
+    // harmless. The lock of the font map is taken first, also for releasing fonts on eviction.
+    auto engine_lock = std::lock_guard(FontFactory::get().mutex());
+    pango_shape_full(text, length, paragraph_text, paragraph_length, analysis, glyphs);
+
+    auto const size = sizeof(Run) + key.size() + glyphs->num_glyphs * (sizeof(PangoGlyphInfo) + sizeof(gint));
+    if (size > _runs.budget()) {
+        return;
+    }
+    auto run = Run{std::unique_ptr<PangoFont, FontUnref>(PANGO_FONT(g_object_ref(analysis->font))),
+                   std::unique_ptr<PangoGlyphString, GlyphStringFree>(pango_glyph_string_copy(glyphs))};
+    _runs.insert(std::move(key), std::move(run), size);
+}
+
+void ShapingCache::setBudget(std::size_t bytes)
+{
+    // Discarded runs release their fonts, which needs the lock of the font map.
+    auto engine_lock = std::lock_guard(FontFactory::get().mutex());
+    _runs.setBudget(bytes);
+}
+
+void ShapingCache::clear()
+{
+    auto engine_lock = std::lock_guard(FontFactory::get().mutex());
+    _runs.clear();
+}
+
+} // namespace Text
+} // namespace Inkscape
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
@@ -0,0 +1,97 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+/** @file
+ * Cache of shaped runs of text, shared by all text layouts.
+ *//*
+ * Copyright (C) 2023 Authors
+ * Released under GNU GPL v2+, read the file 'COPYING' for more information.
+ */
+
+#ifndef INKSCAPE_LIBNRTYPE_SHAPING_CACHE_H
+#define INKSCAPE_LIBNRTYPE_SHAPING_CACHE_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <pango/pango.h>
+
+#include "util/lru-cache.h"
+
+namespace Inkscape {
+namespace Text {
+
+/**
+ * A ShapingCache keeps the glyphs pango_shape_full() makes of runs of text, so that text which
+ * is laid out again, or repeated in many text objects such as labels or table cells, is not
+ * shaped again every time.
+ *
+ * Runs are keyed by their text and that of their paragraph, which gives the shaper its context,
+ * the font, which includes the size, the font features, and the rest of the Pango analysis:
+ * bidi level, script, language and gravity. The least recently used runs are discarded when the
+ * total size exceeds the budget.
+ */
+class ShapingCache
+{
+    struct FontUnref
+    {
+        void operator()(PangoFont *font) const { g_object_unref(font); }
+    };
+
+    struct GlyphStringFree
+    {
+        void operator()(PangoGlyphString *glyphs) const { pango_glyph_string_free(glyphs); }
+    };
+
+    struct Run
+    {
+        std::unique_ptr<PangoFont, FontUnref> font; ///< Keeps the font in the key alive.
+        std::unique_ptr<PangoGlyphString, GlyphStringFree> glyphs;
+    };
+
+    using Runs = Util::LRUCache<std::string, Run>;
+
+public:
+    /// The cache used for the layout of all text.
+    static ShapingCache &get();
+
+    static std::size_t constexpr default_budget = Runs::default_budget;
+
+    explicit ShapingCache(std::size_t budget = default_budget);
+    ShapingCache(ShapingCache const &) = delete;
+    ShapingCache &operator=(ShapingCache const &) = delete;
+
+    /**
+     * Shape a run of text into glyphs, like pango_shape_full() with the same arguments, reusing
+     * the result of an earlier call if possible.
+     */
+    void shape(char const *text, int length, char const *paragraph_text, int paragraph_length,
+               PangoAnalysis const *analysis, PangoGlyphString *glyphs);
+
+    /// Hits are runs copied from the cache, misses are runs shaped, including those which cannot
+    /// be cached.
+    using Statistics = Runs::Statistics;
+    Statistics statistics() const { return _runs.statistics(); }
+    void resetStatistics() { _runs.resetStatistics(); }
+
+    void setBudget(std::size_t bytes);
+    std::size_t size() const { return _runs.size(); }
+    void clear();
+
+private:
+    Runs _runs;
+};
+
+} // namespace Text
+} // namespace Inkscape
+
+#endif // INKSCAPE_LIBNRTYPE_SHAPING_CACHE_H
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
@@ -50,6 +50,8 @@ void Path::Reset()
     
     descr_cmd.clear();
     descr_flags = 0;
+    outline_turn_inside = true;
+    outline_prev_pos = Geom::Point(0, 0);
 }
 
 void Path::Copy(Path * who)
@@ -130,6 +130,11 @@ private:
   bool back = false; /*!< If true, indicates that the polyline approximation is going to have backdata.
                           No need to set this manually though. When Path::Convert or any of its variants is called, it's set automatically. */
 
+  // While this path receives an outline, whether OutlineJoin() takes the next half turn at the
+  // same node as an inside join, and the node of the previous join. Reset() resets them.
+  bool outline_turn_inside = true;
+  Geom::Point outline_prev_pos;
+
 public:
   ~Path();
 
@@ -236,8 +241,11 @@ public:
    *
    * @param threshhold The error threshold used to approximate curves by line segments. The smaller
    * this is, the more line segments there will be.
+   * @param adaptive Approximate cubic Bezier curves with AdaptiveCubicTo(), which needs fewer points
+   * for the same error bound. The points differ from those of earlier versions though, so this is
+   * meant for interactive tools rather than for results that are saved with the document.
    */
-  void Convert (double treshhold);
+  void Convert (double treshhold, bool adaptive = false);
 
   /**
    * Creates a polyline approximation of the path. Line segments are split into further smaller line segments
@@ -261,8 +269,9 @@ public:
    *
    * @param threshhold The error threshold used to approximate the path. The smaller this is, the
    * more line segments there will be and the better the polyline approximation would be.
+   * @param adaptive Approximate cubic Bezier curves with AdaptiveCubicTo(), see Convert().
    */
-  void ConvertWithBackData (double treshhold);
+  void ConvertWithBackData (double treshhold, bool adaptive = false);
 
   // creation of the polyline (you can tinker with these function if you want)
 
@@ -614,6 +623,22 @@ public:
   void RecCubicTo ( Geom::Point const &iS,  Geom::Point const &iSd,  Geom::Point const &iE,  Geom::Point const &iEd, double tresh, int lev,
 		   double st, double et, int piece);
 
+  /**
+   * Approximate the passed cubic bezier with line segments, like RecCubicTo, but with fewer
+   * points for the same error bound.
+   *
+   * RecCubicTo always halves a curve which is not flat enough, so a curve which needs three
+   * segments gets four, and one which needs five gets eight. Here, a piece of the curve is first
+   * tried as two or three segments of equal parameter length, each of which must pass the same
+   * flatness test as in RecCubicTo, and only halved if that does not work either. The test also
+   * requires the control points to project onto the chord, which RecCubicTo does not check, so
+   * that a segment never cuts off a cusp or a loop.
+   *
+   * The parameters are those of RecCubicTo; points get back data if it is enabled.
+   */
+  void AdaptiveCubicTo ( Geom::Point const &iS,  Geom::Point const &iSd,  Geom::Point const &iE,  Geom::Point const &iEd, double tresh, int lev,
+		   double st, double et, int piece);
+
   static void ArcAngles ( Geom::Point const &iS,  Geom::Point const &iE, double rx,
                          double ry, double angle, bool large, bool wise,
                          double &sang, double &eang);
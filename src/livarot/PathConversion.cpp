@@ -15,6 +15,7 @@
 #include "Path.h"
 #include "Shape.h"
 #include "livarot/path-description.h"
+#include "livarot/polyline-cache.h"
 
 /*
  * path description -> polyline
@@ -22,7 +23,7 @@
  * nathing fancy here: take each command and append an approximation of it to the polyline
  */
 
-void Path::ConvertWithBackData(double treshhold)
+void Path::ConvertWithBackData(double treshhold, bool adaptive)
 {
     // are we doing a sub path? if yes, clear the flags. CloseSubPath just clears the flags
     // it doesn't close a sub path
@@ -40,6 +41,12 @@ void Path::ConvertWithBackData(double treshhold)
         return;
     }
 
+    // paths are often converted again unchanged, for instance the operands of path effects
+    auto key = PolylineCache::key(*this, treshhold, PolylineCache::BACK_DATA | (adaptive ? PolylineCache::ADAPTIVE : 0));
+    if (!key.empty() && PolylineCache::get().load(key, *this)) {
+        return;
+    }
+
     Geom::Point curX; // the last point added
     // the description to process. We start with 1 usually since the first is always a MoveTo that
     // we handle before the loop (see below). In the case that the first is not a moveTo, We set
@@ -120,7 +127,11 @@ void Path::ConvertWithBackData(double treshhold)
                 // a line segment through the start and end points. If no, it'd split the cubic at its
                 // center point and recursively call itself on the left and right side. The center point
                 // gets added in the points list too.
-                RecCubicTo(curX, nData->start, nextX, nData->end, treshhold, 8, 0.0, 1.0, curP);
+                if (adaptive) {
+                    AdaptiveCubicTo(curX, nData->start, nextX, nData->end, treshhold, 8, 0.0, 1.0, curP);
+                } else {
+                    RecCubicTo(curX, nData->start, nextX, nData->end, treshhold, 8, 0.0, 1.0, curP);
+                }
                 // RecCubicTo adds any points inside the cubic and last one is added here
                 AddPoint(nextX, curP, 1.0, false);
                 // et on avance
@@ -141,10 +152,14 @@ void Path::ConvertWithBackData(double treshhold)
         }
         curX = nextX;
     }
+
+    if (!key.empty()) {
+        PolylineCache::get().store(std::move(key), *this);
+    }
 }
 
 
-void Path::Convert(double treshhold)
+void Path::Convert(double treshhold, bool adaptive)
 {
     if ( descr_flags & descr_doing_subpath ) {
         CloseSubpath();
@@ -156,6 +171,11 @@ void Path::Convert(double treshhold)
         return;
     }
 
+    auto key = PolylineCache::key(*this, treshhold, adaptive ? PolylineCache::ADAPTIVE : 0);
+    if (!key.empty() && PolylineCache::get().load(key, *this)) {
+        return;
+    }
+
     Geom::Point curX;
     int curP = 1;
     int lastMoveTo = 0;
@@ -233,7 +253,11 @@ void Path::Convert(double treshhold)
             case descr_cubicto: {
                 PathDescrCubicTo *nData = dynamic_cast<PathDescrCubicTo *>(descr_cmd[curP]);
                 nextX = nData->p;
-                RecCubicTo(curX, nData->start, nextX, nData->end, treshhold, 8);
+                if (adaptive) {
+                    AdaptiveCubicTo(curX, nData->start, nextX, nData->end, treshhold, 8, 0.0, 1.0, curP);
+                } else {
+                    RecCubicTo(curX, nData->start, nextX, nData->end, treshhold, 8);
+                }
                 descr_cmd[curP]->associated = AddPoint(nextX,false);
                 if ( descr_cmd[curP]->associated < 0 ) {
                     if ( curP == 0 ) {
@@ -267,6 +291,10 @@ void Path::Convert(double treshhold)
 
         curX = nextX;
     }
+
+    if (!key.empty()) {
+        PolylineCache::get().store(std::move(key), *this);
+    }
 }
 
 void Path::ConvertEvenLines(double treshhold)
@@ -790,6 +818,87 @@ void Path::RecCubicTo(Geom::Point const &iS, Geom::Point const &isD,
     RecCubicTo(m, md, iE, hieD, tresh, lev - 1, mt, et, piece);
 }
 
+namespace {
+
+/*
+ * The flatness test of RecCubicTo for a cubic given by its end points and derivatives, with the
+ * control points also required to project onto the chord, so that the curve stays within a band
+ * around the chord rather than the line through it.
+ */
+bool is_flat(Geom::Point const &iS, Geom::Point const &isD, Geom::Point const &iE, Geom::Point const &ieD,
+             double tresh)
+{
+    const Geom::Point se = iE - iS;
+    const double dC = Geom::L2(se);
+    if ( dC < 0.01 ) {
+        return dot(isD, isD) < tresh && dot(ieD, ieD) < tresh;
+    }
+    if ( fabs(cross(se, isD)) / dC >= tresh || fabs(cross(se, ieD)) / dC >= tresh ) {
+        return false;
+    }
+    // the derivatives are 3 times the vectors to the control points
+    const double sP = dot(se, isD);
+    const double eP = dot(se, ieD);
+    return sP >= 0 && eP >= 0 && sP <= 3 * dC * dC && eP <= 3 * dC * dC;
+}
+
+/*
+ * The point and derivative of a cubic given by its end points and derivatives at time t, with
+ * the derivative scaled by the length h of the piece it is the end of.
+ */
+void hermite(Geom::Point const &iS, Geom::Point const &isD, Geom::Point const &iE, Geom::Point const &ieD,
+             double t, double h, Geom::Point &p, Geom::Point &d)
+{
+    const double t2 = t * t;
+    const double t3 = t2 * t;
+    p = (2 * t3 - 3 * t2 + 1) * iS + (t3 - 2 * t2 + t) * isD + (3 * t2 - 2 * t3) * iE + (t3 - t2) * ieD;
+    d = h * ((6 * t2 - 6 * t) * iS + (3 * t2 - 4 * t + 1) * isD + (6 * t - 6 * t2) * iE + (3 * t2 - 2 * t) * ieD);
+}
+
+} // namespace
+
+void Path::AdaptiveCubicTo(Geom::Point const &iS, Geom::Point const &isD,
+                           Geom::Point const &iE, Geom::Point const &ieD,
+                           double tresh, int lev, double st, double et, int piece)
+{
+    if ( is_flat(iS, isD, iE, ieD, tresh) ) {
+        return;
+    }
+
+    if ( lev <= 0 ) {
+        return;
+    }
+
+    // the halves, as in RecCubicTo
+    Geom::Point m = 0.5 * (iS + iE) + 0.125 * (isD - ieD);
+    Geom::Point md = 0.75 * (iE - iS) - 0.125 * (isD + ieD);
+    double mt = (st + et) / 2;
+
+    Geom::Point hisD = 0.5 * isD;
+    Geom::Point hieD = 0.5 * ieD;
+
+    if ( is_flat(iS, hisD, m, md, tresh) && is_flat(m, md, iE, hieD, tresh) ) {
+        AddPoint(m, piece, mt);
+        return;
+    }
+
+    // thirds, which saves a point whenever they are flat enough
+    Geom::Point p1, d1, p2, d2;
+    hermite(iS, isD, iE, ieD, 1.0 / 3, 1.0 / 3, p1, d1);
+    hermite(iS, isD, iE, ieD, 2.0 / 3, 1.0 / 3, p2, d2);
+    Geom::Point const tisD = isD / 3;
+    Geom::Point const tieD = ieD / 3;
+    if ( is_flat(iS, tisD, p1, d1, tresh) && is_flat(p1, d1, p2, d2, tresh) && is_flat(p2, d2, iE, tieD, tresh) ) {
+        AddPoint(p1, piece, st + (et - st) / 3);
+        AddPoint(p2, piece, st + 2 * (et - st) / 3);
+        return;
+    }
+
+    AdaptiveCubicTo(iS, hisD, m, md, tresh, lev - 1, st, mt, piece);
+    AddPoint(m, piece, mt);
+    AdaptiveCubicTo(m, md, iE, hieD, tresh, lev - 1, mt, et, piece);
+}
+
 /*
  * put a polyline in a Shape instance, for further fun
  * pathID is the ID you want this Path instance to be associated with, for when you're going to recompose the polyline
@@ -876,11 +876,12 @@ Path::OutlineJoin (Path * dest, Geom::Point pos, Geom::Point stNor, Geom::Point
         ideally work because both should fall together, but it seems that this causes many
         extra nodes (due to rounding errors). Solution: for the 'half turn'-case toggle 
         inside/outside each time the same node is processed 2 consecutive times.
+        The state is kept in the destination, so that outlines computed concurrently into
+        different paths do not interfere.
     */
-    static bool TurnInside = true;
-    static Geom::Point PrevPos(0, 0);
-    TurnInside ^= PrevPos == pos;
-    PrevPos = pos;
+    dest->outline_turn_inside ^= dest->outline_prev_pos == pos;
+    dest->outline_prev_pos = pos;
+    bool const TurnInside = dest->outline_turn_inside;
 
 	const double angSi = cross (stNor, enNor);
 	const double angCo = dot (stNor, enNor);
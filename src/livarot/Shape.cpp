@@ -15,6 +15,7 @@
 #include <glib.h>
 #include "Shape.h"
 #include "livarot/sweep-event-queue.h"
+#include "livarot/sweep-scratch.h"
 #include "livarot/sweep-tree-list.h"
 
 /*
@@ -236,6 +237,8 @@ Shape::Reset (int pointCount, int edgeCount)
 {
   _pts.clear();
   _aretes.clear();
+  _pts.reserve(pointCount);
+  _aretes.reserve(edgeCount);
   
   type = shape_polygon;
   if (pointCount > maxPt)
@@ -1398,7 +1401,8 @@ Shape::SortEdges ()
   _need_edges_sorting = false;
 
   // allocate the edge_list array as it's needed by SortEdgesList
-  edge_list *list = (edge_list *) g_malloc(numberOfEdges() * sizeof (edge_list));
+  SweepScratch scratch;
+  edge_list *list = SweepScratch::allocate<edge_list>(numberOfEdges());
   // for each point
   for (int p = 0; p < numberOfPoints(); p++)
     {
@@ -1475,7 +1479,6 @@ Shape::SortEdges ()
             }
         }
     }
-  g_free(list);
 }
 
 int
@@ -17,6 +17,7 @@
 #include <2geom/affine.h>
 #include "Shape.h"
 #include "livarot/sweep-event-queue.h"
+#include "livarot/sweep-scratch.h"
 #include "livarot/sweep-tree-list.h"
 #include "livarot/sweep-tree.h"
 
@@ -170,8 +171,9 @@ Shape::Reoriente (Shape * a)
 int
 Shape::ConvertToShape (Shape * a, FillRule directed, bool invert)
 {
-  // reset any existing stuff in this shape
-  Reset (0, 0);
+  // reset any existing stuff in this shape, making room for at least as many points and edges
+  // as the source has
+  Reset (a->numberOfPoints(), a->numberOfEdges());
 
   // nothing to do with 0/1 points/edges
   if (a->numberOfPoints() <= 1 || a->numberOfEdges() <= 1) {
@@ -188,12 +190,13 @@ Shape::ConvertToShape (Shape * a, FillRule directed, bool invert)
 
   a->ResetSweep();
 
-  // allocating the sweepline data structures
+  // allocating the sweepline data structures, from memory reused from one sweep to the next
+  SweepScratch scratch;
   if (sTree == nullptr) {
-    sTree = new SweepTreeList(a->numberOfEdges());
+    sTree = new SweepTreeList(a->numberOfEdges(), true);
   }
   if (sEvts == nullptr) {
-    sEvts = new SweepEventQueue(a->numberOfEdges());
+    sEvts = new SweepEventQueue(a->numberOfEdges(), true);
   }
 
   // make room for stuff and set flags
@@ -927,7 +930,7 @@ Shape::Booleen (Shape * a, Shape * b, BooleanOp mod,int cutPathID)
 {
   if (a == b || a == nullptr || b == nullptr)
     return shape_input_err;
-  Reset (0, 0);
+  Reset (a->numberOfPoints() + b->numberOfPoints(), a->numberOfEdges() + b->numberOfEdges());
   if (a->numberOfPoints() <= 1 || a->numberOfEdges() <= 1)
     return 0;
   if (b->numberOfPoints() <= 1 || b->numberOfEdges() <= 1)
@@ -944,11 +947,12 @@ Shape::Booleen (Shape * a, Shape * b, BooleanOp mod,int cutPathID)
   a->ResetSweep ();
   b->ResetSweep ();
 
+  SweepScratch scratch;
   if (sTree == nullptr) {
-      sTree = new SweepTreeList(a->numberOfEdges() + b->numberOfEdges());
+      sTree = new SweepTreeList(a->numberOfEdges() + b->numberOfEdges(), true);
   }
   if (sEvts == nullptr) {
-      sEvts = new SweepEventQueue(a->numberOfEdges() + b->numberOfEdges());
+      sEvts = new SweepEventQueue(a->numberOfEdges() + b->numberOfEdges(), true);
   }
   
   MakePointData (true);
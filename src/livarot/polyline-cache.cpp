@@ -0,0 +1,123 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+/** @file
+ * Cache of the polyline approximations of paths.
+ *//*
+ * Authors: see git history
+ *
+ * Copyright (C) 2023 Authors
+ * Released under GNU GPL v2+, read the file 'COPYING' for more information.
+ */
+
+#include <cstring>
+
+#include "polyline-cache.h"
+#include "livarot/path-description.h"
+
+namespace {
+
+template <typename T>
+void append(std::string &key, T const &value)
+{
+    key.append(reinterpret_cast<char const *>(&value), sizeof(value));
+}
+
+} // namespace
+
+PolylineCache &PolylineCache::get()
+{
+    static PolylineCache cache;
+    return cache;
+}
+
+PolylineCache::PolylineCache(std::size_t budget)
+    : _polylines(budget)
+{
+}
+
+std::string PolylineCache::key(Path const &path, double threshold, unsigned flags)
+{
+    std::string key;
+    key.reserve(16 + path.descr_cmd.size() * (sizeof(int) + 3 * sizeof(Geom::Point)));
+    append(key, flags);
+    append(key, threshold);
+
+    bool curves = false;
+    for (auto const cmd : path.descr_cmd) {
+        int const type = cmd->getType();
+        append(key, type);
+        switch (type) {
+            case descr_moveto:
+                append(key, static_cast<PathDescrMoveTo const *>(cmd)->p);
+                break;
+            case descr_lineto:
+                append(key, static_cast<PathDescrLineTo const *>(cmd)->p);
+                break;
+            case descr_cubicto: {
+                auto const cubic = static_cast<PathDescrCubicTo const *>(cmd);
+                append(key, cubic->p);
+                append(key, cubic->start);
+                append(key, cubic->end);
+                curves = true;
+                break;
+            }
+            case descr_arcto: {
+                auto const arc = static_cast<PathDescrArcTo const *>(cmd);
+                append(key, arc->p);
+                append(key, arc->rx);
+                append(key, arc->ry);
+                append(key, arc->angle);
+                append(key, arc->large);
+                append(key, arc->clockwise);
+                curves = true;
+                break;
+            }
+            default:
+                // Closes and forced points only depend on the points before them.
+                break;
+        }
+    }
+
+    if (!curves) {
+        key.clear();
+    }
+    return key;
+}
+
+bool PolylineCache::load(std::string const &key, Path &path)
+{
+    return _polylines.visit(key, [&] (Polyline const &polyline) {
+        path.pts = polyline.pts;
+        for (std::size_t i = 0; i < polyline.associated.size(); i++) {
+            path.descr_cmd[i]->associated = polyline.associated[i];
+        }
+    });
+}
+
+void PolylineCache::store(std::string key, Path const &path)
+{
+    unsigned flags;
+    std::memcpy(&flags, key.data(), sizeof(flags));
+
+    std::vector<int> associated;
+    if (!(flags & BACK_DATA)) {
+        associated.reserve(path.descr_cmd.size());
+        for (auto const cmd : path.descr_cmd) {
+            associated.push_back(cmd->associated);
+        }
+    }
+
+    auto const size = sizeof(Polyline) + key.size() + path.pts.size() * sizeof(Path::path_lineto) +
+                      associated.size() * sizeof(int);
+    _polylines.insert(std::move(key), {path.pts, std::move(associated)}, size);
+}
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
@@ -0,0 +1,98 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+/** @file
+ * Cache of the polyline approximations of paths.
+ *//*
+ * Authors: see git history
+ *
+ * Copyright (C) 2023 Authors
+ * Released under GNU GPL v2+, read the file 'COPYING' for more information.
+ */
+
+#ifndef INKSCAPE_LIVAROT_POLYLINE_CACHE_H
+#define INKSCAPE_LIVAROT_POLYLINE_CACHE_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "Path.h"
+#include "util/lru-cache.h"
+
+/**
+ * A PolylineCache keeps the polyline approximations Path::Convert() and
+ * Path::ConvertWithBackData() make of paths with curves, so that a path which is converted
+ * again, such as an operand of a boolean or offset path effect while another one is dragged, is
+ * not flattened again every time.
+ *
+ * Polylines are keyed by the geometry of all commands of the path, the threshold and the way of
+ * conversion. The least recently used polylines are discarded when the total size exceeds the
+ * budget.
+ */
+class PolylineCache
+{
+    struct Polyline
+    {
+        std::vector<Path::path_lineto> pts;
+        std::vector<int> associated; ///< Empty for polylines with back data.
+    };
+
+    using Polylines = Inkscape::Util::LRUCache<std::string, Polyline>;
+
+public:
+    /// The cache used by all conversions.
+    static PolylineCache &get();
+
+    static std::size_t constexpr default_budget = Polylines::default_budget;
+
+    enum Flags
+    {
+        BACK_DATA = 1, ///< Converted with back data.
+        ADAPTIVE = 2,  ///< Curves approximated by Path::AdaptiveCubicTo().
+    };
+
+    explicit PolylineCache(std::size_t budget = default_budget);
+    PolylineCache(PolylineCache const &) = delete;
+    PolylineCache &operator=(PolylineCache const &) = delete;
+
+    /**
+     * The key of the polyline of a path, or an empty string if the path has no curves, which
+     * are converted as quickly as they would be copied from the cache.
+     */
+    static std::string key(Path const &path, double threshold, unsigned flags);
+
+    /**
+     * Set the polyline of the path, and for conversions without back data the points associated
+     * with its commands, to those of an earlier conversion with the same key.
+     *
+     * @return Whether the key was found.
+     */
+    bool load(std::string const &key, Path &path);
+
+    /// Keep the polyline of a path just converted under the given key.
+    void store(std::string key, Path const &path);
+
+    /// Hits are polylines copied from the cache, misses are those which were not in it.
+    using Statistics = Polylines::Statistics;
+    Statistics statistics() const { return _polylines.statistics(); }
+    void resetStatistics() { _polylines.resetStatistics(); }
+
+    void setBudget(std::size_t bytes) { _polylines.setBudget(bytes); }
+    std::size_t size() const { return _polylines.size(); }
+    void clear() { _polylines.clear(); }
+
+private:
+    Polylines _polylines;
+};
+
+#endif /* !INKSCAPE_LIVAROT_POLYLINE_CACHE_H */
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
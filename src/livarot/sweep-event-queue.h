@@ -24,7 +24,12 @@ class SweepTree;
 class SweepEventQueue
 {
 public:
-    SweepEventQueue(int s);
+    /**
+     * @param s The maximum number of events.
+     * @param scratch Allocate the events from SweepScratch, which must be in scope for the
+     * lifetime of the queue, rather than from the heap.
+     */
+    SweepEventQueue(int s, bool scratch = false);
     virtual ~SweepEventQueue();
 
     /**
@@ -92,6 +97,7 @@ private:
     int maxEvt;          /*!< Allocated size of the heap. */
     int *inds;           /*!< Indices. */
     SweepEvent *events;  /*!< Sweep events. */
+    bool scratch;        /*!< Whether the arrays are allocated from SweepScratch. */
 };
 
 #endif /* !SEEN_LIVAROT_SWEEP_EVENT_QUEUE_H */
@@ -9,23 +9,31 @@
  */
 #include <glib.h>
 #include "livarot/sweep-event-queue.h"
+#include "livarot/sweep-scratch.h"
 #include "livarot/sweep-tree.h"
 #include "livarot/sweep-event.h"
 #include "livarot/Shape.h"
 
-SweepEventQueue::SweepEventQueue(int s) : nbEvt(0), maxEvt(s)
+SweepEventQueue::SweepEventQueue(int s, bool scratch) : nbEvt(0), maxEvt(s), scratch(scratch)
 {
     /* FIXME: use new[] for this, but this causes problems when delete[]
     ** calls the SweepEvent destructors.
     */
-    events = (SweepEvent *) g_malloc(maxEvt * sizeof(SweepEvent));
-    inds = new int[maxEvt];
+    if (scratch) {
+        events = SweepScratch::allocate<SweepEvent>(maxEvt);
+        inds = SweepScratch::allocate<int>(maxEvt);
+    } else {
+        events = (SweepEvent *) g_malloc(maxEvt * sizeof(SweepEvent));
+        inds = new int[maxEvt];
+    }
 }
 
 SweepEventQueue::~SweepEventQueue()
 {
-    g_free(events);
-    delete []inds;
+    if (!scratch) {
+        g_free(events);
+        delete []inds;
+    }
 }
 
 SweepEvent *SweepEventQueue::add(SweepTree *iLeft, SweepTree *iRight, Geom::Point &px, double itl, double itr)
@@ -0,0 +1,76 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+/** @file
+ * Scratch memory for the sweeps of livarot.
+ *//*
+ * Authors: see git history
+ *
+ * Copyright (C) 2023 Authors
+ * Released under GNU GPL v2+, read the file 'COPYING' for more information.
+ */
+
+#ifndef INKSCAPE_LIVAROT_SWEEP_SCRATCH_H
+#define INKSCAPE_LIVAROT_SWEEP_SCRATCH_H
+
+#include <cassert>
+#include <cstddef>
+
+#include "util/pool.h"
+
+/**
+ * Scope in which temporary arrays of a sweep, such as the nodes of the sweepline tree and the
+ * event queue, are allocated from a pool of the current thread.
+ *
+ * The pool is emptied when the outermost scope of the thread ends. It keeps its largest buffer
+ * for the next sweep, so that repeated conversions and boolean operations stop touching the
+ * heap for these arrays once it has grown to the size they need; a buffer grown beyond
+ * max_retained is released instead, so that a single huge sweep does not pin its memory.
+ */
+class SweepScratch
+{
+public:
+    SweepScratch() { _depth()++; }
+    ~SweepScratch()
+    {
+        if (--_depth() == 0) {
+            if (_used() > max_retained) {
+                _pool() = Inkscape::Util::Pool();
+            } else {
+                _pool().free_all();
+            }
+            _used() = 0;
+        }
+    }
+    SweepScratch(SweepScratch const &) = delete;
+    SweepScratch &operator=(SweepScratch const &) = delete;
+
+    /// Allocate an uninitialised array, valid until the outermost scope of the thread ends.
+    template <typename T>
+    static T *allocate(std::size_t count)
+    {
+        assert(_depth() > 0);
+        auto const size = count * sizeof(T);
+        _used() += size;
+        return reinterpret_cast<T *>(_pool().allocate(size, alignof(T)));
+    }
+
+    /// Bytes in use above which the memory is released when the outermost scope ends.
+    static std::size_t constexpr max_retained = 16 << 20;
+
+private:
+    static Inkscape::Util::Pool &_pool() { thread_local Inkscape::Util::Pool pool; return pool; }
+    static int &_depth() { thread_local int depth = 0; return depth; }
+    static std::size_t &_used() { thread_local std::size_t used = 0; return used; }
+};
+
+#endif /* !INKSCAPE_LIVAROT_SWEEP_SCRATCH_H */
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
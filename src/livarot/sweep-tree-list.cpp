@@ -8,15 +8,17 @@
  * Released under GNU GPL v2+, read the file 'COPYING' for more information.
  */
 #include <glib.h>
+#include "livarot/sweep-scratch.h"
 #include "livarot/sweep-tree.h"
 #include "livarot/sweep-tree-list.h"
 
 
-SweepTreeList::SweepTreeList(int s) :
+SweepTreeList::SweepTreeList(int s, bool scratch) :
     nbTree(0),
     maxTree(s),
-    trees((SweepTree *) g_malloc(s * sizeof(SweepTree))),
-    racine(nullptr)
+    trees(scratch ? SweepScratch::allocate<SweepTree>(s) : (SweepTree *) g_malloc(s * sizeof(SweepTree))),
+    racine(nullptr),
+    scratch(scratch)
 {
     /* FIXME: Use new[] for trees initializer above, but watch out for bad things happening when
      * SweepTree::~SweepTree is called.
@@ -26,7 +28,9 @@ SweepTreeList::SweepTreeList(int s) :
 
 SweepTreeList::~SweepTreeList()
 {
-    g_free(trees);
+    if (!scratch) {
+        g_free(trees);
+    }
     trees = nullptr;
 }
 
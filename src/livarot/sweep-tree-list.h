@@ -36,13 +36,16 @@ public:
     int const maxTree;   /*!< Max number of nodes in the tree. */
     SweepTree *trees;    /*!< The array of nodes. */
     SweepTree *racine;   /*!< Root of the tree. */
+    bool const scratch;  /*!< Whether the nodes are allocated from SweepScratch. */
 
     /**
      * Constructor to create a new SweepTreeList.
      *
      * @param s The number of maximum nodes it should be able to hold.
+     * @param scratch Allocate the nodes from SweepScratch, which must be in scope for the
+     * lifetime of the list, rather than from the heap.
      */
-    SweepTreeList(int s);
+    SweepTreeList(int s, bool scratch = false);
 
     /**
      * The destructor. But didn't have to be virtual.
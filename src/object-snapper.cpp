@@ -17,7 +17,14 @@
 #include <2geom/line.h>
 #include <2geom/path-intersection.h>
 #include <2geom/path-sink.h>
+#include <algorithm>
+#include <iterator>
 #include <memory>
+#include <utility>
+#include <vector>
+#include <boost/geometry/geometries/box.hpp>
+#include <boost/geometry/geometries/point.hpp>
+#include <boost/geometry/index/rtree.hpp>
 
 #include "desktop.h"
 #include "display/curve.h"
@@ -44,11 +51,122 @@
 #include "text-editing.h"
 #include "page-manager.h"
 
+/*
+ * The targets are collected for the first point to snap, and then reused for the other points of
+ * the same snap, e.g. all the nodes of the selection while translating it. A single point is
+ * quicker to snap with a linear scan than by building a tree first, so the trees are only built
+ * when the targets are queried a second time.
+ */
+struct Inkscape::ObjectSnapper::CandidateIndex
+{
+    using Point = boost::geometry::model::point<double, 2, boost::geometry::cs::cartesian>;
+    using Box = boost::geometry::model::box<Point>;
+    using PointValue = std::pair<Point, std::size_t>; ///< Point and position in _points_to_snap_to.
+    using PathValue = std::pair<Box, std::size_t>;    ///< Bounds and position in _paths_to_snap_to.
+
+    boost::geometry::index::rtree<PointValue, boost::geometry::index::quadratic<16>> points;
+    boost::geometry::index::rtree<PathValue, boost::geometry::index::quadratic<16>> paths;
+    std::size_t point_queries = 0;
+    std::size_t path_queries = 0;
+    std::vector<Geom::OptRect> path_bounds; ///< Bounds of each path vector, in document coordinates.
+    std::vector<int> path_numbers;          ///< Number of the first path of each path vector.
+    std::size_t paths_indexed = 0;          ///< Number of path vectors the tree was built from.
+
+    static Box to_box(Geom::Rect const &rect) { return {{rect.left(), rect.top()}, {rect.right(), rect.bottom()}}; }
+
+    void clearPoints()
+    {
+        points.clear();
+        point_queries = 0;
+    }
+
+    void clearPaths()
+    {
+        paths.clear();
+        path_queries = 0;
+        path_bounds.clear();
+        path_numbers.clear();
+        paths_indexed = 0;
+    }
+
+    /// Return the positions of the targets within @a area, in ascending order.
+    std::vector<std::size_t> pointsIn(std::vector<SnapCandidatePoint> const &targets, Geom::Rect const &area)
+    {
+        std::vector<std::size_t> result;
+        if (point_queries++ == 0) {
+            for (std::size_t i = 0; i < targets.size(); i++) {
+                if (area.contains(targets[i].getPoint())) {
+                    result.push_back(i);
+                }
+            }
+            return result;
+        }
+
+        if (points.size() != targets.size()) {
+            std::vector<PointValue> values;
+            values.reserve(targets.size());
+            for (std::size_t i = 0; i < targets.size(); i++) {
+                values.emplace_back(Point(targets[i].getPoint().x(), targets[i].getPoint().y()), i);
+            }
+            // Bulk loading packs the tree much better than inserting one point at a time.
+            points = decltype(points)(values.begin(), values.end());
+        }
+
+        std::vector<PointValue> values;
+        points.query(boost::geometry::index::covered_by(to_box(area)), std::back_inserter(values));
+        for (auto const &value : values) {
+            result.push_back(value.second);
+        }
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+    /// Return the positions of the targets whose bounds intersect @a area, in ascending order.
+    std::vector<std::size_t> pathsIn(std::vector<SnapCandidatePath> const &targets, Geom::Rect const &area)
+    {
+        // Paths may be added after the first query, see _snapPaths().
+        for (auto i = path_bounds.size(); i < targets.size(); i++) {
+            path_numbers.push_back(i == 0 ? 0 : path_numbers.back() + targets[i - 1].path_vector.size());
+            path_bounds.push_back(targets[i].path_vector.boundsFast());
+        }
+
+        std::vector<std::size_t> result;
+        if (path_queries++ == 0) {
+            for (std::size_t i = 0; i < targets.size(); i++) {
+                if (path_bounds[i] && area.intersects(*path_bounds[i])) {
+                    result.push_back(i);
+                }
+            }
+            return result;
+        }
+
+        if (paths_indexed != targets.size()) {
+            std::vector<PathValue> values;
+            for (std::size_t i = 0; i < targets.size(); i++) {
+                if (path_bounds[i]) {
+                    values.emplace_back(to_box(*path_bounds[i]), i);
+                }
+            }
+            paths = decltype(paths)(values.begin(), values.end());
+            paths_indexed = targets.size();
+        }
+
+        std::vector<PathValue> values;
+        paths.query(boost::geometry::index::intersects(to_box(area)), std::back_inserter(values));
+        for (auto const &value : values) {
+            result.push_back(value.second);
+        }
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+};
+
 Inkscape::ObjectSnapper::ObjectSnapper(SnapManager *sm, Geom::Coord const d)
     : Snapper(sm, d)
 {
     _points_to_snap_to = std::make_unique<std::vector<SnapCandidatePoint>>();
     _paths_to_snap_to = std::make_unique<std::vector<SnapCandidatePath>>();
+    _candidate_index = std::make_unique<CandidateIndex>();
 }
 
 Inkscape::ObjectSnapper::~ObjectSnapper()
@@ -77,6 +195,7 @@ void Inkscape::ObjectSnapper::_collectNodes(SnapSourceType const &t,
     // first point and store the collection for later use. This significantly improves the performance
     if (first_point) {
         _points_to_snap_to->clear();
+        _candidate_index->clearPoints();
 
          // Determine the type of bounding box we should snap to
         SPItem::BBoxType bbox_type = SPItem::GEOMETRIC_BBOX;
@@ -215,16 +334,11 @@ void Inkscape::ObjectSnapper::_snapNodes(IntermSnapResults &isr,
 
     _collectNodes(p.getSourceType(), p.getSourceNum() <= 0);
 
-    if (unselected_nodes != nullptr && unselected_nodes->size() > 0) {
-        g_assert(_points_to_snap_to != nullptr);
-        _points_to_snap_to->insert(_points_to_snap_to->end(), unselected_nodes->begin(), unselected_nodes->end());
-    }
-
     SnappedPoint s;
     bool success = false;
     bool strict_snapping = _snapmanager->snapprefs.getStrictSnapping();
 
-    for (const auto & k : *_points_to_snap_to) {
+    auto const snap_to = [&] (SnapCandidatePoint const &k) {
         if (_allowSourceToSnapToTarget(p.getSourceType(), k.getTargetType(), strict_snapping)) {
             Geom::Point target_pt = k.getPoint();
             Geom::Coord dist = Geom::L2(target_pt - p.getPoint()); // Default: free (unconstrained) snapping
@@ -234,7 +348,7 @@ void Inkscape::ObjectSnapper::_snapNodes(IntermSnapResults &isr,
                 if (Geom::L2(target_pt - c.projection(target_pt)) > 1e-9) {
                     // The distance from the target point to its projection on the constraint
                     // is too large, so this point is not on the constraint. Skip it!
-                    continue;
+                    return;
                 }
                 dist = Geom::L2(target_pt - p_proj_on_constraint);
             }
@@ -244,6 +358,21 @@ void Inkscape::ObjectSnapper::_snapNodes(IntermSnapResults &isr,
                 success = true;
             }
         }
+    };
+
+    // Only the nodes within the snapping tolerance of the (projected) point are of interest
+    Geom::Point const origin = c.isUndefined() ? p.getPoint() : p_proj_on_constraint;
+    Geom::Point const tolerance(getSnapperTolerance(), getSnapperTolerance());
+    for (auto i : _candidate_index->pointsIn(*_points_to_snap_to, Geom::Rect(origin - tolerance, origin + tolerance))) {
+        snap_to((*_points_to_snap_to)[i]);
+    }
+
+    // The unselected nodes of the path that is being edited in the node tool are not collected
+    // above, but passed in separately
+    if (unselected_nodes != nullptr) {
+        for (auto const &k : *unselected_nodes) {
+            snap_to(k);
+        }
     }
 
     if (success) {
@@ -431,17 +560,21 @@ void Inkscape::ObjectSnapper::_snapPaths(IntermSnapResults &isr,
         }
     }
 
-    int num_path = 0; // _paths_to_snap_to contains multiple path_vectors, each containing multiple paths.
-                      // num_path will count the paths, and will not be zeroed for each path_vector. It will
-                      // continue counting
-
     bool strict_snapping = _snapmanager->snapprefs.getStrictSnapping();
     bool snap_perp = _snapmanager->snapprefs.isTargetSnappable(Inkscape::SNAPTARGET_PATH_PERPENDICULAR);
     bool snap_tang = _snapmanager->snapprefs.isTargetSnappable(Inkscape::SNAPTARGET_PATH_TANGENTIAL);
 
+    // Only the paths whose bounds are within the snapping tolerance of the point are of interest
+    Geom::Point const tolerance(getSnapperTolerance(), getSnapperTolerance());
+    auto const candidates = _candidate_index->pathsIn(*_paths_to_snap_to, Geom::Rect(p_doc - tolerance, p_doc + tolerance));
+
     //dt->snapindicator->remove_debugging_points();
-    for (const auto & it_p : *_paths_to_snap_to) {
+    for (auto i : candidates) {
+        auto const &it_p = (*_paths_to_snap_to)[i];
         if (_allowSourceToSnapToTarget(p.getSourceType(), it_p.target_type, strict_snapping)) {
+            int num_path = _candidate_index->path_numbers[i]; // _paths_to_snap_to contains multiple path_vectors, each containing
+                                                              // multiple paths. num_path counts the paths, and is not zeroed for
+                                                              // each path_vector, so it identifies each path uniquely
             bool const being_edited = node_tool_active && it_p.currently_being_edited;
             //if true then this pathvector it_pv is currently being edited in the node tool
 
@@ -590,8 +723,11 @@ void Inkscape::ObjectSnapper::_snapPathsConstrained(IntermSnapResults &isr,
 
     bool strict_snapping = _snapmanager->snapprefs.getStrictSnapping();
 
-    // Find all intersections of the constrained path with the snap target candidates
-    for (const auto & k : *_paths_to_snap_to) {
+    // Find all intersections of the constrained path with the snap target candidates, which can only
+    // be the paths whose bounds intersect those of the constrained path
+    auto const candidates = _candidate_index->pathsIn(*_paths_to_snap_to, *constraint_path.boundsFast());
+    for (auto i : candidates) {
+        auto const &k = (*_paths_to_snap_to)[i];
         if (_allowSourceToSnapToTarget(p.getSourceType(), k.target_type, strict_snapping)) {
             // Do the intersection math
             std::vector<Geom::PVIntersection> inters = constraint_path.intersect(k.path_vector);
@@ -734,6 +870,7 @@ bool Inkscape::ObjectSnapper::ThisSnapperMightSnap() const
 void Inkscape::ObjectSnapper::_clear_paths() const
 {
     _paths_to_snap_to->clear();
+    _candidate_index->clearPaths();
 }
 
 Geom::PathVector Inkscape::ObjectSnapper::_getPathvFromRect(Geom::Rect const rect) const
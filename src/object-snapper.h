@@ -63,6 +63,11 @@ private:
     std::unique_ptr<std::vector<SnapCandidatePoint>> _points_to_snap_to;
     std::unique_ptr<std::vector<SnapCandidatePath >> _paths_to_snap_to;
 
+    /// Spatial index of the two collections above, so that snapping a point only looks at the
+    /// targets within the snapping tolerance instead of at every target in the document.
+    struct CandidateIndex;
+    std::unique_ptr<CandidateIndex> _candidate_index;
+
     void _snapNodes(IntermSnapResults &isr,
                       Inkscape::SnapCandidatePoint const &p, // in desktop coordinates
                       std::vector<SnapCandidatePoint> *unselected_nodes,
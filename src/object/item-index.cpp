@@ -0,0 +1,141 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+/** @file
+ * Spatial index of the items of a document.
+ */
+/*
+ * Copyright (C) 2023 Authors
+ *
+ * Released under GNU GPL v2+, read the file 'COPYING' for more information.
+ */
+
+#include <iterator>
+#include <2geom/rect.h>
+
+#include "item-index.h"
+#include "sp-item-group.h"
+
+namespace Inkscape {
+
+namespace {
+
+template <typename Box>
+Box to_box(Geom::Rect const &rect)
+{
+    return {{rect.left(), rect.top()}, {rect.right(), rect.bottom()}};
+}
+
+} // namespace
+
+ItemIndex::ItemIndex() = default;
+ItemIndex::~ItemIndex() = default;
+
+void ItemIndex::invalidate(SPItem *item)
+{
+    // Until the first query, the index is built from scratch anyway. Items which are not in a
+    // group, such as those in <defs>, clipping paths or clones, are never returned by queries.
+    if (!_built || item->cloned || !is<SPGroup>(item->parent)) {
+        return;
+    }
+
+    if (!_entries.contains(item)) {
+        _entries.insert(item, Entry());
+    }
+    auto entry = _entries.find(item);
+    if (!entry->dirty) {
+        entry->dirty = true;
+        _dirty.push_back(item);
+    }
+}
+
+void ItemIndex::remove(SPItem *item)
+{
+    if (auto entry = _entries.find(item)) {
+        if (entry->indexed) {
+            _tree.remove(Value(entry->box, item));
+        }
+        // The item may remain in _dirty; _flush() skips items without an entry.
+        _entries.erase(item);
+    }
+}
+
+std::vector<SPItem *> ItemIndex::intersecting(SPGroup *root, Geom::Rect const &area)
+{
+    if (!_built) {
+        _build(root);
+    } else {
+        _flush();
+    }
+
+    std::vector<Value> values;
+    _tree.query(boost::geometry::index::intersects(to_box<Box>(area)), std::back_inserter(values));
+
+    std::vector<SPItem *> result;
+    result.reserve(values.size());
+    for (auto const &value : values) {
+        result.push_back(value.second);
+    }
+    return result;
+}
+
+void ItemIndex::_build(SPGroup *root)
+{
+    std::vector<Value> values;
+
+    auto visit = [&] (SPGroup *group, auto const &visit) -> void {
+        for (auto &child : group->children) {
+            auto item = cast<SPItem>(&child);
+            if (!item) {
+                continue;
+            }
+            auto entry = Entry();
+            if (auto box = item->documentVisualBounds()) {
+                entry.box = to_box<Box>(*box);
+                entry.indexed = true;
+                values.emplace_back(entry.box, item);
+            }
+            _entries.insert(item, entry);
+            if (auto childgroup = cast<SPGroup>(item)) {
+                visit(childgroup, visit);
+            }
+        }
+    };
+    visit(root, visit);
+
+    // Bulk loading packs the tree much better than inserting one item at a time.
+    _tree = decltype(_tree)(values.begin(), values.end());
+    _built = true;
+}
+
+void ItemIndex::_flush()
+{
+    for (auto item : _dirty) {
+        auto entry = _entries.find(item);
+        if (!entry || !entry->dirty) {
+            continue;
+        }
+        entry->dirty = false;
+        if (entry->indexed) {
+            _tree.remove(Value(entry->box, item));
+            entry->indexed = false;
+        }
+        if (auto box = item->documentVisualBounds()) {
+            entry->box = to_box<Box>(*box);
+            entry->indexed = true;
+            _tree.insert(Value(entry->box, item));
+        }
+    }
+    _dirty.clear();
+}
+
+} // namespace Inkscape
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
@@ -0,0 +1,92 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+/** @file
+ * Spatial index of the items of a document.
+ */
+/*
+ * Copyright (C) 2023 Authors
+ *
+ * Released under GNU GPL v2+, read the file 'COPYING' for more information.
+ */
+#ifndef INKSCAPE_OBJECT_ITEM_INDEX_H
+#define INKSCAPE_OBJECT_ITEM_INDEX_H
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include <boost/geometry/geometries/box.hpp>
+#include <boost/geometry/geometries/point.hpp>
+#include <boost/geometry/index/rtree.hpp>
+#include <2geom/forward.h>
+
+#include "util/flat_hash_map.h"
+
+class SPGroup;
+class SPItem;
+
+namespace Inkscape {
+
+/**
+ * An ItemIndex is an R-tree of the visual bounds, in document coordinates, of the items that are
+ * children of groups, so that SPDocument can answer area queries without visiting every item.
+ *
+ * The index is built on first use. After that, SPItem::update() reports each item whose bounds
+ * may have changed, and those items are re-indexed on the next query.
+ */
+class ItemIndex
+{
+public:
+    ItemIndex();
+    ~ItemIndex();
+    ItemIndex(ItemIndex const &) = delete;
+    ItemIndex &operator=(ItemIndex const &) = delete;
+
+    /// Note that the bounds of an item may have changed.
+    void invalidate(SPItem *item);
+
+    /// Forget an item that is being released.
+    void remove(SPItem *item);
+
+    /**
+     * Return the items below @a root whose visual bounds intersect @a area, in no particular
+     * order. The caller is responsible for any further tests, e.g. of visibility.
+     */
+    std::vector<SPItem *> intersecting(SPGroup *root, Geom::Rect const &area);
+
+    /// The number of indexed items.
+    std::size_t size() const { return _tree.size(); }
+
+private:
+    using Point = boost::geometry::model::point<double, 2, boost::geometry::cs::cartesian>;
+    using Box = boost::geometry::model::box<Point>;
+    using Value = std::pair<Box, SPItem *>;
+
+    struct Entry
+    {
+        Box box;
+        bool indexed = false; ///< Whether box is in the tree.
+        bool dirty = false;   ///< Whether the item is in _dirty.
+    };
+
+    boost::geometry::index::rtree<Value, boost::geometry::index::quadratic<16>> _tree;
+    Util::flat_hash_map<SPItem *, Entry> _entries;
+    std::vector<SPItem *> _dirty;
+    bool _built = false;
+
+    void _build(SPGroup *root);
+    void _flush();
+};
+
+} // namespace Inkscape
+
+#endif // INKSCAPE_OBJECT_ITEM_INDEX_H
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
@@ -0,0 +1,254 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+/** @file
+ * Index of the rulesets of the style cascade of a document.
+ */
+/*
+ * Copyright (C) 2023 Authors
+ *
+ * Released under GNU GPL v2+, read the file 'COPYING' for more information.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <string_view>
+
+#include "3rdparty/libcroco/src/cr-statement.h"
+
+#include "selector-index.h"
+#include "xml/node.h"
+
+namespace Inkscape {
+
+namespace {
+
+char const *str(CRString const *string)
+{
+    return string && string->stryng ? string->stryng->str : nullptr;
+}
+
+/// The element name libcroco matches type selectors against, see croco-node-iface.cpp.
+char const *local_name(XML::Node const *node)
+{
+    auto const name = node->name();
+    auto const colon = std::strrchr(name, ':');
+    return colon ? colon + 1 : name;
+}
+
+/**
+ * Add the declarations of a matching ruleset to a property list, replacing those of earlier
+ * rulesets by the rules of the cascade. This is put_css_properties_in_props_list() of libcroco's
+ * selector engine, which it does not export.
+ */
+void put_properties(CRPropList *&props, CRStatement *statement)
+{
+    for (auto decl = statement->kind.ruleset->decl_list; decl; decl = decl->next) {
+        if (!str(decl->property)) {
+            continue;
+        }
+
+        CRPropList *pair = nullptr;
+        cr_prop_list_lookup_prop(props, decl->property, &pair);
+        if (!pair) {
+            props = cr_prop_list_append2(props, decl->property, decl);
+            continue;
+        }
+
+        CRDeclaration *existing = nullptr;
+        cr_prop_list_get_decl(pair, &existing);
+        if (!existing) {
+            continue;
+        }
+
+        // Author style sheets override user style sheets, which override the user agent's.
+        auto const existing_sheet = existing->parent_statement ? existing->parent_statement->parent_sheet : nullptr;
+        if (existing_sheet && existing_sheet->origin < statement->parent_sheet->origin) {
+            if (existing->important && existing_sheet->origin != ORIGIN_UA) {
+                continue;
+            }
+            props = cr_prop_list_unlink(props, pair);
+            cr_prop_list_destroy(pair);
+            props = cr_prop_list_append2(props, decl->property, decl);
+            continue;
+        } else if (existing_sheet && existing_sheet->origin > statement->parent_sheet->origin) {
+            continue;
+        }
+
+        // Of the same origin, more specific selectors win, and of equally specific ones the later.
+        if (statement->specificity >= existing->parent_statement->specificity) {
+            if (existing->important) {
+                continue;
+            }
+            props = cr_prop_list_unlink(props, pair);
+            cr_prop_list_destroy(pair);
+            props = cr_prop_list_append2(props, decl->property, decl);
+        }
+    }
+}
+
+} // namespace
+
+SelectorIndex::SelectorIndex() = default;
+SelectorIndex::~SelectorIndex() = default;
+
+void SelectorIndex::invalidate()
+{
+    _rulesets.clear();
+    _ids.clear();
+    _classes.clear();
+    _names.clear();
+    _universal.clear();
+    _cascade = nullptr;
+    _built = false;
+    _usable = false;
+}
+
+CRStatus SelectorIndex::matchedProperties(CRSelEng *sel_eng, CRCascade *cascade, XML::Node *node, CRPropList **props)
+{
+    if (!_built || cascade != _cascade) {
+        invalidate();
+        _build(cascade);
+    }
+
+    // Text nodes are rare enough to leave to the selector engine.
+    if (!_usable || node->type() != XML::NodeType::ELEMENT_NODE) {
+        return cr_sel_eng_get_matched_properties_from_cascade(sel_eng, cascade, node, props);
+    }
+
+    // The rulesets that can match, in the order of the cascade.
+    std::vector<unsigned> candidates = _universal;
+    auto const add = [&] (Buckets const &buckets, std::string_view key) {
+        if (auto bucket = buckets.find(key)) {
+            candidates.insert(candidates.end(), bucket->begin(), bucket->end());
+        }
+    };
+    add(_names, local_name(node));
+    if (auto id = node->attribute("id")) {
+        add(_ids, id);
+    }
+    if (auto classes = node->attribute("class")) {
+        auto const whitespace = " \t\n\r\f";
+        auto const value = std::string_view(classes);
+        for (auto start = value.find_first_not_of(whitespace); start != std::string_view::npos;) {
+            auto const end = std::min(value.find_first_of(whitespace, start), value.size());
+            add(_classes, value.substr(start, end - start));
+            start = value.find_first_not_of(whitespace, end);
+        }
+    }
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+    _tried += candidates.size();
+
+    // As the selector engine does, a ruleset is added once for each of its selectors that
+    // matches, and takes on the specificity of the last of them.
+    std::vector<CRStatement *> matched;
+    for (auto i : candidates) {
+        auto const statement = _rulesets[i];
+        for (auto sel = statement->kind.ruleset->sel_list; sel; sel = sel->next) {
+            if (!sel->simple_sel) {
+                continue;
+            }
+            gboolean matches = false;
+            if (cr_sel_eng_matches_node(sel_eng, sel->simple_sel, node, &matches) == CR_OK && matches) {
+                matched.push_back(statement);
+                cr_simple_sel_compute_specificity(sel->simple_sel);
+                statement->specificity = sel->simple_sel->specificity;
+            }
+        }
+    }
+
+    for (auto statement : matched) {
+        if (statement->parent_sheet) {
+            put_properties(*props, statement);
+        }
+    }
+    return CR_OK;
+}
+
+void SelectorIndex::_build(CRCascade *cascade)
+{
+    _cascade = cascade;
+    _built = true;
+    _usable = true;
+
+    for (int origin = ORIGIN_UA; origin < NB_ORIGINS; origin++) {
+        for (auto sheet = cr_cascade_get_sheet(cascade, static_cast<CRStyleOrigin>(origin)); sheet; sheet = sheet->next) {
+            for (auto statement = sheet->statements; statement; statement = statement->next) {
+                switch (statement->type) {
+                    case RULESET_STMT:
+                        if (statement->kind.ruleset) {
+                            auto const ruleset = static_cast<unsigned>(_rulesets.size());
+                            _rulesets.push_back(statement);
+                            for (auto sel = statement->kind.ruleset->sel_list; sel; sel = sel->next) {
+                                if (sel->simple_sel) {
+                                    _add(ruleset, sel->simple_sel);
+                                }
+                            }
+                        }
+                        break;
+                    case AT_FONT_FACE_RULE_STMT:
+                    case AT_CHARSET_RULE_STMT:
+                    case AT_PAGE_RULE_STMT:
+                        // Never matched against nodes.
+                        break;
+                    default:
+                        // Such as @media and @import, which the selector engine has its own rules
+                        // for.
+                        _usable = false;
+                        break;
+                }
+            }
+        }
+    }
+}
+
+void SelectorIndex::_add(unsigned ruleset, CRSimpleSel *simple_sel)
+{
+    // The compound selector that must match the node itself is the last one.
+    while (simple_sel->next) {
+        simple_sel = simple_sel->next;
+    }
+
+    auto const add = [&] (std::vector<unsigned> &bucket) {
+        if (bucket.empty() || bucket.back() != ruleset) {
+            bucket.push_back(ruleset);
+        }
+    };
+    auto const add_to = [&] (Buckets &buckets, char const *key) {
+        if (!buckets.contains(std::string_view(key))) {
+            buckets.insert(std::string(key), {});
+        }
+        add(*buckets.find(std::string_view(key)));
+    };
+
+    // The most selective of what it requires.
+    for (auto add_sel = simple_sel->add_sel; add_sel; add_sel = add_sel->next) {
+        if (add_sel->type == ID_ADD_SELECTOR && str(add_sel->content.id_name)) {
+            add_to(_ids, str(add_sel->content.id_name));
+            return;
+        }
+    }
+    for (auto add_sel = simple_sel->add_sel; add_sel; add_sel = add_sel->next) {
+        if (add_sel->type == CLASS_ADD_SELECTOR && str(add_sel->content.class_name)) {
+            add_to(_classes, str(add_sel->content.class_name));
+            return;
+        }
+    }
+    if ((simple_sel->type_mask & TYPE_SELECTOR) && str(simple_sel->name)) {
+        add_to(_names, str(simple_sel->name));
+        return;
+    }
+    add(_universal);
+}
+
+} // namespace Inkscape
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
@@ -0,0 +1,90 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+/** @file
+ * Index of the rulesets of the style cascade of a document.
+ */
+/*
+ * Copyright (C) 2023 Authors
+ *
+ * Released under GNU GPL v2+, read the file 'COPYING' for more information.
+ */
+#ifndef INKSCAPE_OBJECT_SELECTOR_INDEX_H
+#define INKSCAPE_OBJECT_SELECTOR_INDEX_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "3rdparty/libcroco/src/cr-cascade.h"
+#include "3rdparty/libcroco/src/cr-prop-list.h"
+#include "3rdparty/libcroco/src/cr-sel-eng.h"
+
+#include "util/flat_hash_map.h"
+
+namespace Inkscape {
+
+namespace XML {
+class Node;
+}
+
+/**
+ * A SelectorIndex buckets the rulesets of a style cascade by the id, class or element name that
+ * the rightmost compound selector of each of their selectors requires, as browsers do, so that
+ * only the rulesets that can match an element are tried against it.
+ *
+ * The index is built on first use. SPStyleElem invalidates it whenever it changes the cascade.
+ */
+class SelectorIndex
+{
+public:
+    SelectorIndex();
+    ~SelectorIndex();
+    SelectorIndex(SelectorIndex const &) = delete;
+    SelectorIndex &operator=(SelectorIndex const &) = delete;
+
+    /// Note that the style sheets of the cascade have changed.
+    void invalidate();
+
+    /**
+     * Find the properties that the rulesets of the cascade give to a node, in the same way, and
+     * with the same result, as cr_sel_eng_get_matched_properties_from_cascade(). The caller
+     * owns the returned list, which may be null.
+     */
+    CRStatus matchedProperties(CRSelEng *sel_eng, CRCascade *cascade, XML::Node *node, CRPropList **props);
+
+    /// The number of indexed rulesets.
+    std::size_t size() const { return _rulesets.size(); }
+
+    /// The number of rulesets tried against nodes so far, for testing.
+    std::size_t triedCount() const { return _tried; }
+
+private:
+    using Buckets = Util::flat_hash_map<std::string, std::vector<unsigned>, Util::string_hash, std::equal_to<>>;
+
+    std::vector<CRStatement *> _rulesets; ///< In the order the cascade applies them.
+    Buckets _ids;
+    Buckets _classes;
+    Buckets _names;
+    std::vector<unsigned> _universal;
+    CRCascade *_cascade = nullptr;
+    bool _built = false;
+    bool _usable = false; ///< False if the cascade has statements the index doesn't handle.
+    std::size_t _tried = 0;
+
+    void _build(CRCascade *cascade);
+    void _add(unsigned ruleset, CRSimpleSel *simple_sel);
+};
+
+} // namespace Inkscape
+
+#endif // INKSCAPE_OBJECT_SELECTOR_INDEX_H
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
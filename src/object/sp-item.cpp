@@ -35,6 +35,7 @@
 #include "conditions.h"
 #include "filter-chemistry.h"
 
+#include "item-index.h"
 #include "sp-clippath.h"
 #include "sp-defs.h"
 #include "sp-desc.h"
@@ -452,6 +453,8 @@ void SPItem::build(SPDocument *document, Inkscape::XML::Node *repr) {
 
 void SPItem::release()
 {
+    document->getItemIndex().remove(this);
+
     // Note: do this here before the clip_ref is deleted, since calling
     // ensureUpToDate() for triggered routing may reference
     // the deleted clip_ref.
@@ -702,9 +705,13 @@ void SPItem::update(SPCtx *ctx, unsigned flags)
 {
     auto ictx = static_cast<SPItemCtx const*>(ctx);
 
+    // Texts among the descendants may still be waiting for their layout, which the bbox needs.
+    document->layoutDeferredTexts(this);
+
     // Any of the modifications defined in sp-object.h might change bbox,
     // so we invalidate it unconditionally
     bbox_valid = false;
+    document->getItemIndex().invalidate(this);
 
     viewport = ictx->viewport; // Cache viewport
 
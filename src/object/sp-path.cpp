@@ -16,6 +16,8 @@
  * Released under GNU GPL v2+, read the file 'COPYING' for more information.
  */
 
+#include <memory>
+
 #include <glibmm/i18n.h>
 #include <glibmm/regex.h>
 
@@ -42,9 +44,31 @@
 #include "ui/tools/tool-base.h"
 #include "inkscape.h"
 #include "style.h"
+#include "util/interner.h"
 
 #define noPATH_VERBOSE
 
+namespace {
+
+/**
+ * The curves of the paths in the private subtrees of clones, by their path data. All clones of a
+ * path, such as the many <use> of a symbol in a map, build their copy of it from the same data;
+ * they share one immutable curve, and so one parse of it, rather than each having its own.
+ *
+ * A curve is forgotten when its last holder, which may be a drawing item, lets go of it. Like the
+ * values of SPIStrings, the curves are shared by all documents and the pool is never destroyed.
+ *
+ * This only saves the geometry. Each clone still has its own objects, styles and drawing items,
+ * and renders the source afresh; how much of a clone's memory that leaves is not measured.
+ */
+std::shared_ptr<SPCurve const> clone_curve(char const *d)
+{
+    static auto const curves = new Inkscape::Util::Interner<std::string, SPCurve>;
+    return curves->intern(d, [d] { return SPCurve(sp_svg_read_pathv(d)); });
+}
+
+} // namespace
+
 gint SPPath::nodesInPath() const
 {
     return _curve ? _curve->nodes_in_path() : 0;
@@ -205,7 +229,9 @@ void SPPath::set(SPAttr key, const gchar* value) {
             break;
 
        case SPAttr::D:
-            if (value) {
+            if (value && cloned) {
+                setCurve(clone_curve(value));
+            } else if (value) {
                 setCurve(SPCurve(sp_svg_read_pathv(value)));
             } else {
                 setCurve(nullptr);
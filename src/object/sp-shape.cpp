@@ -1116,6 +1116,18 @@ void SPShape::setCurve(SPCurve new_curve)
         requestDisplayUpdate(SP_OBJECT_MODIFIED_FLAG);
     }
 }
+
+/**
+ * Sets _curve to a curve that may be shared with other shapes, such as the clones of a path.
+ */
+void SPShape::setCurve(std::shared_ptr<SPCurve const> new_curve)
+{
+    _curve = std::move(new_curve);
+    if (document) {
+        requestDisplayUpdate(SP_OBJECT_MODIFIED_FLAG);
+    }
+}
+
 void SPShape::setCurve(SPCurve const *new_curve)
 {
     if (new_curve) {
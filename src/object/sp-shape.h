@@ -48,6 +48,7 @@ public:
 public:
     void setCurve(SPCurve const *);
     void setCurve(SPCurve);
+    void setCurve(std::shared_ptr<SPCurve const>);
     void setCurveInsync(SPCurve const *);
     void setCurveInsync(SPCurve);
     void setCurveBeforeLPE(SPCurve const *);
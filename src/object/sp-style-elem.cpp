@@ -13,6 +13,7 @@
 
 #include "attributes.h"
 #include "document.h"
+#include "selector-index.h"
 #include "sp-root.h"
 #include "style.h"
 #include "xml/repr.h"
@@ -448,6 +449,7 @@ static void clear_style_sheet(SPStyleElem &self)
     auto *topsheet = cr_cascade_get_sheet(cascade, ORIGIN_AUTHOR);
 
     cr_stylesheet_unlink(self.style_sheet);
+    self.document->getSelectorIndex().invalidate();
 
     if (topsheet == self.style_sheet) {
         // will unref style_sheet
@@ -494,6 +496,7 @@ void SPStyleElem::read_content() {
             // If not the first, then chain up this style_sheet
             cr_stylesheet_append_stylesheet(topsheet, style_sheet);
         }
+        document->getSelectorIndex().invalidate();
     } else {
         cr_stylesheet_destroy (style_sheet);
         style_sheet = nullptr;
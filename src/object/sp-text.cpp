@@ -193,19 +193,27 @@ void SPText::update(SPCtx *ctx, guint flags) {
         /* fixme: It is not nice to have it here, but otherwise children content changes does not work */
         /* fixme: Even now it may not work, as we are delayed */
         /* fixme: So check modification flag everywhere immediate state is used */
-        this->rebuildLayout();
+        // During a document update, the layouts of texts are calculated together when their nearest
+        // ancestor item computes its bounding boxes, see SPDocument::layoutDeferredTexts().
+        if (!document->deferTextLayout(this)) {
+            this->rebuildLayout();
+            this->showLayout();
+        }
+    }
+}
 
-        Geom::OptRect paintbox = this->geometricBounds();
+void SPText::showLayout()
+{
+    Geom::OptRect paintbox = this->geometricBounds();
 
-        for (auto &v : views) {
-            auto &sa = view_style_attachments[v.key];
-            sa.unattachAll();
-            auto g = cast<Inkscape::DrawingGroup>(v.drawingitem.get());
-            _clearFlow(g);
-            g->setStyle(style, parent->style);
-            // pass the bbox of this as paintbox (used for paintserver fills)
-            layout.show(g, sa, paintbox);
-        }
+    for (auto &v : views) {
+        auto &sa = view_style_attachments[v.key];
+        sa.unattachAll();
+        auto g = cast<Inkscape::DrawingGroup>(v.drawingitem.get());
+        _clearFlow(g);
+        g->setStyle(style, parent->style);
+        // pass the bbox of this as paintbox (used for paintserver fills)
+        layout.show(g, sa, paintbox);
     }
 }
 
@@ -47,6 +47,12 @@ public:
     /** Completely recalculates the layout. */
     void rebuildLayout();
 
+    /** Replaces the drawing items of all views by those of the current layout. */
+    void showLayout();
+
+    /** Set while the text waits for its layout in SPDocument, see SPDocument::deferTextLayout(). */
+    bool _layout_pending = false;
+
     //semiprivate:  (need to be accessed by the C-style functions still)
     TextTagAttributes attributes;
     Inkscape::Text::Layout layout;
@@ -603,6 +603,9 @@ void SPUse::href_changed() {
         if (refobj) {
             Inkscape::XML::Node *childrepr = refobj->getRepr();
 
+            // TODO: Every clone builds and shows a private copy of the source subtree, sharing
+            // only the curves of its paths with the other clones. Sharing the subtree and its
+            // drawing, with a rendering of the source cached at the current scale, is not done.
             SPObject* obj = SPFactory::createObject(NodeTraits::get_type_string(*childrepr));
 
             auto item = cast<SPItem>(obj);
@@ -11,8 +11,14 @@
  * Released under GNU GPL v2+, read the file 'COPYING' for more information.
  */
 
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <optional>
 #include <vector>
 
+#include <boost/geometry.hpp>
+#include <boost/geometry/index/rtree.hpp>
 #include <glibmm/i18n.h>
 #include <2geom/intersection-graph.h>
 #include <2geom/svg-path-parser.h> // to get from SVG on boolean to Geom::Path
@@ -20,9 +26,11 @@
 
 #include "path-boolop.h"
 #include "path-util.h"
+#include "async/worker-pool.h"
 
 #include "message-stack.h"
 #include "path-chemistry.h"     // copy_object_properties()
+#include "preferences.h"
 
 #include "helper/geom.h"        // pathv_to_linear_and_cubic_beziers()
 
@@ -352,6 +360,132 @@ Geom::PathVector sp_pathvector_boolop(Geom::PathVector const &pathva, Geom::Path
     return result.MakePathVector();
 }
 
+/// Number of paths from which pathBoolOp() computes a union with union_tree(), rather than
+/// adding one path after another.
+static int constexpr union_tree_threshold = 8;
+
+/**
+ * Union of many paths into res.
+ *
+ * The paths are first grouped by overlapping bounding boxes: the union of groups which do not
+ * overlap is just all of their outlines together, so those are never fed through Booleen().
+ * Within a group, the shapes are united pairwise in a balanced tree rather than one after another,
+ * and all unions of a level of the tree, over all groups, run in parallel.
+ */
+static void union_tree(Path *res, std::vector<Path *> const &originaux, std::vector<FillRule> const &origWind,
+                       std::vector<double> const &origThresh, std::vector<Geom::OptRect> const &origBounds)
+{
+    auto const count = originaux.size();
+    auto workers = Inkscape::Async::WorkerPool();
+
+    // Group the paths whose bounding boxes overlap, directly or through other paths.
+    std::vector<std::size_t> parent(count);
+    std::iota(parent.begin(), parent.end(), 0);
+    auto const find = [&] (std::size_t i) {
+        while (parent[i] != i) {
+            i = parent[i] = parent[parent[i]];
+        }
+        return i;
+    };
+    {
+        namespace bg = boost::geometry;
+        using Box = bg::model::box<bg::model::point<double, 2, bg::cs::cartesian>>;
+        using Value = std::pair<Box, std::size_t>;
+
+        std::vector<Value> values;
+        for (std::size_t i = 0; i < count; i++) {
+            if (auto const &box = origBounds[i]) {
+                values.emplace_back(Box({box->left(), box->top()}, {box->right(), box->bottom()}), i);
+            }
+        }
+        auto const tree = bg::index::rtree<Value, bg::index::quadratic<16>>(values.begin(), values.end());
+
+        std::vector<Value> found;
+        for (auto const &value : values) {
+            found.clear();
+            tree.query(bg::index::intersects(value.first), std::back_inserter(found));
+            for (auto const &other : found) {
+                parent[find(other.second)] = find(value.second);
+            }
+        }
+    }
+
+    std::vector<std::vector<std::size_t>> groups;
+    std::vector<std::size_t> group_of(count, count);
+    for (std::size_t i = 0; i < count; i++) {
+        auto &group = group_of[find(i)];
+        if (group == count) {
+            group = groups.size();
+            groups.emplace_back();
+        }
+        groups[group].push_back(i);
+    }
+
+    // Get the polygon of each path, with its own winding rule.
+    std::vector<std::unique_ptr<Shape>> shapes(count);
+    workers.run(count, [&] (std::size_t i) {
+        originaux[i]->ConvertWithBackData(origThresh[i]);
+        Shape tmp;
+        originaux[i]->Fill(&tmp, i);
+        shapes[i] = std::make_unique<Shape>();
+        shapes[i]->ConvertToShape(&tmp, origWind[i]);
+    });
+
+    // Unite the shapes of each group pairwise, keeping the result in the place of the first one,
+    // until one shape is left per group.
+    std::vector<std::pair<std::size_t, std::size_t>> pairs;
+    while (true) {
+        pairs.clear();
+        for (auto &group : groups) {
+            std::size_t kept = 0;
+            for (std::size_t j = 0; j < group.size(); j += 2) {
+                if (j + 1 < group.size()) {
+                    pairs.emplace_back(group[j], group[j + 1]);
+                }
+                group[kept++] = group[j];
+            }
+            group.resize(kept);
+        }
+        if (pairs.empty()) {
+            break;
+        }
+
+        workers.run(pairs.size(), [&] (std::size_t j) {
+            auto &a = shapes[pairs[j].first];
+            auto &b = shapes[pairs[j].second];
+            // As for the union of one path after another, one of the shapes may be empty due to
+            // quantization, and the result is then the other one.
+            if (a->numberOfEdges() == 0) {
+                a = std::move(b);
+            } else if (b->numberOfEdges() != 0) {
+                auto result = std::make_unique<Shape>();
+                result->Booleen(b.get(), a.get(), bool_op_union);
+                a = std::move(result);
+            }
+            b.reset();
+        });
+    }
+
+    if (groups.size() == 1) {
+        shapes[groups.front().front()]->ConvertToForme(res, count, originaux.data());
+        return;
+    }
+
+    std::vector<Geom::PathVector> results(groups.size());
+    workers.run(groups.size(), [&] (std::size_t g) {
+        Path path;
+        path.SetBackData(false);
+        shapes[groups[g].front()]->ConvertToForme(&path, count, originaux.data());
+        results[g] = path.MakePathVector();
+    });
+
+    Geom::PathVector pathv;
+    for (auto const &result : results) {
+        pathv.insert(pathv.end(), result.begin(), result.end());
+    }
+    res->LoadPathVector(pathv);
+}
+
 // helper for printing error messages, regardless of whether we have a GUI or not
 // If desktop == NULL, errors will be shown on stderr
 static void boolop_display_error_message(SPDesktop *desktop, Glib::ustring const &msg)
@@ -491,6 +625,7 @@ BoolOpErrors Inkscape::ObjectSet::pathBoolOp(bool_op bop, const bool skip_undo,
     std::vector<Path *> originaux(nbOriginaux);
     std::vector<FillRule> origWind(nbOriginaux);
     std::vector<double> origThresh(nbOriginaux);
+    std::vector<Geom::OptRect> origBounds(nbOriginaux);
     int curOrig;
     {
         curOrig = 0;
@@ -524,6 +659,7 @@ BoolOpErrors Inkscape::ObjectSet::pathBoolOp(bool_op bop, const bool skip_undo,
                 auto pathv = curve->get_pathvector() * item->i2doc_affine();
                 originaux[curOrig] = Path_for_pathvector(pathv).release();
                 origThresh[curOrig] = get_threshold(pathv);
+                origBounds[curOrig] = pathv.boundsFast();
             } else {
                 originaux[curOrig] = nullptr;
             }
@@ -554,7 +690,11 @@ BoolOpErrors Inkscape::ObjectSet::pathBoolOp(bool_op bop, const bool skip_undo,
     Path::cut_position  *toCut=nullptr;
     int                  nbToCut=0;
 
-    if ( bop == bool_op_inters || bop == bool_op_union || bop == bool_op_diff || bop == bool_op_symdiff ) {
+    bool const unionTree = bop == bool_op_union && nbOriginaux >= union_tree_threshold;
+
+    if (unionTree) {
+        union_tree(res, originaux, origWind, origThresh, origBounds);
+    } else if ( bop == bool_op_inters || bop == bool_op_union || bop == bool_op_diff || bop == bool_op_symdiff ) {
         // true boolean op
         // get the polygons of each path, with the winding rule specified, and apply the operation iteratively
         originaux[0]->ConvertWithBackData(origThresh[0]);
@@ -742,7 +882,7 @@ BoolOpErrors Inkscape::ObjectSet::pathBoolOp(bool_op bop, const bool skip_undo,
         // this function uses the point_data to get the winding number of each path (ie: is a hole or not)
         // for later reconstruction in objects, you also need to extract which path is parent of holes (nesting info)
         theShape->ConvertToFormeNested(res, nbOriginaux, &originaux[0], nbNest, nesting, conts, true);
-    } else {
+    } else if (!unionTree) {
         theShape->ConvertToForme(res, nbOriginaux, &originaux[0]);
     }
 
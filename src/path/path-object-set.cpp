@@ -41,17 +41,20 @@ ObjectSet::strokesToPaths(bool legacy, bool skip_undo)
       did = unlinkRecursive(true);
   }
 
+  std::vector<SPItem *> my_items(items().begin(), items().end());
+
+  // Outline the shapes on worker threads before changing anything else.
+  ItemPathsMap paths;
+  items_find_paths(my_items, legacy, paths);
+
   // Need to turn on stroke scaling to ensure stroke is scaled when transformed!
   bool scale_stroke = prefs->getBool("/options/transform/stroke", true);
   prefs->setBool("/options/transform/stroke", true);
 
-
-  std::vector<SPItem *> my_items(items().begin(), items().end());
-
   for (auto item : my_items) {
     // Do not remove the object from the selection here 
     // as we want to keep it selected if the whole operation fails
-    Inkscape::XML::Node *new_node = item_to_paths(item, legacy);
+    Inkscape::XML::Node *new_node = item_to_paths(item, legacy, nullptr, &paths);
     if (new_node) {
       SPObject* new_item = document()->getObjectByRepr(new_node);
 
@@ -15,12 +15,14 @@
  * contains lots of stitched pieces of path-chemistry.c
  */
 
+#include <memory>
 #include <vector>
 
 #include <glibmm/i18n.h>
 
 #include "path-offset.h"
 #include "path-util.h"
+#include "async/worker-pool.h"
 
 #include "message-stack.h"
 #include "path-chemistry.h"     // copy_object_properties()
@@ -43,7 +45,6 @@
 
 using Inkscape::DocumentUndo;
 
-void sp_selected_path_do_offset(SPDesktop *desktop, bool expand, double prefOffset);
 void sp_selected_path_create_offset_object(SPDesktop *desktop, int expand, bool updating);
 
 void
@@ -255,8 +256,98 @@ void sp_selected_path_create_offset_object(SPDesktop *desktop, int expand, bool
     delete res;
 }
 
+namespace {
+
+/// An item to inset or outset, with everything the offset needs from it.
+struct OffsetJob
+{
+    SPItem *item;
+    Geom::Affine transform;
+    std::unique_ptr<Path> orig;
+    FillRule fill_rule = fill_nonZero;
+    float width = 0;
+    float miter = 0;
+    JoinType join = join_straight;
+    std::unique_ptr<Path> res;
+};
+
+/**
+ * Compute the offset of a job. This only touches the job itself, so that the jobs of several
+ * items can be computed at the same time.
+ */
+void compute_offset(OffsetJob &job, bool expand)
+{
+    auto res = std::make_unique<Path>();
+    res->SetBackData(false);
+
+    Shape *theShape = new Shape;
+    Shape *theRes = new Shape;
+
+    job.orig->ConvertWithBackData(0.03);
+    job.orig->Fill(theShape, 0);
+
+    theRes->ConvertToShape(theShape, job.fill_rule);
+
+    // et maintenant: offset
+    // methode inexacte
+/*			Path *originaux[1];
+			originaux[0] = orig;
+			theRes->ConvertToForme(res, 1, originaux);
+
+			if (expand) {
+                        res->OutsideOutline(orig, 0.5 * o_width, o_join, o_butt, o_miter);
+			} else {
+                        res->OutsideOutline(orig, -0.5 * o_width, o_join, o_butt, o_miter);
+			}
+
+			orig->ConvertWithBackData(1.0);
+			orig->Fill(theShape, 0);
+			theRes->ConvertToShape(theShape, fill_positive);
+			originaux[0] = orig;
+			theRes->ConvertToForme(res, 1, originaux);
+
+			if (o_width >= 0.5) {
+                        //     res->Coalesce(1.0);
+                        res->ConvertEvenLines(1.0);
+                        res->Simplify(1.0);
+			} else {
+                        //      res->Coalesce(o_width);
+                        res->ConvertEvenLines(1.0*o_width);
+                        res->Simplify(1.0 * o_width);
+			}    */
+    // methode par makeoffset
+
+    if (expand)
+    {
+        theShape->MakeOffset(theRes, job.width, job.join, job.miter);
+    }
+    else
+    {
+        theShape->MakeOffset(theRes, -job.width, job.join, job.miter);
+    }
+    theRes->ConvertToShape(theShape, fill_positive);
+
+    res->Reset();
+    theRes->ConvertToForme(res.get());
+
+    res->ConvertEvenLines(0.1);
+    res->Simplify(0.1);
+
+    delete theShape;
+    delete theRes;
+
+    job.res = std::move(res);
+}
+
+} // namespace
+
 /**
  * Apply offset to selected paths
+ *
+ * The items are prepared one after another, then their offsets, which are independent of each
+ * other, are computed on the worker threads of a WorkerPool, and finally the results replace the
+ * items in the document, again one after another.
+ *
  * @param desktop Targeted desktop
  * @param expand True if offset expands, False if it shrinks paths
  * @param prefOffset Size of offset in pixels
@@ -271,7 +362,7 @@ sp_selected_path_do_offset(SPDesktop *desktop, bool expand, double prefOffset)
         return;
     }
 
-    bool did = false;
+    std::vector<OffsetJob> jobs;
     std::vector<SPItem*> il(selection->items().begin(), selection->items().end());
     for (auto item : il){
         if (auto shape = cast<SPShape>(item)) {
@@ -282,121 +373,62 @@ sp_selected_path_do_offset(SPDesktop *desktop, bool expand, double prefOffset)
             continue;
         }
 
-        Geom::Affine const transform(item->transform);
+        OffsetJob job;
+        job.item = item;
+        job.transform = item->transform;
         auto scaling_factor = item->i2doc_affine().descrim();
 
         item->doWriteTransform(Geom::identity());
 
-        float o_width = 0;
-        float o_miter = 0;
-        JoinType o_join = join_straight;
-        //ButtType o_butt = butt_straight;
-
         {
             SPStyle *i_style = item->style;
             int jointype = i_style->stroke_linejoin.value;
 
             switch (jointype) {
                 case SP_STROKE_LINEJOIN_MITER:
-                    o_join = join_pointy;
+                    job.join = join_pointy;
                     break;
                 case SP_STROKE_LINEJOIN_ROUND:
-                    o_join = join_round;
+                    job.join = join_round;
                     break;
                 default:
-                    o_join = join_straight;
+                    job.join = join_straight;
                     break;
             }
 
             // scale to account for transforms and document units
-            o_width = prefOffset / scaling_factor;
+            job.width = prefOffset / scaling_factor;
 
-            if (scaling_factor == 0 || o_width < MIN_OFFSET) {
-                o_width = MIN_OFFSET;
+            if (scaling_factor == 0 || job.width < MIN_OFFSET) {
+                job.width = MIN_OFFSET;
             }
-            o_miter = i_style->stroke_miterlimit.value * o_width;
+            job.miter = i_style->stroke_miterlimit.value * job.width;
         }
 
-        auto orig = Path_for_item(item, false);
-        if (!orig) {
+        job.orig = Path_for_item(item, false);
+        if (!job.orig) {
             continue;
         }
 
-        Path *res = new Path;
-        res->SetBackData(false);
-
-        {
-            Shape *theShape = new Shape;
-            Shape *theRes = new Shape;
-
-            orig->ConvertWithBackData(0.03);
-            orig->Fill(theShape, 0);
-
-            SPCSSAttr *css = sp_repr_css_attr(item->getRepr(), "style");
-            gchar const *val = sp_repr_css_property(css, "fill-rule", nullptr);
-            if (val && strcmp(val, "nonzero") == 0)
-            {
-                theRes->ConvertToShape(theShape, fill_nonZero);
-            }
-            else if (val && strcmp(val, "evenodd") == 0)
-            {
-                theRes->ConvertToShape(theShape, fill_oddEven);
-            }
-            else
-            {
-                theRes->ConvertToShape(theShape, fill_nonZero);
-            }
-
-            // et maintenant: offset
-            // methode inexacte
-/*			Path *originaux[1];
-			originaux[0] = orig;
-			theRes->ConvertToForme(res, 1, originaux);
-
-			if (expand) {
-                        res->OutsideOutline(orig, 0.5 * o_width, o_join, o_butt, o_miter);
-			} else {
-                        res->OutsideOutline(orig, -0.5 * o_width, o_join, o_butt, o_miter);
-			}
-
-			orig->ConvertWithBackData(1.0);
-			orig->Fill(theShape, 0);
-			theRes->ConvertToShape(theShape, fill_positive);
-			originaux[0] = orig;
-			theRes->ConvertToForme(res, 1, originaux);
-
-			if (o_width >= 0.5) {
-                        //     res->Coalesce(1.0);
-                        res->ConvertEvenLines(1.0);
-                        res->Simplify(1.0);
-			} else {
-                        //      res->Coalesce(o_width);
-                        res->ConvertEvenLines(1.0*o_width);
-                        res->Simplify(1.0 * o_width);
-			}    */
-            // methode par makeoffset
-
-            if (expand)
-            {
-                theShape->MakeOffset(theRes, o_width, o_join, o_miter);
-            }
-            else
-            {
-                theShape->MakeOffset(theRes, -o_width, o_join, o_miter);
-            }
-            theRes->ConvertToShape(theShape, fill_positive);
+        SPCSSAttr *css = sp_repr_css_attr(item->getRepr(), "style");
+        gchar const *val = sp_repr_css_property(css, "fill-rule", nullptr);
+        if (val && strcmp(val, "evenodd") == 0) {
+            job.fill_rule = fill_oddEven;
+        }
+        sp_repr_css_attr_unref(css);
 
-            res->Reset();
-            theRes->ConvertToForme(res);
+        jobs.push_back(std::move(job));
+    }
 
-            res->ConvertEvenLines(0.1);
-            res->Simplify(0.1);
+    if (jobs.empty()) {
+        desktop->messageStack()->flash(Inkscape::ERROR_MESSAGE, _("<b>No paths</b> to inset/outset in the selection."));
+        return;
+    }
 
-            delete theShape;
-            delete theRes;
-        }
+    Inkscape::Async::WorkerPool().run(jobs.size(), [&] (std::size_t i) { compute_offset(jobs[i], expand); });
 
-        did = true;
+    for (auto &job : jobs) {
+        auto item = job.item;
 
         // remember the position of the item
         gint pos = item->getRepr()->position();
@@ -407,7 +439,7 @@ sp_selected_path_do_offset(SPDesktop *desktop, bool expand, double prefOffset)
 
         Inkscape::XML::Node *repr = nullptr;
 
-        if (res->descr_cmd.size() > 1) { // if there's 0 or 1 node left, drop this path altogether
+        if (job.res->descr_cmd.size() > 1) { // if there's 0 or 1 node left, drop this path altogether
             Inkscape::XML::Document *xml_doc = desktop->doc()->getReprDoc();
             repr = xml_doc->createElement("svg:path");
 
@@ -417,7 +449,7 @@ sp_selected_path_do_offset(SPDesktop *desktop, bool expand, double prefOffset)
         item->deleteObject(false);
 
         if (repr) {
-            repr->setAttribute("d", res->svg_dump_path().c_str());
+            repr->setAttribute("d", job.res->svg_dump_path().c_str());
 
             // add the new repr to the parent
             // move to the saved position
@@ -426,24 +458,17 @@ sp_selected_path_do_offset(SPDesktop *desktop, bool expand, double prefOffset)
             auto newitem = cast_unsafe<SPItem>(desktop->getDocument()->getObjectByRepr(repr));
 
             // reapply the transform
-            newitem->doWriteTransform(transform);
+            newitem->doWriteTransform(job.transform);
 
             selection->add(repr);
 
             Inkscape::GC::release(repr);
         }
-
-        delete res;
     }
 
-    if (did) {
-        DocumentUndo::done(desktop->getDocument(),
-                           (expand ? _("Outset path") : _("Inset path")),
-                           (expand ? INKSCAPE_ICON("path-outset") : INKSCAPE_ICON("path-inset")));
-    } else {
-        desktop->messageStack()->flash(Inkscape::ERROR_MESSAGE, _("<b>No paths</b> to inset/outset in the selection."));
-        return;
-    }
+    DocumentUndo::done(desktop->getDocument(),
+                       (expand ? _("Outset path") : _("Inset path")),
+                       (expand ? INKSCAPE_ICON("path-outset") : INKSCAPE_ICON("path-inset")));
 }
 
 /*
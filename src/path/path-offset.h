@@ -25,6 +25,10 @@ void sp_selected_path_create_updating_offset (SPDesktop *desktop);
 void sp_selected_path_create_updating_inset (SPDesktop *desktop);
 
 void sp_selected_path_create_offset_object_zero (SPDesktop *desktop);
+
+// offset/inset of the selected items by prefOffset pixels, computed in parallel for large
+// selections
+void sp_selected_path_do_offset (SPDesktop *desktop, bool expand, double prefOffset);
 void sp_selected_path_create_updating_offset_object_zero (SPDesktop *desktop);
 
 #endif // PATH_OFFSET_H
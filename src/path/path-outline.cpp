@@ -20,6 +20,8 @@
 
 #include <vector>
 
+#include "async/worker-pool.h"
+
 #include "path-chemistry.h" // Should be moved to path directory
 #include "message-stack.h"  // Should be removed.
 #include "selection.h"
@@ -338,6 +340,46 @@ Geom::PathVector* item_to_outline(SPItem const *item, bool exclude_markers)
 
 // ========================= Stroke to Path ====================== //
 
+void items_find_paths(std::vector<SPItem *> const &items, bool legacy, ItemPathsMap &paths)
+{
+    // The shapes item_to_paths() reaches without changing anything first: path effects are
+    // flattened, and texts and 3D boxes converted to paths, right before their conversion.
+    std::vector<SPItem const *> shapes;
+    auto collect = [&] (SPItem *item, auto const &collect) -> void {
+        if (auto lpeitem = cast<SPLPEItem>(item); lpeitem && lpeitem->hasPathEffect()) {
+            return;
+        }
+        if (is<SPText>(item) || is<SPFlowtext>(item) || is<SPBox3D>(item)) {
+            return;
+        }
+        if (auto group = cast<SPGroup>(item)) {
+            if (!legacy) {
+                for (auto subitem : group->item_list()) {
+                    collect(subitem, collect);
+                }
+            }
+            return;
+        }
+        if (is<SPShape>(item)) {
+            shapes.push_back(item);
+        }
+    };
+    for (auto item : items) {
+        collect(item, collect);
+    }
+
+    // item_find_paths() only reads the shape, and the livarot objects it uses are its own; the
+    // state of Path::OutlineJoin() is kept in the outline it writes to.
+    std::vector<ItemPaths> results(shapes.size());
+    Inkscape::Async::WorkerPool().run(shapes.size(), [&] (std::size_t i) {
+        results[i].found = item_find_paths(shapes[i], results[i].fill, results[i].stroke);
+    });
+
+    for (std::size_t i = 0; i < shapes.size(); i++) {
+        paths.emplace(shapes[i], std::move(results[i]));
+    }
+}
+
 static
 void item_to_paths_add_marker( SPItem *context,
                                SPObject *marker_object,
@@ -381,7 +423,7 @@ void item_to_paths_add_marker( SPItem *context,
  * The return value is used externally to update a selection. It is nullptr if no change is made.
  */
 Inkscape::XML::Node*
-item_to_paths(SPItem *item, bool legacy, SPItem *context)
+item_to_paths(SPItem *item, bool legacy, SPItem *context, ItemPathsMap *paths)
 {
     char const *id = item->getAttribute("id");
     SPDocument *doc = item->document;
@@ -428,7 +470,7 @@ item_to_paths(SPItem *item, bool legacy, SPItem *context)
         std::vector<SPItem*> const item_list = group->item_list();
         bool did = false;
         for (auto subitem : item_list) {
-            if (item_to_paths(subitem, legacy)) {
+            if (item_to_paths(subitem, legacy, nullptr, paths)) {
                 did = true;
             }
         }
@@ -447,7 +489,16 @@ item_to_paths(SPItem *item, bool legacy, SPItem *context)
 
     Geom::PathVector fill_path;
     Geom::PathVector stroke_path;
-    bool status = item_find_paths(item, fill_path, stroke_path);
+    bool status;
+    auto precomputed = paths ? paths->find(item) : ItemPathsMap::iterator();
+    if (paths && precomputed != paths->end()) {
+        status = precomputed->second.found;
+        fill_path = std::move(precomputed->second.fill);
+        stroke_path = std::move(precomputed->second.stroke);
+        paths->erase(precomputed);
+    } else {
+        status = item_find_paths(item, fill_path, stroke_path);
+    }
 
     if (!status) {
         // Was not a well structured shape (or text).
@@ -16,13 +16,13 @@
 #ifndef SEEN_PATH_OUTLINE_H
 #define SEEN_PATH_OUTLINE_H
 
+#include <unordered_map>
+#include <vector>
+#include <2geom/pathvector.h>
+
 class SPDesktop;
 class SPItem;
 
-namespace Geom {
-  class PathVector;
-}
-
 namespace Inkscape {
 namespace XML {
   class Node;
@@ -39,10 +39,28 @@ bool item_find_paths(const SPItem *item, Geom::PathVector& fill, Geom::PathVecto
  */
 Geom::PathVector* item_to_outline (SPItem const *item, bool exclude_markers = false);
 
+/**
+ * The result of item_find_paths() for an item.
+ */
+struct ItemPaths
+{
+    bool found = false;
+    Geom::PathVector fill;
+    Geom::PathVector stroke;
+};
+using ItemPathsMap = std::unordered_map<SPItem const *, ItemPaths>;
+
+/**
+ * Find the fill and stroke of all the shapes item_to_paths() will replace for the given items,
+ * in parallel.
+ */
+void items_find_paths(std::vector<SPItem *> const &items, bool legacy, ItemPathsMap &paths);
+
 /**
  * Replace item by path objects (a.k.a. stroke to path).
+ * The fill and stroke of shapes are taken from paths if they are in it, and removed from it.
  */
-Inkscape::XML::Node* item_to_paths(SPItem *item, bool legacy = false, SPItem *context = nullptr);
+Inkscape::XML::Node* item_to_paths(SPItem *item, bool legacy = false, SPItem *context = nullptr, ItemPathsMap *paths = nullptr);
 
 /**
  * Replace selected items by path objects (a.k.a. stroke to >path).
@@ -16,6 +16,7 @@
  * Released under GNU GPL v2+, read the file 'COPYING' for more information.
  */
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -34,6 +35,7 @@
 #include "object/sp-object.h"
 #include "object/sp-page.h"
 #include "object/sp-clippath.h"
+#include "object/item-index.h"
 #include "object/sp-root.h"
 #include "style.h"
 
@@ -833,6 +835,82 @@ SPPage const *SnapManager::getPageToIgnore() const
 }
 
 
+bool SnapManager::_isIgnoredCandidate(SPItem const *item, unsigned dkey, std::vector<SPObject const *> const *it,
+                                      bool clip_or_mask)
+{
+    // Don't snap to hidden objects, unless they're a clipped path or a mask
+    if (item->isHidden(dkey) && !clip_or_mask) {
+        return true;
+    }
+
+    // Fix LPE boolops self-snapping
+    bool stop = false;
+    if (item->style) {
+        SPFilter *filt = item->style->getFilter();
+        if (filt && filt->getId() && strcmp(filt->getId(), "selectable_hidder_filter") == 0) {
+            stop = true;
+        }
+        auto lpeitem = cast<SPLPEItem>(item);
+        if (lpeitem && lpeitem->hasPathEffectOfType(Inkscape::LivePathEffect::EffectType::BOOL_OP)) {
+            stop = true;
+        }
+    }
+    if (stop && it) {
+        stop = false;
+        for (auto skipitem : *it) {
+            if (skipitem && skipitem->style) {
+                auto toskip = cast<SPItem>(const_cast<SPObject *>(skipitem));
+                if (toskip) {
+                    SPFilter *filt = toskip->style->getFilter();
+                    if (filt && filt->getId() && strcmp(filt->getId(), "selectable_hidder_filter") == 0) {
+                        stop = true;
+                        break;
+                    }
+
+                    auto lpeitem = cast<SPLPEItem>(toskip);
+                    if (!stop && lpeitem &&
+                        lpeitem->hasPathEffectOfType(Inkscape::LivePathEffect::EffectType::BOOL_OP)) {
+                        stop = true;
+                        break;
+                    }
+                }
+            }
+        }
+        if (stop) {
+            return true;
+        }
+    }
+
+    // Snapping to items in a locked layer is allowed
+    /* See if this item is on the ignore list */
+    return it && std::find(it->begin(), it->end(), item) != it->end();
+}
+
+void SnapManager::visitCandidateItems(SPDocument *document, unsigned dkey, std::vector<SPObject const *> const *it,
+                                      Geom::Rect const &area, std::function<void (SPItem *)> const &f)
+{
+    auto const root = document->getRoot();
+    auto items = document->getItemIndex().intersecting(root, area);
+    std::sort(items.begin(), items.end(), sp_object_compare_position_bool);
+
+    for (auto item : items) {
+        if (is<SPGroup>(item)) {
+            continue;
+        }
+        // The walk of _findCandidates() would only reach the item through its ancestors.
+        bool reached = true;
+        for (SPItem const *i = item; i != root; i = cast<SPItem>(i->parent)) {
+            if (_isIgnoredCandidate(i, dkey, it, false)) {
+                reached = false;
+                break;
+            }
+        }
+        if (reached) {
+            f(item);
+        }
+    }
+}
+
 void SnapManager::_findCandidates(SPObject* parent,
                                  std::vector<SPObject const *> const *it,
                                  Geom::Rect const &bbox_to_snap,
@@ -855,6 +933,16 @@ void SnapManager::_findCandidates(SPObject* parent,
         _findCandidates_already_called = true;
         _obj_snapper_candidates->clear();
         _align_snapper_candidates->clear();
+
+        // Look the items of the document up in its item index rather than visiting all of them,
+        // unless rotation centers, which may lie far outside the bounds of their items, are
+        // snapped to. The index learns of changed bounds when the document is updated, so it
+        // can only be used when no update is pending.
+        auto const root = getDocument()->getRoot();
+        if (parent == root && !root->uflags && !snapprefs.isTargetSnappable(Inkscape::SNAPTARGET_ROTATION_CENTER)) {
+            _findIndexedCandidates(it, bbox_to_snap);
+            return;
+        }
     }
     recursion_level++;
 
@@ -863,130 +951,120 @@ void SnapManager::_findCandidates(SPObject* parent,
 
     for (auto& o: parent->children) {
         auto item = cast<SPItem>(&o);
-        if (item && !(dt->itemIsHidden(item) && !clip_or_mask)) {
-            // Fix LPE boolops self-snapping
-            bool stop = false;
-            if (item->style) {
-                SPFilter *filt = item->style->getFilter();
-                if (filt && filt->getId() && strcmp(filt->getId(), "selectable_hidder_filter") == 0) {
-                    stop = true;
-                }
-                auto lpeitem = cast<SPLPEItem>(item);
-                if (lpeitem && lpeitem->hasPathEffectOfType(Inkscape::LivePathEffect::EffectType::BOOL_OP)) {
-                    stop = true;
-                }
-            }
-            if (stop && it) {
-                stop = false;
-                for (auto skipitem : *it) {
-                    if (skipitem && skipitem->style) {
-                        auto toskip = cast<SPItem>(const_cast<SPObject *>(skipitem));
-                        if (toskip) {
-                            SPFilter *filt = toskip->style->getFilter();
-                            if (filt && filt->getId() && strcmp(filt->getId(), "selectable_hidder_filter") == 0) {
-                                stop = true;
-                                break;
-                            }
-
-                            auto lpeitem = cast<SPLPEItem>(toskip);
-                            if (!stop && lpeitem &&
-                                lpeitem->hasPathEffectOfType(Inkscape::LivePathEffect::EffectType::BOOL_OP)) {
-                                stop = true;
-                                break;
-                            }
-                        }
-                    }
-                }
-                if (stop) {
-                    continue;
-                }
-            }
-            // Snapping to items in a locked layer is allowed
-            // Don't snap to hidden objects, unless they're a clipped path or a mask
-            /* See if this item is on the ignore list */
-            std::vector<SPObject const *>::const_iterator i;
-            if (it != nullptr) {
-                i = it->begin();
-                while (i != it->end() && *i != &o) {
-                    ++i;
-                }
-            }
+        if (!item || _isIgnoredCandidate(item, dt->dkey, it, clip_or_mask)) {
+            continue;
+        }
+        if (!clip_or_mask) { // cannot clip or mask more than once
+            _findClipAndMaskCandidates(item, it, bbox_to_snap);
+        }
+        if (is<SPGroup>(item)) {
+            _findCandidates(&o, it, bbox_to_snap, clip_or_mask, additional_affine);
+        } else if (_addCandidate(item, bbox_to_snap_incl, clip_or_mask, additional_affine)) {
+            break;
+        }
+    }
 
-            if (it == nullptr || i == it->end()) {
-                if (item) {
-                    if (!clip_or_mask) { // cannot clip or mask more than once
-                        // The current item is not a clipping path or a mask, but might
-                        // still be the subject of clipping or masking itself ; if so, then
-                        // we should also consider that path or mask for snapping to
-                        SPObject *obj = item->getClipObject();
-                        if (obj && snapprefs.isTargetSnappable(Inkscape::SNAPTARGET_PATH_CLIP)) {
-                            _findCandidates(obj, it, bbox_to_snap, true, item->i2doc_affine());
-                        }
-                        obj = item->getMaskObject();
-                        if (obj && snapprefs.isTargetSnappable(Inkscape::SNAPTARGET_PATH_MASK)) {
-                            _findCandidates(obj, it, bbox_to_snap, true, item->i2doc_affine());
-                        }
-                    }
+    recursion_level--;
+}
 
-                    if (is<SPGroup>(item)) {
-                        _findCandidates(&o, it, bbox_to_snap, clip_or_mask, additional_affine);
-                    } else {
-                        Geom::OptRect bbox_of_item;
-                        Inkscape::Preferences *prefs = Inkscape::Preferences::get();
-                        int prefs_bbox = prefs->getBool("/tools/bounding_box", false);
-                        // We'll only need to obtain the visual bounding box if the user preferences tell
-                        // us to, AND if we are snapping to the bounding box itself. If we're snapping to
-                        // paths only, then we can just as well use the geometric bounding box (which is faster)
-                        SPItem::BBoxType bbox_type = (!prefs_bbox && snapprefs.isTargetSnappable(Inkscape::SNAPTARGET_BBOX_CATEGORY)) ?
-                            SPItem::VISUAL_BBOX : SPItem::GEOMETRIC_BBOX;
-                        if (clip_or_mask) {
-                            // Oh oh, this will get ugly. We cannot use sp_item_i2d_affine directly because we need to
-                            // insert an additional transformation in document coordinates (code copied from sp_item_i2d_affine)
-                            bbox_of_item = item->bounds(bbox_type, item->i2doc_affine() * additional_affine * dt->doc2dt());
-                        } else {
-                            bbox_of_item = item->desktopBounds(bbox_type);
-                        }
-                        if (bbox_of_item) {
-                            bool overflow = false;
-                            // See if the item is within range
-                            auto display_area = getDesktop()->get_display_area().bounds();
-                            if (display_area.intersects(*bbox_of_item)) {
-                                // Finally add the object to _candidates.
-                                _align_snapper_candidates->push_back(Inkscape::SnapCandidateItem(item, clip_or_mask, additional_affine));
-                                // For debugging: print the id of the candidate to the console
-                                // SPObject *obj = (SPObject*)item;
-                                // std::cout << "Snap candidate added: " << obj->getId() << std::endl;
-
-                                if (bbox_to_snap_incl.intersects(*bbox_of_item)
-                                        || (snapprefs.isTargetSnappable(Inkscape::SNAPTARGET_ROTATION_CENTER) && bbox_to_snap_incl.contains(item->getCenter()))) { // rotation center might be outside of the bounding box
-                                    // This item is within snapping range, so record it as a candidate
-                                    _obj_snapper_candidates->push_back(Inkscape::SnapCandidateItem(item, clip_or_mask, additional_affine));
-                                    // For debugging: print the id of the candidate to the console
-                                    // SPObject *obj = (SPObject*)item;
-                                    // std::cout << "Snap candidate added: " << obj->getId() << std::endl;
-                                }
-
-                                if (_align_snapper_candidates->size() > 200) { // This makes Inkscape crawl already
-                                    overflow = true;
-                                }
-                            }
-
-                            if (overflow) {
-                                static Glib::Timer timer;
-                                if (timer.elapsed() > 1.0) {
-                                    timer.reset();
-                                    std::cerr << "Warning: limit of 200 snap target paths reached, some will be ignored" << std::endl;
-                                }
-                                break;
-                            }
-                        }
-                    }
-                }
-            }
+void SnapManager::_findIndexedCandidates(std::vector<SPObject const *> const *it, Geom::Rect const &bbox_to_snap)
+{
+    SPDesktop const *dt = getDesktop();
+
+    Geom::Rect bbox_to_snap_incl = bbox_to_snap; // _incl means: will include the snapper tolerance
+    bbox_to_snap_incl.expandBy(object.getSnapperTolerance());
+
+    // Only the alignment and distribution snappers use the items in all of the display area.
+    Geom::OptRect area = dt->get_display_area().bounds();
+    if (!snapprefs.isTargetSnappable(Inkscape::SNAPTARGET_ALIGNMENT_CATEGORY) &&
+        !snapprefs.isTargetSnappable(Inkscape::SNAPTARGET_DISTRIBUTION_CATEGORY))
+    {
+        area.intersectWith(bbox_to_snap_incl);
+    }
+    if (!area) {
+        return;
+    }
+
+    // Visual bounds contain the geometric ones, so the index finds every item _addCandidate() may take.
+    bool overflow = false;
+    visitCandidateItems(getDocument(), dt->dkey, it, *area * dt->dt2doc(), [&] (SPItem *item) {
+        if (!overflow) {
+            _findClipAndMaskCandidates(item, it, bbox_to_snap);
+            overflow = _addCandidate(item, bbox_to_snap_incl, false, Geom::identity());
         }
+    });
+}
+
+void SnapManager::_findClipAndMaskCandidates(SPItem *item, std::vector<SPObject const *> const *it,
+                                             Geom::Rect const &bbox_to_snap)
+{
+    // The current item is not a clipping path or a mask, but might
+    // still be the subject of clipping or masking itself ; if so, then
+    // we should also consider that path or mask for snapping to
+    SPObject *obj = item->getClipObject();
+    if (obj && snapprefs.isTargetSnappable(Inkscape::SNAPTARGET_PATH_CLIP)) {
+        _findCandidates(obj, it, bbox_to_snap, true, item->i2doc_affine());
     }
+    obj = item->getMaskObject();
+    if (obj && snapprefs.isTargetSnappable(Inkscape::SNAPTARGET_PATH_MASK)) {
+        _findCandidates(obj, it, bbox_to_snap, true, item->i2doc_affine());
+    }
+}
 
-    recursion_level--;
+bool SnapManager::_addCandidate(SPItem *item, Geom::Rect const &bbox_to_snap_incl, bool clip_or_mask,
+                                Geom::Affine const &additional_affine)
+{
+    SPDesktop const *dt = getDesktop();
+
+    Geom::OptRect bbox_of_item;
+    Inkscape::Preferences *prefs = Inkscape::Preferences::get();
+    int prefs_bbox = prefs->getBool("/tools/bounding_box", false);
+    // We'll only need to obtain the visual bounding box if the user preferences tell
+    // us to, AND if we are snapping to the bounding box itself. If we're snapping to
+    // paths only, then we can just as well use the geometric bounding box (which is faster)
+    SPItem::BBoxType bbox_type = (!prefs_bbox && snapprefs.isTargetSnappable(Inkscape::SNAPTARGET_BBOX_CATEGORY)) ?
+        SPItem::VISUAL_BBOX : SPItem::GEOMETRIC_BBOX;
+    if (clip_or_mask) {
+        // Oh oh, this will get ugly. We cannot use sp_item_i2d_affine directly because we need to
+        // insert an additional transformation in document coordinates (code copied from sp_item_i2d_affine)
+        bbox_of_item = item->bounds(bbox_type, item->i2doc_affine() * additional_affine * dt->doc2dt());
+    } else {
+        bbox_of_item = item->desktopBounds(bbox_type);
+    }
+    if (!bbox_of_item) {
+        return false;
+    }
+
+    // See if the item is within range
+    auto display_area = dt->get_display_area().bounds();
+    if (!display_area.intersects(*bbox_of_item)) {
+        return false;
+    }
+
+    // Finally add the object to _candidates.
+    _align_snapper_candidates->push_back(Inkscape::SnapCandidateItem(item, clip_or_mask, additional_affine));
+    // For debugging: print the id of the candidate to the console
+    // SPObject *obj = (SPObject*)item;
+    // std::cout << "Snap candidate added: " << obj->getId() << std::endl;
+
+    if (bbox_to_snap_incl.intersects(*bbox_of_item)
+            || (snapprefs.isTargetSnappable(Inkscape::SNAPTARGET_ROTATION_CENTER) && bbox_to_snap_incl.contains(item->getCenter()))) { // rotation center might be outside of the bounding box
+        // This item is within snapping range, so record it as a candidate
+        _obj_snapper_candidates->push_back(Inkscape::SnapCandidateItem(item, clip_or_mask, additional_affine));
+        // For debugging: print the id of the candidate to the console
+        // SPObject *obj = (SPObject*)item;
+        // std::cout << "Snap candidate added: " << obj->getId() << std::endl;
+    }
+
+    if (_align_snapper_candidates->size() > 200) { // This makes Inkscape crawl already
+        static Glib::Timer timer;
+        if (timer.elapsed() > 1.0) {
+            timer.reset();
+            std::cerr << "Warning: limit of 200 snap target paths reached, some will be ignored" << std::endl;
+        }
+        return true;
+    }
+    return false;
 }
 /*
   Local Variables:
@@ -18,6 +18,7 @@
 #ifndef SEEN_SNAP_H
 #define SEEN_SNAP_H
 
+#include <functional>
 #include <memory>
 #include <vector>
 
@@ -38,6 +39,7 @@ enum SPGuideDragType { // used both here and in desktop-events.cpp
 
 class SPDocument;
 class SPGuide;
+class SPItem;
 class SPPage;
 class SPNamedView;
 
@@ -418,6 +420,17 @@ public:
                                             Geom::Point const &pointer,
                                             Inkscape::PureTransform &transform);
 
+    /**
+     * Call f, in document order, for each item the search for snap candidates considers whose
+     * visual bounds intersect @a area, in document coordinates: the items that are not groups,
+     * and that are neither hidden, nor ignored, nor in a group which is. The items are looked
+     * up in the item index of the document, so it must be up to date.
+     *
+     * @param it List of items to ignore.
+     */
+    static void visitCandidateItems(SPDocument *document, unsigned dkey, std::vector<SPObject const *> const *it,
+                                    Geom::Rect const &area, std::function<void (SPItem *)> const &f);
+
 protected:
     SPNamedView const *_named_view;
 
@@ -442,6 +455,15 @@ private:
                        Geom::Affine const additional_affine);
     bool _findCandidates_already_called;
 
+    /// Find the candidates near the root of the document through its item index.
+    void _findIndexedCandidates(std::vector<SPObject const *> const *it, Geom::Rect const &bbox_to_snap);
+    /// Find the candidates in the clipping path and mask of an item.
+    void _findClipAndMaskCandidates(SPItem *item, std::vector<SPObject const *> const *it, Geom::Rect const &bbox_to_snap);
+    /// Add an item which is not a group to the candidates if it is in range. Returns whether there are too many.
+    bool _addCandidate(SPItem *item, Geom::Rect const &bbox_to_snap_incl, bool clip_or_mask, Geom::Affine const &additional_affine);
+    /// Whether an item is skipped by the search for candidates, with its descendants.
+    static bool _isIgnoredCandidate(SPItem const *item, unsigned dkey, std::vector<SPObject const *> const *it, bool clip_or_mask);
+
     std::unique_ptr<std::vector<Inkscape::SnapCandidateItem>> _obj_snapper_candidates;
     std::unique_ptr<std::vector<Inkscape::SnapCandidateItem>> _align_snapper_candidates;
 
@@ -25,6 +25,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <string_view>
 #include <glibmm/regex.h>
 
 #include "style-internal.h"
@@ -44,6 +45,7 @@
 #include "svg/svg-color.h"
 #include "svg/css-ostringstream.h"
 
+#include "util/interner.h"
 #include "util/units.h"
 
 // TODO REMOVE OR MAKE MEMBER FUNCTIONS
@@ -1178,6 +1180,21 @@ const Glib::ustring SPIEastAsian::get_value() const
 
 // SPIString ------------------------------------------------------------
 
+namespace {
+
+/**
+ * The values of SPIStrings, interned so that styles reading equal values share one copy of it.
+ * A value is forgotten when the last SPIString holding it lets go of it.
+ */
+Inkscape::Util::Interner<std::string> &string_values()
+{
+    // Never destroyed, as styles may be destroyed during static destruction.
+    static auto const values = new Inkscape::Util::Interner<std::string>;
+    return *values;
+}
+
+} // namespace
+
 void
 SPIString::read( gchar const *str ) {
 
@@ -1206,11 +1223,23 @@ SPIString::read( gchar const *str ) {
         }
 
         set = true;
-        _value = g_strdup(str);
+        _value = string_values().intern(str);
     }
 }
 
 
+SPIString::Statistics SPIString::statistics()
+{
+    Statistics result;
+    string_values().for_each([&] (std::string_view value, long references) {
+        result.values++;
+        result.bytes += value.size() + 1;
+        result.references += references;
+        result.unshared_bytes += (value.size() + 1) * references;
+    });
+    return result;
+}
+
 /**
  * Value as it should be written to CSS representation, including quotes if needed.
  */
@@ -1235,7 +1264,7 @@ const Glib::ustring SPIString::get_value() const
 
 char const *SPIString::value() const
 {
-    return _value ? _value : get_default_value();
+    return _value ? _value->c_str() : get_default_value();
 }
 
 char const *SPIString::get_default_value() const
@@ -1254,16 +1283,14 @@ char const *SPIString::get_default_value() const
 void
 SPIString::clear() {
     SPIBase::clear();
-    g_free(_value);
-    _value = nullptr;
+    _value.reset();
 }
 
 void
 SPIString::cascade( const SPIBase* const parent ) {
     if( const SPIString* p = dynamic_cast<const SPIString*>(parent) ) {
         if( inherits && (!set || inherit) ) {
-            g_free(_value);
-            _value = g_strdup(p->_value);
+            _value = p->_value;
         }
     } else {
         std::cerr << "SPIString::cascade(): Incorrect parent type" << std::endl;
@@ -1277,8 +1304,7 @@ SPIString::merge( const SPIBase* const parent ) {
             if( (!set || inherit) && p->set && !(p->inherit) ) {
                 set     = p->set;
                 inherit = p->inherit;
-                g_free(_value);
-                _value = g_strdup(p->_value);
+                _value = p->_value;
             }
         }
     }
@@ -1287,7 +1313,8 @@ SPIString::merge( const SPIBase* const parent ) {
 bool
 SPIString::operator==(const SPIBase& rhs) const {
     if( const SPIString* r = dynamic_cast<const SPIString*>(&rhs) ) {
-        return g_strcmp0(_value, r->_value) == 0 && SPIBase::operator==(rhs);
+        auto const equal = _value == r->_value || (_value && r->_value && *_value == *r->_value);
+        return equal && SPIBase::operator==(rhs);
     } else {
         return false;
     }
@@ -18,6 +18,9 @@
  * Released under GNU GPL v2+, read the file 'COPYING' for more information.
  */
 
+#include <cstddef>
+#include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 #include <map>
@@ -613,9 +616,7 @@ public:
 
     SPIString(const SPIString &rhs) { *this = rhs; }
 
-    ~SPIString() override {
-        g_free(_value);
-    }
+    ~SPIString() override = default;
 
     void read( gchar const *str ) override;
     const Glib::ustring get_value() const override;
@@ -628,8 +629,7 @@ public:
             return *this;
         }
         SPIBase::operator=(rhs);
-        g_free(_value);
-        _value = g_strdup(rhs._value);
+        _value = rhs._value;
         return *this;
     }
 
@@ -638,10 +638,21 @@ public:
     //! Get value if set, or inherited value, or default value (may be NULL)
     char const *value() const;
 
+    /// The values of all SPIStrings, which equal values share.
+    struct Statistics
+    {
+        std::size_t values = 0;     ///< Distinct values.
+        std::size_t bytes = 0;      ///< Bytes of the distinct values.
+        std::size_t references = 0; ///< SPIStrings holding one of the values.
+        std::size_t unshared_bytes = 0; ///< Bytes of the values if each SPIString had a copy.
+    };
+    static Statistics statistics();
+
   private:
     char const *get_default_value() const;
 
-    gchar *_value = nullptr;
+    /// Immutable, so that copies, cascading and inheriting share it rather than copy it.
+    std::shared_ptr<std::string const> _value;
 };
 
 /// Shapes type internal to SPStyle.
@@ -37,6 +37,7 @@
 
 #include "3rdparty/libcroco/src/cr-sel-eng.h"
 
+#include "object/selector-index.h"
 #include "object/sp-paint-server.h"
 #include "object/uri-references.h"
 #include "object/uri.h"
@@ -220,6 +221,11 @@ public:
         return get(style, sp_attribute_lookup(name.c_str()));
     }
 
+    /**
+     * Get the pointers to all the property members, shared by all styles
+     */
+    std::vector<SPIBasePtr> const &get_members() const { return m_vector; }
+
     /**
      * Get a vector of property pointers
      * \todo provide iterator instead
@@ -463,10 +469,6 @@ SPStyle::SPStyle(SPDocument *document_in, SPObject *object_in) :
     marker_ptrs[SP_MARKER_LOC_START] = &marker_start;
     marker_ptrs[SP_MARKER_LOC_MID]   = &marker_mid;
     marker_ptrs[SP_MARKER_LOC_END]   = &marker_end;
-
-
-    // This might be too resource hungary... but for now it possible to loop over properties
-    _properties = _prop_helper.get_vector(this);
 }
 
 SPStyle::~SPStyle() {
@@ -496,7 +498,7 @@ SPStyle::~SPStyle() {
     // std::cout << "SPStyle::~SPStyle(): Exit\n" << std::endl;
 }
 
-const std::vector<SPIBase *> SPStyle::properties() { return this->_properties; }
+const std::vector<SPIBase *> SPStyle::properties() { return _prop_helper.get_vector(this); }
 
 void
 SPStyle::clear(SPAttr id) {
@@ -510,8 +512,8 @@ SPStyle::clear(SPAttr id) {
 
 void
 SPStyle::clear() {
-    for (auto * p : _properties) {
-        p->clear();
+    for (auto ptr : _prop_helper.get_members()) {
+        (this->*ptr).clear();
     }
 
     // Release connection to object, created in constructor.
@@ -577,12 +579,13 @@ SPStyle::read( SPObject *object, Inkscape::XML::Node *repr ) {
     }
 
     /* 3 Presentation attributes */
-    for (auto * p : _properties) {
+    for (auto ptr : _prop_helper.get_members()) {
         // Shorthands are not allowed as presentation properties. Note: text-decoration and
         // font-variant are converted to shorthands in CSS 3 but can still be read as a
         // non-shorthand for compatibility with older renders, so they should not be in this list.
-        if (p->id() != SPAttr::FONT && p->id() != SPAttr::MARKER) {
-            p->readAttribute( repr );
+        auto &p = this->*ptr;
+        if (p.id() != SPAttr::FONT && p.id() != SPAttr::MARKER) {
+            p.readAttribute( repr );
         }
     }
 
@@ -759,11 +762,11 @@ SPStyle::write( guint const flags, SPStyleSrc const style_src_req, SPStyle const
     }
 
     Glib::ustring style_string;
-    for(std::vector<SPIBase*>::size_type i = 0; i != _properties.size(); ++i) {
+    for (auto ptr : _prop_helper.get_members()) {
         if( base != nullptr ) {
-            style_string += _properties[i]->write( flags, style_src_req, base->_properties[i] );
+            style_string += (this->*ptr).write( flags, style_src_req, &(base->*ptr) );
         } else {
-            style_string += _properties[i]->write( flags, style_src_req, nullptr );
+            style_string += (this->*ptr).write( flags, style_src_req, nullptr );
         }
     }
 
@@ -819,8 +822,8 @@ Glib::ustring SPStyle::writeIfDiff(SPStyle const *base) const
 void
 SPStyle::cascade( SPStyle const *const parent ) {
     // std::cout << "SPStyle::cascade: " << (object->getId()?object->getId():"null") << std::endl;
-    for(std::vector<SPIBase*>::size_type i = 0; i != _properties.size(); ++i) {
-        _properties[i]->cascade( parent->_properties[i] );
+    for (auto ptr : _prop_helper.get_members()) {
+        (this->*ptr).cascade( &(parent->*ptr) );
     }
 }
 
@@ -845,8 +848,8 @@ SPStyle::cascade( SPStyle const *const parent ) {
 void
 SPStyle::merge( SPStyle const *const parent ) {
     // std::cout << "SPStyle::merge" << std::endl;
-    for(std::vector<SPIBase*>::size_type i = 0; i != _properties.size(); ++i) {
-        _properties[i]->merge( parent->_properties[i] );
+    for (auto ptr : _prop_helper.get_members()) {
+        (this->*ptr).merge( &(parent->*ptr) );
     }
 }
 
@@ -894,8 +897,8 @@ SPStyle::operator==(const SPStyle& rhs) {
     //               << (*_properties[i]  == *rhs._properties[i]) << std::endl;
     // }
 
-    for(std::vector<SPIBase*>::size_type i = 0; i != _properties.size(); ++i) {
-        if( *_properties[i] != *rhs._properties[i]) return false;
+    for (auto ptr : _prop_helper.get_members()) {
+        if( this->*ptr != rhs.*ptr) return false;
     }
     return true;
 }
@@ -1003,7 +1006,7 @@ SPStyle::_mergeObjectStylesheet( SPObject const *const object, SPDocument *const
 
     //XML Tree being directly used here while it shouldn't be.
     CRStatus status =
-        cr_sel_eng_get_matched_properties_from_cascade(sel_eng,
+        document->getSelectorIndex().matchedProperties(sel_eng,
                                                        document->getStyleCascade(),
                                                        object->getRepr(),
                                                        &props);
@@ -86,9 +86,6 @@ public:
     SPDocument *document;
 
 private:
-    /// Pointers to all the properties (for looping through them)
-    std::vector<SPIBase *> _properties;
-
     // Shorthand for better readability
     template <SPAttr Id, class Base>
     using T = TypedSPI<Id, Base>;
@@ -0,0 +1,72 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+/** @file
+ * Locale independent conversions between doubles and their characters.
+ *//*
+ * Authors: see git history
+ *
+ * Copyright (C) 2023 Authors
+ * Released under GNU GPL v2+, read the file 'COPYING' for more information.
+ */
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"  // only include where actually required!
+#endif
+
+#include <cstring>
+#include <string>
+#include <glib.h>
+
+#include "svg/float-chars.h"
+
+char *sp_svg_double_to_chars(char *begin, char *end, double val, std::chars_format format, int precision)
+{
+#ifdef HAVE_FLOAT_CHARCONV
+    auto const result = std::to_chars(begin, end, val, format, precision);
+    return result.ec == std::errc() && result.ptr != end ? result.ptr : nullptr;
+#else
+    char conversion = 'g';
+    if (format == std::chars_format::fixed) {
+        conversion = 'f';
+    } else if (format == std::chars_format::scientific) {
+        conversion = 'e';
+    }
+    char spec[16];
+    g_snprintf(spec, sizeof(spec), "%%.%d%c", precision, conversion);
+    g_ascii_formatd(begin, end - begin, spec, val);
+    auto const length = std::strlen(begin);
+    // A number that fills the buffer may have been cut short.
+    return length + 1 < static_cast<size_t>(end - begin) ? begin + length : nullptr;
+#endif
+}
+
+double sp_svg_double_from_chars(char const *begin, char const *end)
+{
+#ifdef HAVE_FLOAT_CHARCONV
+    // std::from_chars() takes no plus sign, and leaves the value alone if it is out of range.
+    double value = 0;
+    auto const result = std::from_chars(begin + (begin != end && *begin == '+'), end, value);
+    if (result.ec == std::errc() && result.ptr == end) {
+        return value;
+    }
+#endif
+    // g_ascii_strtod() reads up to a null character, and would read on past the range.
+    char buf[64];
+    auto const length = static_cast<size_t>(end - begin);
+    if (length < sizeof(buf)) {
+        std::memcpy(buf, begin, length);
+        buf[length] = '\0';
+        return g_ascii_strtod(buf, nullptr);
+    }
+    return g_ascii_strtod(std::string(begin, end).c_str(), nullptr);
+}
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
@@ -0,0 +1,40 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+/** @file
+ * Locale independent conversions between doubles and their characters, with std::to_chars and
+ * std::from_chars where the standard library has them for floating point numbers.
+ *//*
+ * Authors: see git history
+ *
+ * Copyright (C) 2023 Authors
+ * Released under GNU GPL v2+, read the file 'COPYING' for more information.
+ */
+#ifndef SVG_FLOAT_CHARS_H_SEEN
+#define SVG_FLOAT_CHARS_H_SEEN
+
+#include <charconv>
+
+/**
+ * Write val into [begin, end) as printf() does with the given precision and the conversion of
+ * the format: 'f', 'e' or 'g'. Returns the end of the number, or nullptr if it doesn't fit, which
+ * can also be when it would fill the range exactly.
+ */
+char *sp_svg_double_to_chars(char *begin, char *end, double val, std::chars_format format, int precision);
+
+/**
+ * The value of the number that fills [begin, end), as g_ascii_strtod() reads it. The range need
+ * not be followed by a null character.
+ */
+double sp_svg_double_from_chars(char const *begin, char const *end);
+
+#endif /* !SVG_FLOAT_CHARS_H_SEEN */
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
@@ -12,6 +12,7 @@
  */
 
 #include "svg/path-string.h"
+#include "svg/float-chars.h"
 #include "svg/stringstream.h"
 #include "svg/svg.h"
 #include "preferences.h"
@@ -160,15 +161,14 @@ void PathString::State::appendRelative(Geom::Coord v, Geom::Coord r) {
 }
 
 void PathString::State::appendNumber(double v, int precision, int minexp) {
-
-    str.append(sp_svg_number_write_de(v, precision, minexp));
+    sp_svg_number_append_de(str, v, precision, minexp);
 }
 
 void PathString::State::appendNumber(double v, double &rv) {
     size_t const oldsize = str.size();
     appendNumber(v, _precision, _minexp);
-    char* begin_of_num = const_cast<char*>(str.data()+oldsize); // Slightly evil, I know (but std::string should be storing its data in one big block of memory, so...)
-    sp_svg_number_read_d(begin_of_num, &rv);
+    // The value as it will be read back, which the following relative coordinates are against.
+    rv = sp_svg_double_from_chars(str.data() + oldsize, str.data() + str.size());
 }
 
 }}
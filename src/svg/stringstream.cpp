@@ -8,6 +8,7 @@
  * Released under GNU GPL v2+, read the file 'COPYING' for more information.
  */
 #include "svg/stringstream.h"
+#include "svg/float-chars.h"
 #include "svg/strip-trailing-zeros.h"
 #include "preferences.h"
 #include <2geom/point.h>
@@ -40,6 +41,27 @@ Inkscape::SVGOStringStream::operator<<(double d)
         }
     }
 
+    // What the stream would write with showpoint set, less the trailing zeros, but without
+    // going through a stream and a string for every number.
+    auto format = std::chars_format::general;
+    switch (ostr.flags() & std::ios::floatfield) {
+        case std::ios::fixed:
+            format = std::chars_format::fixed;
+            break;
+        case std::ios::scientific:
+            format = std::chars_format::scientific;
+            break;
+        default:
+            break;
+    }
+    char buf[64];
+    auto const precision = ostr.precision() < 0 ? 6 : static_cast<int>(ostr.precision());
+    if (auto const end = sp_svg_double_to_chars(buf, buf + sizeof(buf), d, format, precision)) {
+        ostr.write(buf, strip_trailing_zeros(buf, end) - buf);
+        return os;
+    }
+
+    // Too long for the buffer, such as fixed notation of large numbers.
     std::ostringstream s;
     s.imbue(std::locale::classic());
     s.flags(os.setf(std::ios::showpoint));
@@ -8,6 +8,7 @@
  * Released under GNU GPL v2+, read the file 'COPYING' for more information.
  */
 
+#include <algorithm>
 #include <cstring>
 #include <string>
 #include <glib.h>
@@ -41,6 +42,24 @@ strip_trailing_zeros(std::string str)
     return str;
 }
 
+char *
+strip_trailing_zeros(char *begin, char *end)
+{
+    auto const point = std::find(begin, end, '.');
+    if (point == end) {
+        return end;
+    }
+    auto const exponent = std::find(point, end, 'e');
+    auto last = exponent;
+    while (last[-1] == '0') {
+        --last;
+    }
+    if (last - 1 == point) {
+        --last;
+    }
+    return std::copy(exponent, end, last);
+}
+
 
 /*
   Local Variables:
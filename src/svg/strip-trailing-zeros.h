@@ -14,6 +14,12 @@
 
 std::string strip_trailing_zeros(std::string str);
 
+/**
+ * Remove the trailing zeros of the fraction of the number in [begin, end), and its point if no
+ * digit is left after it, moving any exponent back. Returns the new end.
+ */
+char *strip_trailing_zeros(char *begin, char *end);
+
 
 #endif /* !SVG_STRIP_TRAILING_ZEROS_H_SEEN */
 
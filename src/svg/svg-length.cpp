@@ -11,26 +11,25 @@
  * Released under GNU GPL v2+, read the file 'COPYING' for more information.
  */
 
+#include <algorithm>
+#include <charconv>
 #include <cmath>
 #include <cstring>
+#include <limits>
 #include <string>
 #include <glib.h>
 #include <iostream>
 #include <vector>
 
 #include "svg.h"
+#include "float-chars.h"
 #include "stringstream.h"
+#include "strip-trailing-zeros.h"
 #include "util/units.h"
 #include "util/numeric/converters.h"
 
-using std::pow;
-
 static unsigned sp_svg_length_read_lff(gchar const *str, SVGLength::Unit *unit, float *val, float *computed, char **next);
 
-#ifndef MAX
-# define MAX(a,b) ((a < b) ? (b) : (a))
-#endif
-
 unsigned int sp_svg_number_read_f(gchar const *str, float *val)
 {
     if (!str) {
@@ -63,80 +62,79 @@ unsigned int sp_svg_number_read_d(gchar const *str, double *val)
     return 1;
 }
 
-static std::string sp_svg_number_write_d( double val, unsigned int tprec, unsigned int fprec)
-{
+namespace {
 
-    std::string buf;
-    /* Process sign */
-    if (val < 0.0) {
-        buf.append("-");
-        val = fabs(val);
-    }
-
-    /* Determine number of integral digits */
-    int idigits = 0;
-    if (val >= 1.0) {
-        idigits = (int) floor(log10(val)) + 1;
-    }
-
-    /* Determine the actual number of fractional digits */
-    fprec = MAX(static_cast<int>(fprec), static_cast<int>(tprec) - idigits);
-    /* Round value */
-    val += 0.5 / pow(10.0, fprec);
-    /* Extract integral and fractional parts */
-    double dival = floor(val);
-    double fval = val - dival;
-    /* Write integra */
-    if (idigits > (int)tprec) {
-        buf.append(std::to_string((unsigned int)floor(dival/pow(10.0, idigits-tprec) + .5)));
-        for(unsigned int j=0; j<(unsigned int)idigits-tprec; j++) {
-            buf.append("0");
-        }
-    } else {
-       buf.append(std::to_string((unsigned int)dival));
-    }
-
-    if (fprec > 0 && fval > 0.0) {
-        std::string s(".");
-        do {
-            fval *= 10.0;
-            dival = floor(fval);
-            fval -= dival;
-            int const int_dival = (int) dival;
-            s.append(std::to_string(int_dival));
-            if(int_dival != 0){
-                buf.append(s);
-                s="";
-            }
-            fprec -= 1;
-        } while(fprec > 0 && fval > 0.0);
-    }
-    return buf;
+/// Write the exponent of a number as SVG has it, without a plus sign or leading zeros.
+char *write_exponent(char *exponent, char *end)
+{
+    auto out = exponent + 1;
+    auto in = out;
+    if (*in == '+') {
+        in++;
+    } else if (*in == '-') {
+        in++;
+        out++;
+    }
+    while (in + 1 < end && *in == '0') {
+        in++;
+    }
+    return std::copy(in, end, out);
 }
 
-std::string sp_svg_number_write_de(double val, unsigned int tprec, int min_exp)
+} // namespace
+
+void sp_svg_number_append_de(std::string &str, double val, unsigned int tprec, int min_exp)
 {
-    std::string buf;
-    int eval = (int)floor(log10(fabs(val)));
+    if (!std::isfinite(val)) {
+        str.append(val != val ? "nan" : val < 0 ? "-inf" : "inf");
+        return;
+    }
+    int const eval = val == 0.0 ? 0 : (int)std::floor(std::log10(std::fabs(val)));
     if (val == 0.0 || eval < min_exp) {
-        buf.append("0");
-        return buf;
+        str += '0';
+        return;
     }
+
+    // Digits beyond those that tell doubles apart would only describe their binary rounding.
+    tprec = std::clamp<unsigned int>(tprec, 1, std::numeric_limits<double>::max_digits10);
+
     unsigned int maxnumdigitsWithoutExp = // This doesn't include the sign because it is included in either representation
         eval<0?tprec+(unsigned int)-eval+1:
         eval+1<(int)tprec?tprec+1:
         (unsigned int)eval+1;
     unsigned int maxnumdigitsWithExp = tprec + ( eval<0 ? 4 : 3 ); // It's not necessary to take larger exponents into account, because then maxnumdigitsWithoutExp is DEFINITELY larger
-    if (maxnumdigitsWithoutExp <= maxnumdigitsWithExp) {
-        buf.append(sp_svg_number_write_d(val, tprec, 0));
+
+    // The conversion rounds correctly, and its worst case is sign, point and exponent besides
+    // twice the digits of the fraction of a small number written without exponent.
+    char buf[2 * std::numeric_limits<double>::max_digits10 + 16];
+    char *end;
+    if (maxnumdigitsWithoutExp > maxnumdigitsWithExp) {
+        end = sp_svg_double_to_chars(buf, buf + sizeof(buf), val, std::chars_format::scientific, tprec - 1);
+        end = strip_trailing_zeros(buf, end);
+        end = write_exponent(std::find(buf, end, 'e'), end);
+    } else if (eval >= (int)tprec) {
+        // More integral digits than significant ones: write the rounded ones and pad with zeros.
+        end = sp_svg_double_to_chars(buf, buf + sizeof(buf), val, std::chars_format::scientific, tprec - 1);
+        auto const exponent = std::find(buf, end, 'e');
+        int digits = 0;
+        std::from_chars(exponent + (exponent[1] == '+' ? 2 : 1), end, digits);
+        end = std::remove(buf, exponent, '.');
+        auto const sign = buf[0] == '-' ? 1 : 0;
+        end = std::fill_n(end, std::max(0, digits + 1 + sign - (int)(end - buf)), '0');
     } else {
-        val = eval < 0 ? val * pow(10.0, -eval) : val / pow(10.0, eval);
-        buf.append(sp_svg_number_write_d(val, tprec, 0));
-        buf.append("e");
-        buf.append(std::to_string(eval));
+        // As many fractional digits as are left, all of them for numbers less than one.
+        int const idigits = eval >= 0 ? eval + 1 : 0;
+        end = sp_svg_double_to_chars(buf, buf + sizeof(buf), val, std::chars_format::fixed, tprec - idigits);
+        end = strip_trailing_zeros(buf, end);
     }
-    return buf;
+    str.append(buf, end);
+}
 
+std::string sp_svg_number_write_de(double val, unsigned int tprec, int min_exp)
+{
+    std::string buf;
+    sp_svg_number_append_de(buf, val, tprec, min_exp);
+    return buf;
 }
 
 SVGLength::SVGLength()
@@ -16,6 +16,7 @@
  * Released under GNU GPL v2+, read the file 'COPYING' for more information.
  */
 
+#include <cmath>
 #include <cstring>
 #include <string>
 #include <glib.h> // g_assert()
@@ -23,12 +24,406 @@
 #include <2geom/pathvector.h>
 #include <2geom/curves.h>
 #include <2geom/sbasis-to-bezier.h>
-#include <2geom/path-sink.h>
-#include <2geom/svg-path-parser.h>
 
 #include "svg/svg.h"
+#include "svg/float-chars.h"
 #include "svg/path-string.h"
 
+namespace {
+
+/**
+ * Reader of SVG path data, which builds the paths of a PathVector directly rather than through
+ * a PathSink, and converts numbers only once their extent is known.
+ *
+ * It gives the same paths as Geom::SVGPathParser with a Z snap threshold of Geom::EPSILON: the
+ * last segment of a subpath is held back until the next command, so that a closepath can snap
+ * its end to the start of the subpath when relative coordinates made them differ slightly. Unlike
+ * it, it keeps that segment when an error follows.
+ */
+class PathDataReader
+{
+public:
+    PathDataReader(char const *str, Geom::PathVector &pathv)
+        : _pos(str)
+        , _end(str + std::strlen(str))
+        , _pathv(pathv)
+    {}
+
+    /// Read all of the path data, returning false if it stopped at an error.
+    bool read();
+
+private:
+    /// A segment not yet added to the path.
+    struct Segment
+    {
+        char type = 0; ///< 'L', 'Q', 'C' or 'A', or 0 for none.
+        Geom::Point points[3];
+        Geom::Coord rx = 0, ry = 0, angle = 0;
+        bool large_arc = false, sweep = false;
+    };
+
+    char const *_pos;
+    char const *_end;
+    Geom::PathVector &_pathv;
+    Geom::Path _path;
+    bool _in_path = false;
+    Segment _segment;
+
+    bool _relative = false;
+    bool _moveto_was_relative = false;
+    Geom::Point _initial;
+    Geom::Point _current;
+    Geom::Point _quad_tangent;
+    Geom::Point _cubic_tangent;
+
+    static bool _isWhitespace(char c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r'; }
+
+    void _skipWhitespace()
+    {
+        while (_pos != _end && _isWhitespace(*_pos)) {
+            ++_pos;
+        }
+    }
+
+    /// Skip whitespace and at most one comma between numbers.
+    void _skipSeparator()
+    {
+        _skipWhitespace();
+        if (_pos != _end && *_pos == ',') {
+            ++_pos;
+            _skipWhitespace();
+        }
+    }
+
+    bool _readNumber(Geom::Coord &value);
+    bool _readCoord(Geom::Coord &value, Geom::Dim2 axis);
+    bool _readPoint(Geom::Point &point);
+    bool _readFlag(bool &flag);
+
+    /// Whether another set of arguments follows, after a separator if it isn't the first.
+    bool _moreArguments(bool first);
+
+    void _flushSegment();
+    void _flushPath();
+    void _moveTo(Geom::Point const &p);
+    void _lineTo(Geom::Point const &p);
+    void _quadTo(Geom::Point const &c, Geom::Point const &p);
+    void _curveTo(Geom::Point const &c0, Geom::Point const &c1, Geom::Point const &p);
+    void _arcTo(Geom::Coord rx, Geom::Coord ry, Geom::Coord angle, bool large_arc, bool sweep, Geom::Point const &p);
+    void _closePath();
+};
+
+bool PathDataReader::_readNumber(Geom::Coord &value)
+{
+    // sign? (digits ('.' digits?)? | '.' digits) (('e' | 'E') sign? digits)?
+    auto p = _pos;
+    auto const is_digit = [&] (char const *q) { return q != _end && *q >= '0' && *q <= '9'; };
+    auto const sign = p != _end && (*p == '+' || *p == '-');
+    if (sign) {
+        ++p;
+    }
+    auto const integral = p;
+    while (is_digit(p)) {
+        ++p;
+    }
+    bool digits = p != integral;
+    if (p != _end && *p == '.') {
+        auto const fraction = ++p;
+        while (is_digit(p)) {
+            ++p;
+        }
+        digits = digits || p != fraction;
+    }
+    if (!digits) {
+        return false;
+    }
+    if (p != _end && (*p == 'e' || *p == 'E')) {
+        auto q = p + 1;
+        if (q != _end && (*q == '+' || *q == '-')) {
+            ++q;
+        }
+        if (is_digit(q)) {
+            while (is_digit(q)) {
+                ++q;
+            }
+            p = q;
+        }
+    }
+
+    value = sp_svg_double_from_chars(_pos, p);
+    _pos = p;
+    return true;
+}
+
+bool PathDataReader::_readCoord(Geom::Coord &value, Geom::Dim2 axis)
+{
+    if (!_readNumber(value)) {
+        return false;
+    }
+    if (_relative) {
+        value += _current[axis];
+    }
+    return true;
+}
+
+bool PathDataReader::_readPoint(Geom::Point &point)
+{
+    if (!_readCoord(point[Geom::X], Geom::X)) {
+        return false;
+    }
+    _skipSeparator();
+    return _readCoord(point[Geom::Y], Geom::Y);
+}
+
+bool PathDataReader::_readFlag(bool &flag)
+{
+    if (_pos == _end || (*_pos != '0' && *_pos != '1')) {
+        return false;
+    }
+    flag = *_pos++ == '1';
+    return true;
+}
+
+bool PathDataReader::_moreArguments(bool first)
+{
+    _skipWhitespace();
+    auto comma = false;
+    if (!first && _pos != _end && *_pos == ',') {
+        comma = true;
+        ++_pos;
+        _skipWhitespace();
+    }
+    if (_pos != _end && (*_pos == '+' || *_pos == '-' || *_pos == '.' || (*_pos >= '0' && *_pos <= '9'))) {
+        return true;
+    }
+    // A comma must be followed by arguments, which the caller then finds missing.
+    return comma;
+}
+
+void PathDataReader::_flushSegment()
+{
+    if (!_segment.type) {
+        return;
+    }
+    auto const &pts = _segment.points;
+    if (!_in_path) {
+        // Drawing on after a closepath starts a new subpath at the same point.
+        _path = Geom::Path(_initial);
+        _in_path = true;
+    }
+    switch (_segment.type) {
+        case 'L':
+            _path.appendNew<Geom::LineSegment>(pts[0]);
+            break;
+        case 'Q':
+            _path.appendNew<Geom::QuadraticBezier>(pts[0], pts[1]);
+            break;
+        case 'C':
+            _path.appendNew<Geom::CubicBezier>(pts[0], pts[1], pts[2]);
+            break;
+        case 'A':
+            _path.appendNew<Geom::EllipticalArc>(_segment.rx, _segment.ry, _segment.angle, _segment.large_arc,
+                                                 _segment.sweep, pts[0]);
+            break;
+    }
+    _segment.type = 0;
+}
+
+void PathDataReader::_flushPath()
+{
+    _flushSegment();
+    if (_in_path) {
+        _pathv.push_back(_path);
+        _in_path = false;
+    }
+}
+
+void PathDataReader::_moveTo(Geom::Point const &p)
+{
+    _flushPath();
+    _path = Geom::Path(p);
+    _in_path = true;
+    _moveto_was_relative = _relative;
+    _quad_tangent = _cubic_tangent = _current = _initial = p;
+}
+
+void PathDataReader::_lineTo(Geom::Point const &p)
+{
+    _flushSegment();
+    _segment.type = 'L';
+    _segment.points[0] = p;
+    _quad_tangent = _cubic_tangent = _current = p;
+}
+
+void PathDataReader::_quadTo(Geom::Point const &c, Geom::Point const &p)
+{
+    _flushSegment();
+    _segment.type = 'Q';
+    _segment.points[0] = c;
+    _segment.points[1] = p;
+    _cubic_tangent = _current = p;
+    _quad_tangent = p + (p - c);
+}
+
+void PathDataReader::_curveTo(Geom::Point const &c0, Geom::Point const &c1, Geom::Point const &p)
+{
+    _flushSegment();
+    _segment.type = 'C';
+    _segment.points[0] = c0;
+    _segment.points[1] = c1;
+    _segment.points[2] = p;
+    _quad_tangent = _current = p;
+    _cubic_tangent = p + (p - c1);
+}
+
+void PathDataReader::_arcTo(Geom::Coord rx, Geom::Coord ry, Geom::Coord angle, bool large_arc, bool sweep,
+                            Geom::Point const &p)
+{
+    if (_current == p) {
+        // The SVG specification says to omit arcs that end where they start.
+        return;
+    }
+    _flushSegment();
+    _segment.type = 'A';
+    _segment.points[0] = p;
+    _segment.rx = std::fabs(rx);
+    _segment.ry = std::fabs(ry);
+    _segment.angle = Geom::rad_from_deg(angle);
+    _segment.large_arc = large_arc;
+    _segment.sweep = sweep;
+    _quad_tangent = _cubic_tangent = _current = p;
+}
+
+void PathDataReader::_closePath()
+{
+    if (_segment.type && (_relative || _moveto_was_relative) && Geom::are_near(_initial, _current, Geom::EPSILON)) {
+        auto const end = _segment.type == 'L' || _segment.type == 'A' ? 0 : _segment.type == 'Q' ? 1 : 2;
+        _segment.points[end] = _initial;
+    }
+    _flushSegment();
+    if (_in_path) {
+        _path.close();
+        _flushPath();
+    }
+    _quad_tangent = _cubic_tangent = _current = _initial;
+}
+
+bool PathDataReader::read()
+{
+    bool ok = true;
+    bool started = false;
+    _skipWhitespace();
+    while (ok && _pos != _end) {
+        char const command = *_pos++;
+        auto const upper = g_ascii_toupper(command);
+        // The first command must be a moveto.
+        if (!started && upper != 'M') {
+            ok = false;
+            break;
+        }
+        started = true;
+
+        if (upper == 'Z') {
+            _closePath();
+            _skipWhitespace();
+            continue;
+        }
+
+        // Every command but closepath takes one or more sets of arguments.
+        _relative = command != upper;
+        int count = 0;
+        for (bool first = true; ok && _moreArguments(first); first = false, count++) {
+            Geom::Point p, c0, c1;
+            Geom::Coord value = 0, rx = 0, ry = 0, angle = 0;
+            bool large_arc = false, sweep = false;
+            switch (upper) {
+                case 'M':
+                    // Further pairs are linetos.
+                    ok = _readPoint(p);
+                    if (ok && first) {
+                        _moveTo(p);
+                    } else if (ok) {
+                        _lineTo(p);
+                    }
+                    break;
+                case 'L':
+                    ok = _readPoint(p);
+                    if (ok) {
+                        _lineTo(p);
+                    }
+                    break;
+                case 'H':
+                case 'V':
+                {
+                    auto const axis = upper == 'H' ? Geom::X : Geom::Y;
+                    ok = _readCoord(value, axis);
+                    if (ok) {
+                        p = _current;
+                        p[axis] = value;
+                        _lineTo(p);
+                    }
+                    break;
+                }
+                case 'C':
+                case 'S':
+                    if (upper == 'C') {
+                        ok = _readPoint(c0);
+                        _skipSeparator();
+                    } else {
+                        c0 = _cubic_tangent;
+                    }
+                    ok = ok && _readPoint(c1);
+                    _skipSeparator();
+                    ok = ok && _readPoint(p);
+                    if (ok) {
+                        _curveTo(c0, c1, p);
+                    }
+                    break;
+                case 'Q':
+                case 'T':
+                    if (upper == 'Q') {
+                        ok = _readPoint(c0);
+                        _skipSeparator();
+                    } else {
+                        c0 = _quad_tangent;
+                    }
+                    ok = ok && _readPoint(p);
+                    if (ok) {
+                        _quadTo(c0, p);
+                    }
+                    break;
+                case 'A':
+                    ok = _readNumber(rx);
+                    _skipSeparator();
+                    ok = ok && _readNumber(ry);
+                    _skipSeparator();
+                    ok = ok && _readNumber(angle);
+                    _skipSeparator();
+                    ok = ok && _readFlag(large_arc);
+                    _skipSeparator();
+                    ok = ok && _readFlag(sweep);
+                    _skipSeparator();
+                    ok = ok && _readPoint(p);
+                    if (ok) {
+                        _arcTo(rx, ry, angle, large_arc, sweep, p);
+                    }
+                    break;
+                default:
+                    ok = false;
+                    break;
+            }
+        }
+        ok = ok && count > 0;
+        _skipWhitespace();
+    }
+
+    // Keep what was read up to an error, as the SVG specification asks.
+    _flushPath();
+    return ok;
+}
+
+} // namespace
+
 /*
  * Parses the path in str. When an error is found in the pathstring, this method
  * returns a truncated path up to where the error was found in the pathstring.
@@ -40,15 +435,7 @@ Geom::PathVector sp_svg_read_pathv(char const * str)
     if (!str)
         return pathv;  // return empty pathvector when str == NULL
 
-    Geom::PathBuilder builder(pathv);
-    Geom::SVGPathParser parser(builder);
-    parser.setZSnapThreshold(Geom::EPSILON);
-
-    try {
-        parser.parse(str);
-    }
-    catch (Geom::SVGPathParseError &e) {
-        builder.flush();
+    if (!PathDataReader(str, pathv).read()) {
         // This warning is extremely annoying when testing
         g_warning(
             "Malformed SVG path, truncated path up to where error was found.\n Input path=\"%s\"\n Parsed path=\"%s\"",
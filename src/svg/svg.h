@@ -37,6 +37,13 @@ unsigned int sp_svg_number_read_d( const char *str, double *val );
  */
 std::string sp_svg_number_write_de( double val, unsigned int tprec, int min_exp );
 
+/*
+ * Append val rounded to tprec significant digits, in the shorter of the plain and the exponent
+ * notation, or 0 if its exponent is less than min_exp. This is what sp_svg_number_write_de()
+ * writes, without a string of its own for every number.
+ */
+void sp_svg_number_append_de( std::string &str, double val, unsigned int tprec, int min_exp );
+
 /* Length */
 
 /*
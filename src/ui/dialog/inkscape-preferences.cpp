@@ -2496,6 +2496,10 @@ void InkscapePreferences::initPageBehavior()
     _page_behavior.add_line( false, _("_Simplification threshold:"), _misc_simpl, "",
                            _("How strong is the Node tool's Simplify command by default. If you invoke this command several times in quick succession, it will act more and more aggressively; invoking it again after a pause restores the default threshold."), false);
 
+    _misc_undo_memory.init("/options/undo/memorylimit", 0.0, 65536.0, 16.0, 64.0, 256.0, true, false);
+    _page_behavior.add_line( false, _("_Undo history size:"), _misc_undo_memory, C_("mebibyte (2^20 bytes) abbreviation","MiB"),
+                           _("Set the amount of memory per document which can be used to store the undo history; the oldest steps are forgotten first. Set to zero for no limit"), false);
+
     _markers_color_stock.init ( _("Color stock markers the same color as object"), "/options/markers/colorStockMarkers", true);
     _markers_color_custom.init ( _("Color custom markers the same color as object"), "/options/markers/colorCustomMarkers", false);
     _markers_color_update.init ( _("Update marker color when object color changes"), "/options/markers/colorUpdateMarkers", true);
@@ -2813,6 +2817,16 @@ void InkscapePreferences::initPageRendering()
     _rendering_cache_size.init("/options/renderingcache/size", 0.0, 4096.0, 1.0, 32.0, 64.0, true, false);
     _page_rendering.add_line( false, _("Rendering _cache size:"), _rendering_cache_size, C_("mebibyte (2^20 bytes) abbreviation","MiB"), _("Set the amount of memory per document which can be used to store rendered parts of the drawing for later reuse; set to zero to disable caching"), false);
 
+    // glyph cache
+    _rendering_glyph_cache_size.init("/options/glyphcache/size", 0.0, 1024.0, 1.0, 4.0, 0.0, true, false);
+    _page_rendering.add_line(false, _("_Glyph cache size:"), _rendering_glyph_cache_size, C_("mebibyte (2^20 bytes) abbreviation","MiB"), _("Set the amount of memory which can be used to keep rendered glyphs, so that plain filled text is composited from them rather than filled from its outlines; glyphs are then placed to a quarter of a pixel. Set to zero to disable it"), false);
+
+    // persistent rendering cache
+    _rendering_disk_cache.init(_("Keep rendered tiles on disk"), "/options/rendering/disk_cache", false);
+    _page_rendering.add_line(false, "", _rendering_disk_cache, "", _("Store rendered parts of saved documents in the user cache directory, so that reopening an unchanged document does not need to render it again"), false);
+    _rendering_disk_cache_size.init("/options/rendering/disk_cache_size", 0.0, 65536.0, 16.0, 256.0, 1024.0, true, false);
+    _page_rendering.add_line(false, _("Disk cache size:"), _rendering_disk_cache_size, C_("mebibyte (2^20 bytes) abbreviation","MiB"), _("Maximum disk space used by stored tiles; the least recently used ones are deleted first"), false);
+
     // rendering x-ray radius
     _rendering_xray_radius.init("/options/rendering/xray-radius", 1.0, 1500.0, 1.0, 100.0, 100.0, true, false);
     _page_rendering.add_line( false, _("X-ray radius:"), _rendering_xray_radius, "", _("Radius of the circular area around the mouse cursor in X-ray mode"), false);
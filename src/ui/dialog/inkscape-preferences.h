@@ -339,6 +339,9 @@ protected:
 
     UI::Widget::PrefSpinButton  _filter_multi_threaded;
     UI::Widget::PrefSpinButton  _rendering_cache_size;
+    UI::Widget::PrefSpinButton  _rendering_glyph_cache_size;
+    UI::Widget::PrefCheckButton _rendering_disk_cache;
+    UI::Widget::PrefSpinButton  _rendering_disk_cache_size;
     UI::Widget::PrefSpinButton  _rendering_xray_radius;
     UI::Widget::PrefSpinButton  _rendering_outline_overlay_opacity;
     UI::Widget::PrefCombo       _canvas_update_strategy;
@@ -438,6 +441,7 @@ protected:
 
     // System page
     UI::Widget::PrefSpinButton  _misc_simpl;
+    UI::Widget::PrefSpinButton  _misc_undo_memory;
     Gtk::Entry                  _sys_user_prefs;
     Gtk::Entry                  _sys_tmp_files;
     Gtk::Entry                  _sys_extension_dir;
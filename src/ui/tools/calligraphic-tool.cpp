@@ -433,7 +433,7 @@ bool CalligraphicTool::root_handler(CanvasEvent const &event)
                         hatch_item = selected;
                         hatch_livarot_path = Path_for_item(hatch_item, true, true);
                         if (hatch_livarot_path) {
-                            hatch_livarot_path->ConvertWithBackData(0.01);
+                            hatch_livarot_path->ConvertWithBackData(0.01, true);
                         }
                     }
 
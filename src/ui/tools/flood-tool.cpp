@@ -374,7 +374,7 @@ static void do_trace(BitmapCoordsInfo const &bci, unsigned char *trace_px, SPDes
 
         if (offset != 0) {
             Shape path_shape;
-            path.ConvertWithBackData(0.03);
+            path.ConvertWithBackData(0.03, true);
             path.Fill(&path_shape, 0);
 
             Shape expanded_path_shape;
@@ -485,7 +485,7 @@ sp_tweak_dilate_recursive (Inkscape::Selection *selection, SPItem *item, Geom::P
             Shape *theRes = new Shape;
             Geom::Affine i2doc(item->i2doc_affine());
 
-            orig->ConvertWithBackData((0.08 - (0.07 * fidelity)) / i2doc.descrim()); // default 0.059
+            orig->ConvertWithBackData((0.08 - (0.07 * fidelity)) / i2doc.descrim(), true); // default 0.059
             orig->Fill(theShape, 0);
 
             SPCSSAttr *css = sp_repr_css_attr(item->getRepr(), "style");
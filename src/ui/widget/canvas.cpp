@@ -54,6 +54,7 @@
 
 #include "canvas/updaters.h"         // Update strategies
 #include "canvas/framecheck.h"       // For frame profiling
+#include "canvas/diskcache.h"        // Persistent tile cache
 #define framecheck_whole_function(D) \
     auto framecheckobj = D->prefs.debug_framecheck ? FrameCheck::Event(__func__) : FrameCheck::Event();
 
@@ -222,6 +223,10 @@ public:
     // Preferences
     Prefs prefs;
 
+    // Persistent tile cache.
+    std::shared_ptr<DiskTileCache> disk_cache;
+    void update_disk_cache();
+
     // Stores
     Stores stores;
     void handle_stores_action(Stores::Action action);
@@ -238,6 +243,7 @@ public:
     // Redraw process management.
     bool redraw_active = false;
     bool redraw_requested = false;
+    bool first_paint_logged = false;
     sigc::connection schedule_redraw_conn;
     void schedule_redraw();
     void launch_redraw();
@@ -355,6 +361,9 @@ Canvas::Canvas()
             d->activate();
         }
     };
+    d->prefs.disk_cache.action = [=] { d->update_disk_cache(); redraw_all(); };
+    d->prefs.disk_cache_size.action = [=] { d->update_disk_cache(); };
+    d->update_disk_cache();
     d->prefs.numthreads.action = [=] {
         if (!d->active) return;
         int const new_numthreads = d->get_numthreads();
@@ -391,6 +400,27 @@ Canvas::Canvas()
     d->sync.connectExit([this] { d->after_redraw(); });
 }
 
+void CanvasPrivate::update_disk_cache()
+{
+    if (!prefs.disk_cache) {
+        // CanvasItemDrawing keeps its own reference until its next update.
+        disk_cache.reset();
+        return;
+    }
+
+    uint64_t const budget = static_cast<uint64_t>(prefs.disk_cache_size) << 20;
+    if (disk_cache) {
+        disk_cache->set_budget(budget);
+    } else {
+        disk_cache = std::make_shared<DiskTileCache>(DiskTileCache::default_directory(), budget);
+    }
+}
+
+std::shared_ptr<DiskTileCache> Canvas::get_disk_cache() const
+{
+    return d->disk_cache;
+}
+
 int CanvasPrivate::get_numthreads() const
 {
     if (int n = prefs.numthreads; n > 0) {
@@ -490,6 +520,7 @@ void Canvas::set_drawing(Drawing *drawing)
 {
     if (d->active && !drawing) d->deactivate();
     _drawing = drawing;
+    d->first_paint_logged = false;
     if (_drawing) {
         _drawing->setRenderMode(_render_mode == RenderMode::OUTLINE_OVERLAY ? RenderMode::NORMAL : _render_mode);
         _drawing->setColorMode(_color_mode);
@@ -698,6 +729,14 @@ void CanvasPrivate::after_redraw()
     } else {
         if (prefs.debug_logging) std::cout << "Redraw exit" << std::endl;
         redraw_active = false;
+
+        if (prefs.debug_logging && !first_paint_logged) {
+            if (auto const render_time = q->_drawing->firstRenderTime()) {
+                std::cout << "Time to first paint: " << *render_time << " s (first update: "
+                          << q->_drawing->firstUpdateTime().value_or(0.0) << " s)" << std::endl;
+                first_paint_logged = true;
+            }
+        }
     }
 }
 
@@ -46,6 +46,7 @@ class Drawing;
 namespace UI::Widget {
 
 class CanvasPrivate;
+class DiskTileCache;
 
 /**
  * A widget for Inkscape's canvas.
@@ -98,6 +99,9 @@ public:
     void set_cms_active(bool active) { _cms_active = active; }
     bool get_cms_active() const { return _cms_active; }
 
+    // Persistent tile cache, or null if disabled.
+    std::shared_ptr<DiskTileCache> get_disk_cache() const;
+
     /* Observers */
 
     // Geometry
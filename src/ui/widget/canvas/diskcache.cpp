@@ -0,0 +1,442 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include <boost/filesystem.hpp> // Using boost::filesystem instead of std::filesystem due to broken C++17 on MacOS.
+#include <fontconfig/fontconfig.h>
+#include <glib.h>
+#include <glibmm/convert.h>
+
+#include "diskcache.h"
+#include "document.h"
+#include "inkscape-version.h"
+#include "display/drawing.h"
+#include "object/uri.h"
+#include "xml/document.h"
+#include "xml/node.h"
+
+namespace fs = boost::filesystem;
+
+namespace Inkscape::UI::Widget {
+
+namespace {
+
+static_assert(std::is_trivially_copyable_v<DiskTileKey>);
+
+// Layout of a tile file: header, followed by the key it was stored under, followed by the rows.
+struct Header
+{
+    char magic[4];
+    uint32_t version;
+    int32_t width, height;
+};
+
+constexpr char magic[4] = { 'I', 'K', 'T', 'C' };
+constexpr uint32_t version = 1;
+
+// FNV-1a, which is stable across platforms and runs, unlike std::hash.
+uint64_t fnv1a(void const *data, size_t size, uint64_t hash = 0xcbf29ce484222325)
+{
+    auto p = static_cast<unsigned char const *>(data);
+    for (size_t i = 0; i < size; i++) {
+        hash ^= p[i];
+        hash *= 0x100000001b3;
+    }
+    return hash;
+}
+
+template <typename T>
+uint64_t fnv1a_value(T const &value, uint64_t hash)
+{
+    static_assert(std::is_trivially_copyable_v<T>);
+    return fnv1a(&value, sizeof(T), hash);
+}
+
+// Budgets beyond the address space, on 32-bit systems, are as good as unlimited.
+std::size_t clamp_budget(uint64_t budget)
+{
+    return static_cast<std::size_t>(std::min<uint64_t>(budget, std::numeric_limits<std::size_t>::max()));
+}
+
+/// Hash the path and modification time of a file or directory, and the size of a file, or return nothing if it is missing.
+std::optional<uint64_t> hash_file(char const *path, uint64_t hash)
+{
+    boost::system::error_code ec;
+    auto const mtime = fs::last_write_time(path, ec);
+    if (ec) {
+        return {};
+    }
+    hash = fnv1a(path, std::strlen(path), hash);
+    hash = fnv1a_value(static_cast<int64_t>(mtime), hash);
+    if (fs::is_regular_file(path, ec)) {
+        auto const size = fs::file_size(path, ec);
+        if (ec) {
+            return {};
+        }
+        hash = fnv1a_value(static_cast<uint64_t>(size), hash);
+    }
+    return hash;
+}
+
+/// Add the targets of the url() references in a CSS value or style sheet.
+void add_css_links(char const *css, std::vector<std::string> &hrefs)
+{
+    for (auto p = std::strstr(css, "url("); p; p = std::strstr(p, "url(")) {
+        p += 4;
+        while (g_ascii_isspace(*p) || *p == '"' || *p == '\'') {
+            p++;
+        }
+        auto end = p;
+        while (*end && *end != ')' && *end != '"' && *end != '\'' && !g_ascii_isspace(*end)) {
+            end++;
+        }
+        hrefs.emplace_back(p, end);
+        p = end;
+    }
+}
+
+/// Add the targets of the links of a node and its descendants: hrefs, url() references and style sheets.
+void add_links(Inkscape::XML::Node const *node, std::vector<std::string> &hrefs)
+{
+    if (node->type() == Inkscape::XML::NodeType::TEXT_NODE) {
+        if (node->parent() && !std::strcmp(node->parent()->name(), "svg:style")) {
+            add_css_links(node->content(), hrefs);
+        }
+        return;
+    }
+    for (auto const &attr : node->attributeList()) {
+        auto const name = g_quark_to_string(attr.key);
+        if (!std::strcmp(name, "xlink:href") || !std::strcmp(name, "href")) {
+            hrefs.emplace_back(attr.value.pointer());
+        } else {
+            add_css_links(attr.value, hrefs);
+        }
+    }
+    for (auto child = node->firstChild(); child; child = child->next()) {
+        add_links(child, hrefs);
+    }
+}
+
+/**
+ * The local files the document links to, or nothing if it links to anything else, such as
+ * resources on the web, whose changes could not be told.
+ */
+std::optional<std::vector<std::string>> linked_files(SPDocument const *document)
+{
+    std::vector<std::string> hrefs;
+    add_links(document->getReprDoc(), hrefs);
+
+    std::vector<std::string> paths;
+    for (auto const &href : hrefs) {
+        if (href.empty() || href[0] == '#' || g_str_has_prefix(href.c_str(), "data:")) {
+            continue;
+        }
+        auto const uri = Inkscape::URI::from_href_and_basedir(href.c_str(), document->getDocumentBase());
+        try {
+            paths.push_back(uri.toNativeFilename());
+        } catch (Glib::ConvertError const &) {
+            return {};
+        }
+    }
+    std::sort(paths.begin(), paths.end());
+    paths.erase(std::unique(paths.begin(), paths.end()), paths.end());
+    return paths;
+}
+
+/**
+ * Hash the font configuration, through the directories and files fontconfig reads, whose
+ * modification times it also uses to tell whether its own caches are current. The fonts are
+ * read once per session, so the hash is too.
+ */
+uint64_t font_config_key()
+{
+    static uint64_t const key = [] {
+        uint64_t hash = 0xcbf29ce484222325;
+        auto const config = FcConfigGetCurrent();
+        for (auto list : { FcConfigGetFontDirs(config), FcConfigGetConfigFiles(config) }) {
+            while (auto name = FcStrListNext(list)) {
+                hash = hash_file(reinterpret_cast<char const *>(name), hash).value_or(hash);
+            }
+            FcStrListDone(list);
+        }
+        return hash;
+    }();
+    return key;
+}
+
+std::string key_to_name(DiskTileKey const &key)
+{
+    std::ostringstream ss;
+    ss << std::hex << std::setw(16) << std::setfill('0') << fnv1a(&key, sizeof(key)) << ".tile";
+    return ss.str();
+}
+
+} // namespace
+
+DiskTileKey DiskTileKey::create(uint64_t document, Geom::Affine const &affine, Geom::IntPoint const &tile,
+                                int device_scale, uint32_t render_mode)
+{
+    DiskTileKey key;
+    std::memset(&key, 0, sizeof(key)); // Keys are hashed and compared bytewise.
+    key.document = document;
+    for (int i = 0; i < 6; i++) {
+        key.affine[i] = affine[i];
+    }
+    key.x = tile.x();
+    key.y = tile.y();
+    key.device_scale = device_scale;
+    key.render_mode = render_mode;
+    return key;
+}
+
+DiskTileCache::DiskTileCache(std::string directory, uint64_t budget)
+    : _directory(std::move(directory))
+    , _tiles(clamp_budget(budget), [this] (std::string const &name, Tile &) {
+        boost::system::error_code ec;
+        fs::remove(_path(name), ec);
+    })
+{
+    boost::system::error_code ec;
+    fs::create_directories(_directory, ec);
+    if (ec) {
+        g_warning("DiskTileCache: Could not create directory %s: %s", _directory.c_str(), ec.message().c_str());
+    }
+
+    _scan();
+}
+
+void DiskTileCache::set_budget(uint64_t budget)
+{
+    _tiles.setBudget(clamp_budget(budget));
+}
+
+bool DiskTileCache::load(DiskTileKey const &key, Cairo::RefPtr<Cairo::ImageSurface> const &surface)
+{
+    auto const name = key_to_name(key);
+
+    if (!_tiles.contains(name)) {
+        return false;
+    }
+
+    std::ifstream file(_path(name), std::ios::binary);
+    Header header;
+    DiskTileKey stored;
+    if (!file.read(reinterpret_cast<char *>(&header), sizeof(header)) ||
+        !file.read(reinterpret_cast<char *>(&stored), sizeof(stored)))
+    {
+        return false;
+    }
+
+    if (std::memcmp(header.magic, magic, sizeof(magic)) != 0 || header.version != version ||
+        header.width != surface->get_width() || header.height != surface->get_height() ||
+        std::memcmp(&stored, &key, sizeof(key)) != 0)
+    {
+        return false;
+    }
+
+    surface->flush();
+    auto const data = surface->get_data();
+    auto const stride = surface->get_stride();
+    auto const row_bytes = header.width * 4;
+    for (int y = 0; y < header.height; y++) {
+        if (!file.read(reinterpret_cast<char *>(data + y * stride), row_bytes)) {
+            return false;
+        }
+    }
+    surface->mark_dirty();
+    file.close();
+
+    // Record the access on disk too, so that the order survives into the next session.
+    boost::system::error_code ec;
+    fs::last_write_time(_path(name), std::time(nullptr), ec);
+
+    _tiles.touch(name);
+
+    return true;
+}
+
+void DiskTileCache::store(DiskTileKey const &key, Cairo::RefPtr<Cairo::ImageSurface> const &surface)
+{
+    Header header;
+    std::memcpy(header.magic, magic, sizeof(magic));
+    header.version = version;
+    header.width = surface->get_width();
+    header.height = surface->get_height();
+
+    auto const row_bytes = header.width * 4;
+    auto const size = sizeof(header) + sizeof(key) + static_cast<std::size_t>(row_bytes) * header.height;
+    if (size > _tiles.budget()) {
+        return;
+    }
+
+    auto const name = key_to_name(key);
+    auto const path = _path(name);
+
+    surface->flush();
+    auto const data = surface->get_data();
+    auto const stride = surface->get_stride();
+
+    // Write to a temporary file first, so that concurrent readers never see a partial tile.
+    auto const tmp_path = path + "." + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+    {
+        std::ofstream file(tmp_path, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<char const *>(&header), sizeof(header));
+        file.write(reinterpret_cast<char const *>(&key), sizeof(key));
+        for (int y = 0; y < header.height; y++) {
+            file.write(reinterpret_cast<char const *>(data + y * stride), row_bytes);
+        }
+        if (!file) {
+            file.close();
+            boost::system::error_code ec;
+            fs::remove(tmp_path, ec);
+            return;
+        }
+    }
+
+    boost::system::error_code ec;
+    fs::rename(tmp_path, path, ec);
+    if (ec) {
+        fs::remove(tmp_path, ec);
+        return;
+    }
+
+    _tiles.insert(name, {}, size);
+}
+
+std::optional<uint64_t> DiskTileCache::document_key(SPDocument const *document)
+{
+    if (!document || document->isModifiedSinceSave()) {
+        return {};
+    }
+
+    auto const filename = document->getDocumentFilename();
+    if (!filename) {
+        return {};
+    }
+
+    // The path, size and modification time of the file stand in for a hash of its contents,
+    // which would be too expensive to compute for the large documents this cache is meant for.
+    auto const file_key = hash_file(filename, 0xcbf29ce484222325);
+    if (!file_key) {
+        return {};
+    }
+
+    // The links are only looked for again once the file changed, but the files are checked each time.
+    std::optional<LinkedFiles> linked;
+    {
+        auto lock = std::lock_guard(_mutex);
+        if (_linked && _linked->file_key == *file_key) {
+            linked = _linked;
+        }
+    }
+    if (!linked) {
+        linked = LinkedFiles{ *file_key, linked_files(document) };
+        auto lock = std::lock_guard(_mutex);
+        _linked = linked;
+    }
+    if (!linked->paths) {
+        return {};
+    }
+
+    auto hash = fnv1a(Inkscape::version_string, std::strlen(Inkscape::version_string), *file_key);
+    for (auto const &path : *linked->paths) {
+        if (auto const linked = hash_file(path.c_str(), hash)) {
+            hash = *linked;
+        } else {
+            hash = fnv1a(path.data(), path.size(), hash); // Missing, as it was when it was drawn.
+        }
+    }
+    hash = fnv1a_value(font_config_key(), hash);
+    return hash;
+}
+
+uint32_t DiskTileCache::render_key(Drawing const &drawing, bool outline_pass)
+{
+    auto hash = fnv1a_value(static_cast<int>(drawing.renderMode()), 0xcbf29ce484222325);
+    hash = fnv1a_value(static_cast<int>(drawing.colorMode()), hash);
+    hash = fnv1a_value(drawing.outlineOverlay(), hash);
+    hash = fnv1a_value(drawing.clipOutlineColor(), hash);
+    hash = fnv1a_value(drawing.maskOutlineColor(), hash);
+    hash = fnv1a_value(drawing.imageOutlineColor(), hash);
+    hash = fnv1a_value(drawing.imageOutlineMode(), hash);
+    hash = fnv1a_value(drawing.filterQuality(), hash);
+    hash = fnv1a_value(drawing.blurQuality(), hash);
+    hash = fnv1a_value(drawing.useDithering(), hash);
+    hash = fnv1a_value(drawing.clipped(), hash);
+    hash = fnv1a_value(static_cast<int>(drawing.antialiasingOverride().value_or(static_cast<Antialiasing>(-1))), hash);
+    hash = fnv1a_value(outline_pass, hash);
+    return static_cast<uint32_t>(hash ^ (hash >> 32));
+}
+
+std::string DiskTileCache::default_directory()
+{
+    auto path = g_build_filename(g_get_user_cache_dir(), "inkscape", "tiles", nullptr);
+    std::string result = path;
+    g_free(path);
+    return result;
+}
+
+void DiskTileCache::_scan()
+{
+    struct Found
+    {
+        std::time_t mtime;
+        std::string name;
+        uint64_t size;
+    };
+    std::vector<Found> found;
+
+    boost::system::error_code ec;
+    for (auto it = fs::directory_iterator(_directory, ec); !ec && it != fs::directory_iterator(); it.increment(ec)) {
+        auto const &path = it->path();
+        if (path.extension() != ".tile") {
+            // Leftover from an interrupted store.
+            if (path.extension() == ".tmp") {
+                fs::remove(path, ec);
+            }
+            continue;
+        }
+        boost::system::error_code ec2;
+        auto const size = fs::file_size(path, ec2);
+        auto const mtime = fs::last_write_time(path, ec2);
+        if (!ec2) {
+            found.push_back({ mtime, path.filename().string(), size });
+        }
+    }
+
+    // Oldest first, so that the tiles used last end up most recently used, and the oldest ones
+    // are deleted if they exceed the budget.
+    std::sort(found.begin(), found.end(), [] (Found const &a, Found const &b) { return a.mtime < b.mtime; });
+
+    for (auto &f : found) {
+        if (f.size > _tiles.budget()) {
+            fs::remove(_path(f.name), ec);
+            continue;
+        }
+        _tiles.insert(std::move(f.name), {}, static_cast<std::size_t>(f.size));
+    }
+}
+
+std::string DiskTileCache::_path(std::string const &name) const
+{
+    return (fs::path(_directory) / name).string();
+}
+
+} // namespace Inkscape::UI::Widget
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4 :
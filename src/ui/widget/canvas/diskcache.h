@@ -0,0 +1,124 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+/** @file
+ * Persistent, content-addressed cache of rendered drawing tiles.
+ */
+/*
+ * Copyright (C) 2023 Authors
+ * Released under GNU GPL v2+, read the file 'COPYING' for more information.
+ */
+
+#ifndef INKSCAPE_UI_WIDGET_CANVAS_DISKCACHE_H
+#define INKSCAPE_UI_WIDGET_CANVAS_DISKCACHE_H
+
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+#include <2geom/affine.h>
+#include <2geom/int-point.h>
+#include <cairomm/surface.h>
+
+#include "util/lru-cache.h"
+
+class SPDocument;
+
+namespace Inkscape {
+
+class Drawing;
+
+namespace UI::Widget {
+
+/**
+ * Everything that determines the pixels of a tile of the drawing.
+ */
+struct DiskTileKey
+{
+    uint64_t document;      ///< Identifies the document contents, see DiskTileCache::document_key().
+    double affine[6];       ///< Document to world transform, which includes the zoom level.
+    int32_t x, y;           ///< Tile coordinates, in units of DiskTileCache::tile_size world pixels.
+    int32_t device_scale;
+    uint32_t render_mode;   ///< Hash of the render settings, see DiskTileCache::render_key().
+
+    static DiskTileKey create(uint64_t document, Geom::Affine const &affine, Geom::IntPoint const &tile,
+                              int device_scale, uint32_t render_mode);
+};
+
+/**
+ * A size-bounded cache of rendered tiles of the drawing, stored as files in the user cache
+ * directory so that they survive between sessions. Tiles lie on a fixed grid in world space,
+ * so that the same view produces the same keys regardless of how the canvas splits its redraws.
+ *
+ * The least recently used tiles are deleted once the total size exceeds the budget.
+ */
+class DiskTileCache
+{
+public:
+    static int constexpr tile_size = 256;
+
+    DiskTileCache(std::string directory, uint64_t budget);
+
+    /// Change the size budget in bytes, evicting tiles if necessary.
+    void set_budget(uint64_t budget);
+
+    /**
+     * Fill the given ARGB32 surface with the cached contents of the tile, if present.
+     * @return Whether the tile was found and its dimensions matched the surface.
+     */
+    bool load(DiskTileKey const &key, Cairo::RefPtr<Cairo::ImageSurface> const &surface);
+
+    /// Store the contents of an ARGB32 surface as the given tile.
+    void store(DiskTileKey const &key, Cairo::RefPtr<Cairo::ImageSurface> const &surface);
+
+    /**
+     * Return a key identifying the contents of the document, or nothing if it has none
+     * that can be identified across sessions (unsaved, modified since it was last saved, or
+     * linking to resources other than local files).
+     *
+     * Besides the file, the key covers the Inkscape version, the files the document links to,
+     * such as images and the documents of external references, and the font configuration.
+     */
+    std::optional<uint64_t> document_key(SPDocument const *document);
+
+    /// Return a hash of the drawing settings that affect its rendering.
+    static uint32_t render_key(Drawing const &drawing, bool outline_pass);
+
+    /// Return the default directory for the cache.
+    static std::string default_directory();
+
+private:
+    /// The tiles are the files; the cache only keeps their names and sizes.
+    struct Tile {};
+
+    /// The local files a saved document links to, or nothing if it links to other resources.
+    struct LinkedFiles
+    {
+        uint64_t file_key;
+        std::optional<std::vector<std::string>> paths;
+    };
+
+    std::string _directory;
+    Util::LRUCache<std::string, Tile> _tiles; ///< Keyed by file name.
+
+    std::mutex _mutex;
+    std::optional<LinkedFiles> _linked; ///< Of the last document, found again only once it is saved.
+
+    void _scan();
+    std::string _path(std::string const &name) const;
+};
+
+} // namespace UI::Widget
+} // namespace Inkscape
+
+#endif // INKSCAPE_UI_WIDGET_CANVAS_DISKCACHE_H
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4 :
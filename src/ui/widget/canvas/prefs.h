@@ -22,6 +22,8 @@ public:
     Pref<bool>   request_opengl           = { "/options/rendering/request_opengl" };
     Pref<int>    grabsize                 = { "/options/grabsize/value", 3, 1, 15 };
     Pref<int>    numthreads               = { "/options/threading/numthreads", 0, 1, 256 };
+    Pref<bool>   disk_cache               = { "/options/rendering/disk_cache" };
+    Pref<int>    disk_cache_size          = { "/options/rendering/disk_cache_size", 1024, 0, 1 << 20 }; // MiB
 
     // Colour management
     Pref<bool>   use_user_profile         = { "/options/displayprofile/use_user_profile" };
@@ -55,6 +55,13 @@ public:
 	 */
 	virtual void notifyUndoCommitEvent(Event* log) = 0;
 
+	/**
+	 * Triggered when the oldest event is dropped from the undo log to limit its memory use.
+	 *
+	 * \param log Pointer to the Event being dropped, which is deleted afterwards.
+	 */
+	virtual void notifyUndoExpiredEvent(Event* log) = 0;
+
 	/**
 	 * Triggered when the undo log is cleared.
 	 */
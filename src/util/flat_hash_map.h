@@ -0,0 +1,203 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+/** @file
+ * A hash map with open addressing, for large lookup tables of small values.
+ */
+/*
+ * Copyright (C) 2023 Authors
+ *
+ * Released under GNU GPL v2+, read the file 'COPYING' for more information.
+ */
+#ifndef INKSCAPE_UTIL_FLAT_HASH_MAP_H
+#define INKSCAPE_UTIL_FLAT_HASH_MAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace Inkscape {
+namespace Util {
+
+/**
+ * Transparent string hash, allowing a flat_hash_map<std::string, ...> to be queried with a
+ * std::string_view or a C string without constructing a std::string.
+ */
+struct string_hash
+{
+    using is_transparent = void;
+    std::size_t operator()(std::string_view s) const { return std::hash<std::string_view>()(s); }
+};
+
+/**
+ * A flat_hash_map<Tk, Tv> stores its entries in a single array using linear probing, so that a
+ * lookup touches one or two cache lines rather than following a chain of tree or bucket nodes.
+ * The hash of each entry is stored alongside it, so that probing rarely needs to compare keys
+ * and growing the table never rehashes them.
+ *
+ * Heterogeneous lookup is supported: find(), contains() and erase() accept any type that both
+ * Hash and Equal accept, e.g. std::string_view with string_hash and std::equal_to<>.
+ *
+ * Unlike std::unordered_map, insertion and erasure move other entries, so pointers to values
+ * are invalidated by any modification. Both key and value types must be default-constructible.
+ */
+template <typename Tk, typename Tv, typename Hash = std::hash<Tk>, typename Equal = std::equal_to<Tk>>
+class flat_hash_map
+{
+public:
+    bool empty() const { return _size == 0; }
+    std::size_t size() const { return _size; }
+
+    void clear()
+    {
+        _slots.clear();
+        _size = 0;
+        _shift = 64;
+    }
+
+    /**
+     * Insert a new entry, unless one with the same key already exists.
+     * @return Whether the entry was inserted.
+     */
+    template <typename K>
+    bool insert(K &&key, Tv value)
+    {
+        auto const hash = _hash(key);
+        if (_find(key, hash) != npos) {
+            return false;
+        }
+        if ((_size + 1) * 8 > _slots.size() * 7) {
+            _grow();
+        }
+        _place({hash, Tk(std::forward<K>(key)), std::move(value)});
+        _size++;
+        return true;
+    }
+
+    /// Return a pointer to the value for the given key, or null if there is none.
+    template <typename K>
+    Tv *find(K const &key)
+    {
+        auto const i = _find(key, _hash(key));
+        return i == npos ? nullptr : &_slots[i].value;
+    }
+
+    template <typename K>
+    Tv const *find(K const &key) const
+    {
+        return const_cast<flat_hash_map *>(this)->find(key);
+    }
+
+    template <typename K>
+    bool contains(K const &key) const { return find(key); }
+
+    /**
+     * Remove the entry with the given key.
+     * @return Whether there was such an entry.
+     */
+    template <typename K>
+    bool erase(K const &key)
+    {
+        auto i = _find(key, _hash(key));
+        if (i == npos) {
+            return false;
+        }
+
+        // Backward-shift deletion: move later entries of the probe sequence into the hole,
+        // so that no tombstones are needed and lookups stay short.
+        auto const mask = _slots.size() - 1;
+        for (auto j = (i + 1) & mask; _slots[j].hash; j = (j + 1) & mask) {
+            auto const home = _home(_slots[j].hash);
+            if (((j - home) & mask) >= ((j - i) & mask)) {
+                _slots[i] = std::move(_slots[j]);
+                i = j;
+            }
+        }
+        _slots[i] = Slot();
+        _size--;
+        return true;
+    }
+
+private:
+    struct Slot
+    {
+        std::uint64_t hash = 0; ///< Zero marks an empty slot.
+        Tk key = {};
+        Tv value = {};
+    };
+
+    static constexpr std::size_t npos = -1;
+
+    std::vector<Slot> _slots; ///< Size is zero or a power of two.
+    std::size_t _size = 0;
+    unsigned _shift = 64;     ///< 64 - log2 of the number of slots.
+
+    template <typename K>
+    static std::uint64_t _hash(K const &key)
+    {
+        // Fibonacci hashing spreads hashes whose entropy is in their high bits, such as pointers
+        // under the identity hash, over the whole table. Never return the empty marker.
+        auto const h = static_cast<std::uint64_t>(Hash()(key)) * 0x9e3779b97f4a7c15ull;
+        return h ? h : 1;
+    }
+
+    std::size_t _home(std::uint64_t hash) const { return hash >> _shift; }
+
+    template <typename K>
+    std::size_t _find(K const &key, std::uint64_t hash) const
+    {
+        if (_slots.empty()) {
+            return npos;
+        }
+        auto const mask = _slots.size() - 1;
+        for (auto i = _home(hash); _slots[i].hash; i = (i + 1) & mask) {
+            if (_slots[i].hash == hash && Equal()(_slots[i].key, key)) {
+                return i;
+            }
+        }
+        return npos;
+    }
+
+    void _place(Slot &&slot)
+    {
+        auto const mask = _slots.size() - 1;
+        auto i = _home(slot.hash);
+        while (_slots[i].hash) {
+            i = (i + 1) & mask;
+        }
+        _slots[i] = std::move(slot);
+    }
+
+    void _grow()
+    {
+        auto old = std::move(_slots);
+        _slots = std::vector<Slot>(old.empty() ? 16 : old.size() * 2);
+        _shift = 64;
+        for (auto n = _slots.size(); n > 1; n /= 2) {
+            _shift--;
+        }
+        for (auto &slot : old) {
+            if (slot.hash) {
+                _place(std::move(slot));
+            }
+        }
+    }
+};
+
+} // namespace Util
+} // namespace Inkscape
+
+#endif // INKSCAPE_UTIL_FLAT_HASH_MAP_H
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4 :
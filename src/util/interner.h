@@ -0,0 +1,145 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+/** @file
+ * A thread-safe pool of immutable values shared by everyone asking for an equal key.
+ */
+/*
+ * Authors: see git history
+ *
+ * Copyright (C) 2023 Authors
+ *
+ * Released under GNU GPL v2+, read the file 'COPYING' for more information.
+ */
+#ifndef INKSCAPE_UTIL_INTERNER_H
+#define INKSCAPE_UTIL_INTERNER_H
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+
+namespace Inkscape {
+namespace Util {
+
+/**
+ * An Interner<Key, Value> hands out one std::shared_ptr<Value const> per key to everyone asking
+ * for that key while any of them still holds it, so that equal values are stored and made once.
+ * A value is forgotten as soon as its last holder lets go of it; nothing is kept for later.
+ *
+ * With the default Value = Key the keys themselves are interned, and only stored once. Keys of
+ * type std::string are looked up through a std::string_view, so looking up a C string does not
+ * copy it.
+ *
+ * All member functions are thread-safe. The values call back into the interner when they are
+ * released, so it must outlive them; interners shared by all documents are best created with new
+ * and never destroyed, as documents and styles may still be destroyed during static destruction.
+ */
+template <typename Key, typename Value = Key>
+class Interner
+{
+public:
+    using KeyView = std::conditional_t<std::is_same_v<Key, std::string>, std::string_view, Key>;
+
+    /**
+     * Return the value for key, calling make() to make it unless someone holds it already.
+     */
+    template <typename Make>
+    std::shared_ptr<Value const> intern(KeyView key, Make const &make)
+    {
+        auto lock = std::lock_guard(_mutex);
+        if (auto it = _entries.find(key); it != _entries.end()) {
+            if (auto entry = it->second.lock()) {
+                return {entry, &entry->value()};
+            }
+            // Its last holder is about to release it.
+            _entries.erase(it);
+        }
+        auto entry = std::shared_ptr<Entry>(_make_entry(key, make), [this] (Entry *entry) {
+            _release(entry);
+        });
+        _entries.emplace(entry->key, entry);
+        return {entry, &entry->value()};
+    }
+
+    /**
+     * Return the interned copy of key.
+     */
+    std::shared_ptr<Key const> intern(KeyView key)
+    {
+        static_assert(std::is_same_v<Key, Value>);
+        return intern(key, [] {});
+    }
+
+    /**
+     * Call f(key, references) for every key whose value is held, with the number of shared_ptrs
+     * holding it.
+     */
+    template <typename F>
+    void for_each(F const &f)
+    {
+        auto lock = std::lock_guard(_mutex);
+        for (auto const &[key, entry] : _entries) {
+            if (auto const references = entry.use_count()) {
+                f(key, references);
+            }
+        }
+    }
+
+private:
+    struct SeparateEntry
+    {
+        Key key;
+        Value val;
+        Value const &value() const { return val; }
+    };
+
+    struct KeyEntry
+    {
+        Key key;
+        Key const &value() const { return key; }
+    };
+
+    using Entry = std::conditional_t<std::is_same_v<Key, Value>, KeyEntry, SeparateEntry>;
+
+    template <typename Make>
+    static Entry *_make_entry(KeyView key, Make const &make)
+    {
+        if constexpr (std::is_same_v<Key, Value>) {
+            return new Entry{Key(key)};
+        } else {
+            return new Entry{Key(key), make()};
+        }
+    }
+
+    void _release(Entry *entry)
+    {
+        {
+            auto lock = std::lock_guard(_mutex);
+            // Unless it was replaced by an equal value meanwhile.
+            if (auto it = _entries.find(entry->key); it != _entries.end() && it->second.expired()) {
+                _entries.erase(it);
+            }
+        }
+        delete entry;
+    }
+
+    std::mutex _mutex;
+    std::unordered_map<KeyView, std::weak_ptr<Entry>> _entries;
+};
+
+} // namespace Util
+} // namespace Inkscape
+
+#endif // INKSCAPE_UTIL_INTERNER_H
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
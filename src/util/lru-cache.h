@@ -0,0 +1,223 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+/** @file
+ * A thread-safe cache that discards its least recently used entries to stay within a budget.
+ */
+/*
+ * Authors: see git history
+ *
+ * Copyright (C) 2023 Authors
+ *
+ * Released under GNU GPL v2+, read the file 'COPYING' for more information.
+ */
+#ifndef INKSCAPE_UTIL_LRU_CACHE_H
+#define INKSCAPE_UTIL_LRU_CACHE_H
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace Inkscape {
+namespace Util {
+
+/**
+ * An LRUCache<Key, Value> maps keys to values, each of a size given when it is inserted. Once the
+ * total size exceeds the budget, the least recently used entries are discarded, after being
+ * passed to the eviction callback if there is one.
+ *
+ * The cache counts the hits and misses of visit() in its statistics.
+ *
+ * All member functions are thread-safe. The callbacks are called with the cache locked, so they
+ * must not call back into it.
+ */
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class LRUCache
+{
+public:
+    static std::size_t constexpr default_budget = 8 << 20;
+
+    using EvictFunc = std::function<void(Key const &, Value &)>;
+
+    explicit LRUCache(std::size_t budget = default_budget, EvictFunc on_evict = {})
+        : _budget(budget)
+        , _on_evict(std::move(on_evict))
+    {
+    }
+
+    LRUCache(LRUCache const &) = delete;
+    LRUCache &operator=(LRUCache const &) = delete;
+
+    /**
+     * Call f(value) with the value of the key if it is cached, making it the most recently used.
+     *
+     * @return Whether the key was found.
+     */
+    template <typename F>
+    bool visit(Key const &key, F const &f)
+    {
+        auto lock = std::lock_guard(_mutex);
+        auto it = _index.find(key);
+        if (it == _index.end()) {
+            _statistics.misses++;
+            return false;
+        }
+        _lru.splice(_lru.begin(), _lru, it->second);
+        f(std::as_const(it->second->value));
+        _statistics.hits++;
+        return true;
+    }
+
+    /// Return whether the key is cached, without counting it or making it more recently used.
+    bool contains(Key const &key) const
+    {
+        auto lock = std::lock_guard(_mutex);
+        return _index.find(key) != _index.end();
+    }
+
+    /// Make the key the most recently used, if it is cached.
+    void touch(Key const &key)
+    {
+        auto lock = std::lock_guard(_mutex);
+        if (auto it = _index.find(key); it != _index.end()) {
+            _lru.splice(_lru.begin(), _lru, it->second);
+        }
+    }
+
+    /**
+     * Cache a value as the most recently used, replacing any value of the same key without
+     * passing it to the eviction callback. Values larger than the whole budget are not cached.
+     */
+    void insert(Key key, Value value, std::size_t size)
+    {
+        auto lock = std::lock_guard(_mutex);
+        if (size > _budget) {
+            return;
+        }
+        if (auto it = _index.find(key); it != _index.end()) {
+            _total -= it->second->size;
+            auto const entry = it->second;
+            _index.erase(it);
+            _lru.erase(entry);
+        }
+        _lru.push_front({std::move(key), std::move(value), size});
+        _index.emplace(_lru.front().key, _lru.begin());
+        _total += size;
+        _evict();
+    }
+
+    /// Count a lookup of something that cannot be cached as a miss.
+    void countMiss()
+    {
+        auto lock = std::lock_guard(_mutex);
+        _statistics.misses++;
+    }
+
+    struct Statistics
+    {
+        std::size_t hits = 0;
+        std::size_t misses = 0;
+
+        double hitRate() const { return hits + misses ? static_cast<double>(hits) / (hits + misses) : 0.0; }
+    };
+
+    Statistics statistics() const
+    {
+        auto lock = std::lock_guard(_mutex);
+        return _statistics;
+    }
+
+    void resetStatistics()
+    {
+        auto lock = std::lock_guard(_mutex);
+        _statistics = {};
+    }
+
+    std::size_t budget() const
+    {
+        auto lock = std::lock_guard(_mutex);
+        return _budget;
+    }
+
+    /// Change the budget, evicting entries if necessary.
+    void setBudget(std::size_t bytes)
+    {
+        auto lock = std::lock_guard(_mutex);
+        _budget = bytes;
+        _evict();
+    }
+
+    /// The total size of the cached values.
+    std::size_t size() const
+    {
+        auto lock = std::lock_guard(_mutex);
+        return _total;
+    }
+
+    /// Discard all entries, without passing them to the eviction callback.
+    void clear()
+    {
+        auto lock = std::lock_guard(_mutex);
+        _index.clear();
+        _lru.clear();
+        _total = 0;
+    }
+
+private:
+    struct Entry
+    {
+        Key key;
+        Value value;
+        std::size_t size;
+    };
+
+    using KeyRef = std::reference_wrapper<Key const>;
+
+    struct KeyRefHash
+    {
+        std::size_t operator()(KeyRef key) const { return Hash()(key.get()); }
+    };
+
+    struct KeyRefEqual
+    {
+        bool operator()(KeyRef a, KeyRef b) const { return a.get() == b.get(); }
+    };
+
+    mutable std::mutex _mutex;
+    std::size_t _budget;
+    std::size_t _total = 0;
+    EvictFunc _on_evict;
+    Statistics _statistics;
+    std::list<Entry> _lru; ///< Most recently used first.
+    std::unordered_map<KeyRef, typename std::list<Entry>::iterator, KeyRefHash, KeyRefEqual> _index; ///< Keys point into _lru.
+
+    void _evict()
+    {
+        while (_total > _budget && !_lru.empty()) {
+            auto &entry = _lru.back();
+            if (_on_evict) {
+                _on_evict(entry.key, entry.value);
+            }
+            _total -= entry.size;
+            _index.erase(entry.key);
+            _lru.pop_back();
+        }
+    }
+};
+
+} // namespace Util
+} // namespace Inkscape
+
+#endif // INKSCAPE_UTIL_LRU_CACHE_H
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
@@ -15,7 +15,14 @@
  */
 
 #include <glib.h> // g_assert()
+#include <algorithm>
 #include <cstdio>
+#include <cstring>
+#include <map>
+#include <string>
+#include <utility>
+
+#include <zlib.h>
 
 #include "event.h"
 #include "event-fns.h"
@@ -166,7 +173,12 @@ void Inkscape::XML::EventDel::_undoOne(
 void Inkscape::XML::EventChgAttr::_undoOne(
     Inkscape::XML::NodeObserver &observer
 ) const {
-    observer.notifyAttributeChanged(*this->repr, this->key, this->newval, this->oldval);
+    if (_compact) {
+        auto const [oldfull, newfull] = _expand();
+        observer.notifyAttributeChanged(*this->repr, this->key, newfull, oldfull);
+    } else {
+        observer.notifyAttributeChanged(*this->repr, this->key, this->newval, this->oldval);
+    }
 }
 
 void Inkscape::XML::EventChgContent::_undoOne(
@@ -234,7 +246,104 @@ void Inkscape::XML::EventDel::_replayOne(
 void Inkscape::XML::EventChgAttr::_replayOne(
     Inkscape::XML::NodeObserver &observer
 ) const {
-    observer.notifyAttributeChanged(*this->repr, this->key, this->oldval, this->newval);
+    if (_compact) {
+        auto const [oldfull, newfull] = _expand();
+        observer.notifyAttributeChanged(*this->repr, this->key, oldfull, newfull);
+    } else {
+        observer.notifyAttributeChanged(*this->repr, this->key, this->oldval, this->newval);
+    }
+}
+
+namespace {
+
+/// Values shorter than this together are not worth compacting.
+std::size_t constexpr COMPACT_THRESHOLD = 256;
+
+std::size_t length(Inkscape::Util::ptr_shared value)
+{
+    return value ? std::strlen(value.pointer()) : 0;
+}
+
+}
+
+void Inkscape::XML::EventChgAttr::compact()
+{
+    if (_compact || !this->oldval || !this->newval) {
+        return;
+    }
+
+    char const *oldstr = this->oldval.pointer();
+    char const *newstr = this->newval.pointer();
+    std::size_t const oldlen = std::strlen(oldstr);
+    std::size_t const newlen = std::strlen(newstr);
+    if (oldlen + newlen < COMPACT_THRESHOLD) {
+        return;
+    }
+
+    std::size_t const maxlen = std::min(oldlen, newlen);
+    std::size_t prefix = 0;
+    while (prefix < maxlen && oldstr[prefix] == newstr[prefix]) {
+        prefix++;
+    }
+    std::size_t suffix = 0;
+    while (suffix < maxlen - prefix && oldstr[oldlen - 1 - suffix] == newstr[newlen - 1 - suffix]) {
+        suffix++;
+    }
+
+    // The new value is kept whole but deflated, and the old one as what differs from it, so
+    // that the event does not depend on the attribute still having the value it left.
+    auto compressed = std::string(compressBound(newlen), '\0');
+    auto compressed_len = static_cast<uLongf>(compressed.size());
+    if (compress2(reinterpret_cast<Bytef *>(compressed.data()), &compressed_len,
+                  reinterpret_cast<Bytef const *>(newstr), newlen, Z_BEST_SPEED) != Z_OK)
+    {
+        return;
+    }
+    compressed.resize(compressed_len);
+
+    // Only bother if it saves at least half of the memory.
+    if (2 * (compressed.size() + oldlen - prefix - suffix) > oldlen + newlen) {
+        return;
+    }
+
+    compressed.shrink_to_fit();
+    _deflated = std::move(compressed);
+    _newlen = newlen;
+    this->oldval = Inkscape::Util::share_string(oldstr + prefix, oldlen - prefix - suffix);
+    this->newval = Inkscape::Util::ptr_shared();
+    _prefix = prefix;
+    _suffix = suffix;
+    _compact = true;
+}
+
+std::size_t Inkscape::XML::EventChgAttr::compactSize() const
+{
+    return _deflated.size();
+}
+
+/**
+ * The whole values before and after the change of a compacted attribute.
+ */
+std::pair<Inkscape::Util::ptr_shared, Inkscape::Util::ptr_shared> Inkscape::XML::EventChgAttr::_expand() const
+{
+    auto newstr = std::string(_newlen, '\0');
+    auto len = static_cast<uLongf>(_newlen);
+    if (uncompress(reinterpret_cast<Bytef *>(newstr.data()), &len,
+                   reinterpret_cast<Bytef const *>(_deflated.data()), _deflated.size()) != Z_OK || len != _newlen)
+    {
+        g_critical("Compacted undo history of attribute %s is corrupt", g_quark_to_string(this->key));
+        auto current = Inkscape::Util::share_unsafe(this->repr->attribute(g_quark_to_string(this->key)));
+        return {current, current};
+    }
+
+    std::string oldstr;
+    oldstr.reserve(_prefix + length(this->oldval) + _suffix);
+    oldstr.append(newstr, 0, _prefix);
+    oldstr.append(this->oldval.pointer());
+    oldstr.append(newstr, _newlen - _suffix, _suffix);
+
+    return {Inkscape::Util::share_string(oldstr.data(), oldstr.size()),
+            Inkscape::Util::share_string(newstr.data(), newstr.size())};
 }
 
 void Inkscape::XML::EventChgContent::_replayOne(
@@ -281,6 +390,63 @@ sp_repr_coalesce_log (Inkscape::XML::Event *a, Inkscape::XML::Event *b)
     return b;
 }
 
+Inkscape::XML::Event *
+sp_repr_optimize_log (Inkscape::XML::Event *log)
+{
+    /* changes of the same attribute within a run of attribute changes can be
+     * combined, as the changes of other attributes in between do not depend on them */
+    std::map<std::pair<Inkscape::XML::Node *, GQuark>, Inkscape::XML::EventChgAttr *> latest;
+
+    Inkscape::XML::Event **prev_ptr = &log;
+    while (Inkscape::XML::Event *action = *prev_ptr) {
+        auto chg_attr = dynamic_cast<Inkscape::XML::EventChgAttr *>(action);
+        if (!chg_attr || chg_attr->isCompact()) {
+            latest.clear();
+            prev_ptr = &action->next;
+            continue;
+        }
+
+        auto const [it, inserted] = latest.emplace(std::make_pair(chg_attr->repr, chg_attr->key), chg_attr);
+        if (inserted) {
+            prev_ptr = &action->next;
+            continue;
+        }
+
+        /* replace the later action's oldval with ours, and discard us */
+        it->second->oldval = chg_attr->oldval;
+        *prev_ptr = action->next;
+        delete action;
+    }
+
+    return log;
+}
+
+void
+sp_repr_compact_log (Inkscape::XML::Event *log)
+{
+    for (Inkscape::XML::Event *action = log; action; action = action->next) {
+        if (auto chg_attr = dynamic_cast<Inkscape::XML::EventChgAttr *>(action)) {
+            chg_attr->compact();
+        }
+    }
+}
+
+std::size_t
+sp_repr_log_memory (Inkscape::XML::Event const *log)
+{
+    std::size_t result = 0;
+    for (Inkscape::XML::Event const *action = log; action; action = action->next) {
+        if (auto chg_attr = dynamic_cast<Inkscape::XML::EventChgAttr const *>(action)) {
+            result += sizeof(*chg_attr) + length(chg_attr->oldval) + length(chg_attr->newval) + chg_attr->compactSize();
+        } else if (auto chg_content = dynamic_cast<Inkscape::XML::EventChgContent const *>(action)) {
+            result += sizeof(*chg_content) + length(chg_content->oldval) + length(chg_content->newval);
+        } else {
+            result += sizeof(Inkscape::XML::EventChgOrder); // the largest of the other events
+        }
+    }
+    return result;
+}
+
 void
 sp_repr_free_log (Inkscape::XML::Event *log)
 {
@@ -343,8 +509,8 @@ Inkscape::XML::Event *Inkscape::XML::EventDel::_optimizeOne() {
 Inkscape::XML::Event *Inkscape::XML::EventChgAttr::_optimizeOne() {
     Inkscape::XML::EventChgAttr *chg_attr=dynamic_cast<Inkscape::XML::EventChgAttr *>(this->next);
 
-    /* consecutive chgattrs on the same key can be combined */
-    if ( chg_attr) {
+    /* consecutive chgattrs on the same key can be combined, unless compacted */
+    if ( chg_attr && !this->_compact && !chg_attr->_compact ) {
         if ( chg_attr->repr == this->repr &&
              chg_attr->key == this->key )
         {
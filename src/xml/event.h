@@ -16,7 +16,10 @@
 typedef unsigned int GQuark;
 #include <glibmm/ustring.h>
 
+#include <cstddef>
 #include <iterator>
+#include <string>
+#include <utility>
 #include "util/share.h"
 #include "util/forward-pointer-iterator.h"
 #include "inkgc/gc-managed.h"
@@ -170,12 +173,35 @@ public:
 
     /// GQuark corresponding to the changed attribute's name
     GQuark key;
-    /// Value of the attribute before the change
+    /// Value of the attribute before the change, or only its changed part if the event is compacted
     Inkscape::Util::ptr_shared oldval;
-    /// Value of the attribute after the change
+    /// Value of the attribute after the change, or null if the event is compacted
     Inkscape::Util::ptr_shared newval;
 
+    /**
+     * @brief Store the values in less memory, if they are long
+     *
+     * The value after the change is kept deflated, and of the value before it only the part that
+     * differs. Both are restored from these when the event is undone or replayed, whatever the
+     * attribute was set to in the meantime.
+     */
+    void compact();
+    /// Whether compact() has stripped the values
+    bool isCompact() const { return _compact; }
+    /// Size of the deflated value after the change, if compacted
+    std::size_t compactSize() const;
+
 private:
+    /// Length of the start and end that the values had in common, if compacted
+    std::size_t _prefix = 0;
+    std::size_t _suffix = 0;
+    /// The value after the change, if compacted
+    std::string _deflated;
+    std::size_t _newlen = 0;
+    bool _compact = false;
+
+    std::pair<Inkscape::Util::ptr_shared, Inkscape::Util::ptr_shared> _expand() const;
+
     Event *_optimizeOne() override;
     void _undoOne(NodeObserver &observer) const override;
     void _replayOne(NodeObserver &observer) const override;
@@ -14,9 +14,12 @@
 #include <cstring>
 #include <string>
 #include <stdexcept>
+#include <utility>
+#include <vector>
 
 #include <libxml/parser.h>
 #include <libxml/xinclude.h>
+#include <libxml/xmlreader.h>
 
 #include "xml/repr.h"
 #include "xml/attribute-record.h"
@@ -48,8 +51,11 @@ using Inkscape::XML::AttributeVector;
 using Inkscape::XML::rebase_href_attrs;
 
 Document *sp_repr_do_read (xmlDocPtr doc, const gchar *default_ns);
+static Document *sp_repr_do_read_stream (xmlTextReaderPtr reader, const gchar *default_ns);
+static void sp_repr_fixup_root (Node *root, const gchar *default_ns);
 static Node *sp_repr_svg_read_node (Document *xml_doc, xmlNodePtr node, const gchar *default_ns, std::map<std::string, std::string> &prefix_map);
 static gint sp_repr_qualified_name (gchar *p, gint len, xmlNsPtr ns, const xmlChar *name, const gchar *default_ns, std::map<std::string, std::string> &prefix_map);
+static gint sp_repr_qualified_name (gchar *p, gint len, const xmlChar *ns_href, const xmlChar *ns_prefix, const xmlChar *name, std::map<std::string, std::string> &prefix_map);
 static void sp_repr_write_stream_root_element(Node *repr, Writer &out,
                                               bool add_whitespace, gchar const *default_ns,
                                               int inlineattrs, int indent,
@@ -93,6 +99,7 @@ public:
     int setFile( char const * filename );
 
     xmlDocPtr readXml();
+    xmlTextReaderPtr readXmlStream(bool xinclude);
 
     static int readCb( void * context, char * buffer, int len );
     static int closeCb( void * context );
@@ -101,6 +108,8 @@ public:
     int read( char * buffer, int len );
     int close();
 private:
+    static int parseOptions();
+
     const char* filename;
     char* encoding;
     FILE* fp;
@@ -170,7 +179,7 @@ int XmlSource::setFile(char const *filename)
     return retVal;
 }
 
-xmlDocPtr XmlSource::readXml()
+int XmlSource::parseOptions()
 {
     int parse_options = XML_PARSE_HUGE | XML_PARSE_RECOVER;
 
@@ -178,7 +187,25 @@ xmlDocPtr XmlSource::readXml()
     bool allowNetAccess = prefs->getBool("/options/externalresources/xml/allow_net_access", false);
     if (!allowNetAccess) parse_options |= XML_PARSE_NONET;
 
-    return xmlReadIO(readCb, closeCb, this, filename, getEncoding(), parse_options);
+    return parse_options;
+}
+
+xmlDocPtr XmlSource::readXml()
+{
+    return xmlReadIO(readCb, closeCb, this, filename, getEncoding(), parseOptions());
+}
+
+/**
+ * Returns a reader that parses the source incrementally. The source must outlive the reader.
+ */
+xmlTextReaderPtr XmlSource::readXmlStream(bool xinclude)
+{
+    int parse_options = parseOptions();
+    if (xinclude) {
+        parse_options |= XML_PARSE_XINCLUDE | XML_PARSE_NOXINCNODE;
+    }
+
+    return xmlReaderForIO(readCb, closeCb, this, filename, getEncoding(), parse_options);
 }
 
 int XmlSource::readCb( void * context, char * buffer, int len )
@@ -318,6 +345,44 @@ Document *sp_repr_read_file (const gchar * filename, const gchar *default_ns, bo
     return rdoc;
 }
 
+/**
+ * Reads XML from a file like sp_repr_read_file(), but builds the Document directly while parsing,
+ * rather than first building a complete libxml2 tree and then copying it. Only the nodes on the
+ * path to the current one are held by libxml2 at any time, so peak memory use during loading is
+ * about the size of the resulting Document instead of twice that.
+ */
+Document *sp_repr_read_file_stream (const gchar * filename, const gchar *default_ns, bool xinclude)
+{
+    Document * rdoc = nullptr;
+
+    xmlSubstituteEntitiesDefault(1);
+
+    g_return_val_if_fail(filename != nullptr, NULL);
+    if (!Inkscape::IO::file_test(filename, G_FILE_TEST_EXISTS)) {
+        g_warning("Can't open file: %s (doesn't exist)", filename);
+        return nullptr;
+    }
+
+    // As in sp_repr_read_file(), refuse names that cannot be converted to the file name encoding.
+    gchar *localFilename = g_filename_from_utf8(filename, -1, nullptr, nullptr, nullptr);
+    g_return_val_if_fail(localFilename != nullptr, NULL);
+    g_free(localFilename);
+
+    Inkscape::IO::dump_fopen_call(filename, "N");
+
+    XmlSource src;
+
+    if (src.setFile(filename) == 0) {
+        xmlTextReaderPtr reader = src.readXmlStream(xinclude);
+        if (reader) {
+            rdoc = sp_repr_do_read_stream(reader, default_ns);
+            xmlFreeTextReader(reader);
+        }
+    }
+
+    return rdoc;
+}
+
 /**
  * Reads and parses XML from a buffer, returning it as an Document
  */
@@ -468,49 +533,213 @@ Document *sp_repr_do_read (xmlDocPtr doc, const gchar *default_ns)
     }
 
     if (root != nullptr) {
-        /* promote elements of some XML documents that don't use namespaces
-         * into their default namespace */
-        if (!strcmp(root->name(), "ns:svg") || !strcmp(root->name(), "svg0:svg")) {
-            g_warning("Detected broken namespace \"%s\" in the SVG file, attempting to work around it", root->name());
-            repair_namespace(root, "svg");
-        } else if ( default_ns && !strchr(root->name(), ':') ) {
-            if ( !strcmp(default_ns, SP_SVG_NS_URI) ) {
-                promote_to_namespace(root, "svg");
+        sp_repr_fixup_root(root, default_ns);
+    }
+
+    return rdoc;
+}
+
+/**
+ * Reads XML from a stream to create a Document, building it node by node as the reader
+ * advances. The result is the same as that of sp_repr_do_read() on the complete tree.
+ */
+static Document *sp_repr_do_read_stream (xmlTextReaderPtr reader, const gchar *default_ns)
+{
+    std::map<std::string, std::string> prefix_map;
+
+    Document *rdoc = new Inkscape::XML::SimpleDocument();
+
+    // Open elements, along with whether xml:space="preserve" is in effect for their content.
+    std::vector<std::pair<Node *, bool>> open;
+
+    Node *root = nullptr;
+    bool has_element = false;
+    gchar c[256];
+
+    int ret;
+    while ((ret = xmlTextReaderRead(reader)) == 1) {
+        int const type = xmlTextReaderNodeType(reader);
+        Node *parent = open.empty() ? nullptr : open.back().first;
+        Node *repr = nullptr;
+
+        switch (type) {
+            case XML_READER_TYPE_ELEMENT: {
+                if (!parent && has_element) {
+                    // Same as sp_repr_do_read(): a document with several roots has none.
+                    root = nullptr;
+                    ret = 0;
+                    break;
+                }
+
+                sp_repr_qualified_name(c, 256, xmlTextReaderConstNamespaceUri(reader), xmlTextReaderConstPrefix(reader),
+                                       xmlTextReaderConstLocalName(reader), prefix_map);
+                repr = rdoc->createElement(c);
+
+                bool preserve = parent && open.back().second;
+                bool const empty = xmlTextReaderIsEmptyElement(reader);
+
+                while (xmlTextReaderMoveToNextAttribute(reader) == 1) {
+                    if (xmlTextReaderIsNamespaceDecl(reader)) {
+                        continue;
+                    }
+                    auto const ns_href = xmlTextReaderConstNamespaceUri(reader);
+                    auto const name = xmlTextReaderConstLocalName(reader);
+                    auto const value = reinterpret_cast<const gchar *>(xmlTextReaderConstValue(reader));
+                    if (!value || !*value) {
+                        // Like sp_repr_svg_read_node(), which skips attributes without children.
+                        continue;
+                    }
+                    sp_repr_qualified_name(c, 256, ns_href, xmlTextReaderConstPrefix(reader), name, prefix_map);
+                    repr->setAttribute(c, value);
+
+                    // Mirrors xmlNodeGetSpacePreserve().
+                    if (ns_href && xmlStrEqual(ns_href, XML_XML_NAMESPACE) && xmlStrEqual(name, BAD_CAST "space") && value) {
+                        if (!strcmp(value, "preserve")) {
+                            preserve = true;
+                        } else if (!strcmp(value, "default")) {
+                            preserve = false;
+                        }
+                    }
+                }
+                xmlTextReaderMoveToElement(reader);
+
+                if (!parent) {
+                    root = repr;
+                    has_element = true;
+                }
+                if (!empty) {
+                    open.emplace_back(repr, preserve);
+                }
+                break;
             }
-            if ( !strcmp(default_ns, INKSCAPE_EXTENSION_URI) ) {
-                promote_to_namespace(root, INKSCAPE_EXTENSION_NS_NC);
+
+            case XML_READER_TYPE_END_ELEMENT:
+                if (!open.empty()) {
+                    open.pop_back();
+                }
+                break;
+
+            case XML_READER_TYPE_TEXT:
+            case XML_READER_TYPE_CDATA:
+            case XML_READER_TYPE_WHITESPACE:
+            case XML_READER_TYPE_SIGNIFICANT_WHITESPACE: {
+                auto const content = xmlTextReaderConstValue(reader);
+                if (!parent || content == nullptr || *content == '\0') {
+                    break;
+                }
+
+                // See sp_repr_svg_read_node() for the handling of white space.
+                bool const preserve = open.back().second;
+                const xmlChar *p;
+                for (p = content; *p && g_ascii_isspace (*p) && !preserve; p++)
+                    ; // skip all whitespace
+
+                if (!(*p)) {
+                    break;
+                }
+
+                repr = rdoc->createTextNode(reinterpret_cast<const gchar *>(content), type == XML_READER_TYPE_CDATA);
+                break;
             }
-        }
 
+            case XML_READER_TYPE_COMMENT:
+                repr = rdoc->createComment(reinterpret_cast<const gchar *>(xmlTextReaderConstValue(reader)));
+                break;
+
+            case XML_READER_TYPE_PROCESSING_INSTRUCTION:
+                repr = rdoc->createPI(reinterpret_cast<const gchar *>(xmlTextReaderConstName(reader)),
+                                      reinterpret_cast<const gchar *>(xmlTextReaderConstValue(reader)));
+                break;
+
+            case XML_READER_TYPE_ENTITY_REFERENCE: {
+                // Unexpanded entities become elements, as they do in sp_repr_svg_read_node().
+                if (!parent) {
+                    break;
+                }
+                repr = rdoc->createElement(reinterpret_cast<const gchar *>(xmlTextReaderConstName(reader)));
+                xmlNodePtr node = xmlTextReaderCurrentNode(reader);
+                if (node && node->content) {
+                    repr->setContent(reinterpret_cast<gchar *>(node->content));
+                }
+                break;
+            }
+
+            default:
+                break;
+        }
 
-        // Clean unnecessary attributes and style properties from SVG documents. (Controlled by
-        // preferences.)  Note: internal Inkscape svg files will also be cleaned (filters.svg,
-        // icons.svg). How can one tell if a file is internal?
-        if ( !strcmp(root->name(), "svg:svg" ) ) {
-            Inkscape::Preferences *prefs = Inkscape::Preferences::get();
-            bool clean = prefs->getBool("/options/svgoutput/check_on_reading");
-            if( clean ) {
-                sp_attribute_clean_tree( root );
+        if (repr) {
+            if (parent) {
+                parent->appendChild(repr);
+            } else {
+                rdoc->appendChild(repr);
             }
+            Inkscape::GC::release(repr);
+        }
+
+        if (ret != 1) {
+            break;
         }
     }
 
+    if (!has_element) {
+        // Nothing usable was read, either because the file is empty or because of a parse error.
+        Inkscape::GC::release(rdoc);
+        return nullptr;
+    }
+
+    if (root != nullptr) {
+        sp_repr_fixup_root(root, default_ns);
+    }
+
     return rdoc;
 }
 
-gint sp_repr_qualified_name (gchar *p, gint len, xmlNsPtr ns, const xmlChar *name, const gchar */*default_ns*/, std::map<std::string, std::string> &prefix_map)
+/**
+ * Post-processing of the root element of a freshly read document.
+ */
+static void sp_repr_fixup_root (Node *root, const gchar *default_ns)
 {
-    const xmlChar *prefix;
-    if (ns){
-        if (ns->href ) {
-            prefix = reinterpret_cast<const xmlChar*>( sp_xml_ns_uri_prefix(reinterpret_cast<const gchar*>(ns->href),
-                                                                            reinterpret_cast<const char*>(ns->prefix)) );
-            prefix_map[reinterpret_cast<const char*>(prefix)] = reinterpret_cast<const char*>(ns->href);
+    /* promote elements of some XML documents that don't use namespaces
+     * into their default namespace */
+    if (!strcmp(root->name(), "ns:svg") || !strcmp(root->name(), "svg0:svg")) {
+        g_warning("Detected broken namespace \"%s\" in the SVG file, attempting to work around it", root->name());
+        repair_namespace(root, "svg");
+    } else if ( default_ns && !strchr(root->name(), ':') ) {
+        if ( !strcmp(default_ns, SP_SVG_NS_URI) ) {
+            promote_to_namespace(root, "svg");
         }
-        else {
-            prefix = nullptr;
+        if ( !strcmp(default_ns, INKSCAPE_EXTENSION_URI) ) {
+            promote_to_namespace(root, INKSCAPE_EXTENSION_NS_NC);
         }
     }
+
+
+    // Clean unnecessary attributes and style properties from SVG documents. (Controlled by
+    // preferences.)  Note: internal Inkscape svg files will also be cleaned (filters.svg,
+    // icons.svg). How can one tell if a file is internal?
+    if ( !strcmp(root->name(), "svg:svg" ) ) {
+        Inkscape::Preferences *prefs = Inkscape::Preferences::get();
+        bool clean = prefs->getBool("/options/svgoutput/check_on_reading");
+        if( clean ) {
+            sp_attribute_clean_tree( root );
+        }
+    }
+}
+
+gint sp_repr_qualified_name (gchar *p, gint len, xmlNsPtr ns, const xmlChar *name, const gchar */*default_ns*/, std::map<std::string, std::string> &prefix_map)
+{
+    return sp_repr_qualified_name(p, len, ns ? ns->href : nullptr, ns ? ns->prefix : nullptr, name, prefix_map);
+}
+
+gint sp_repr_qualified_name (gchar *p, gint len, const xmlChar *ns_href, const xmlChar *ns_prefix, const xmlChar *name, std::map<std::string, std::string> &prefix_map)
+{
+    const xmlChar *prefix;
+    if (ns_href) {
+        prefix = reinterpret_cast<const xmlChar*>( sp_xml_ns_uri_prefix(reinterpret_cast<const gchar*>(ns_href),
+                                                                        reinterpret_cast<const char*>(ns_prefix)) );
+        prefix_map[reinterpret_cast<const char*>(prefix)] = reinterpret_cast<const char*>(ns_href);
+    }
     else {
         prefix = nullptr;
     }
@@ -0,0 +1,152 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+/** @file
+ * Benchmark of the id and repr indexes of SPDocument.
+ *
+ * Usage: benchmark_id-index [--runs N] [--elements N]
+ *
+ * Times std::map against Inkscape::Util::flat_hash_map on the lookups SPDocument does, then
+ * the load of a generated document in which every other element references an earlier one by
+ * id. The latter number is meant to be compared between builds before and after a change.
+ */
+/*
+ * Copyright (C) 2023 Authors
+ * Released under GNU GPL v2+, read the file 'COPYING' for more information.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <giomm/init.h>
+#include <glib/gstdio.h>
+#include <glibmm/miscutils.h>
+
+#include "document.h"
+#include "inkgc/gc-core.h"
+#include "util/flat_hash_map.h"
+
+namespace {
+
+template <typename F>
+double median_ms(int runs, F &&f)
+{
+    std::vector<double> times;
+    for (int i = 0; i < runs; i++) {
+        auto const start = std::chrono::steady_clock::now();
+        f();
+        times.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    }
+    std::sort(times.begin(), times.end());
+    return times[times.size() / 2];
+}
+
+std::string generate(int elements)
+{
+    auto const filename = Glib::build_filename(Glib::get_tmp_dir(), "inkscape-id-index-benchmark.svg");
+    std::ofstream out(filename);
+    out << "<svg xmlns=\"http://www.w3.org/2000/svg\" xmlns:xlink=\"http://www.w3.org/1999/xlink\">\n";
+    for (int i = 0; i < elements; i++) {
+        if (i % 2 == 0) {
+            out << "<rect id=\"rect" << i << "\" x=\"" << i % 1000 << "\" y=\"" << i / 1000 << "\" width=\"1\" height=\"1\"/>\n";
+        } else {
+            out << "<use id=\"use" << i << "\" xlink:href=\"#rect" << i / 2 * 2 << "\"/>\n";
+        }
+    }
+    out << "</svg>\n";
+    return filename;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    int runs = 5;
+    int elements = 200000;
+
+    for (int i = 1; i < argc; i++) {
+        if (!std::strcmp(argv[i], "--runs") && i + 1 < argc) {
+            runs = std::max(1, std::atoi(argv[++i]));
+        } else if (!std::strcmp(argv[i], "--elements") && i + 1 < argc) {
+            elements = std::max(1, std::atoi(argv[++i]));
+        } else {
+            std::printf("Usage: %s [--runs N] [--elements N]\n", argv[0]);
+            return std::strcmp(argv[i], "--help") ? 1 : 0;
+        }
+    }
+
+    Gio::init();
+    Inkscape::GC::init();
+
+    std::vector<std::string> ids, hrefs;
+    for (int i = 0; i < elements; i++) {
+        ids.push_back("path" + std::to_string(i));
+        hrefs.push_back("#" + ids.back());
+    }
+    std::vector<std::unique_ptr<int>> nodes(elements);
+
+    std::printf("%d ids, %d runs\n", elements, runs);
+    std::printf("%-40s %12s\n", "operation", "median [ms]");
+
+    std::size_t found = 0;
+    auto const map_ms = median_ms(runs, [&] {
+        std::map<std::string, void *> iddef;
+        std::map<int *, void *> reprdef;
+        for (int i = 0; i < elements; i++) {
+            iddef.emplace(ids[i], nullptr);
+            reprdef.emplace(nodes[i].get(), nullptr);
+        }
+        for (auto const &href : hrefs) {
+            found += iddef.count(href.substr(1)); // as SPDocument::getObjectByHref() did
+        }
+        for (auto const &node : nodes) {
+            found += reprdef.count(node.get());
+        }
+    });
+    std::printf("%-40s %12.1f\n", "std::map insert + lookup", map_ms);
+
+    auto const hash_ms = median_ms(runs, [&] {
+        Inkscape::Util::flat_hash_map<std::string, void *, Inkscape::Util::string_hash, std::equal_to<>> iddef;
+        Inkscape::Util::flat_hash_map<int *, void *> reprdef;
+        for (int i = 0; i < elements; i++) {
+            iddef.insert(ids[i], nullptr);
+            reprdef.insert(nodes[i].get(), nullptr);
+        }
+        for (auto const &href : hrefs) {
+            found += iddef.contains(std::string_view(href).substr(1));
+        }
+        for (auto const &node : nodes) {
+            found += reprdef.contains(node.get());
+        }
+    });
+    std::printf("%-40s %12.1f\n", "flat_hash_map insert + lookup", hash_ms);
+
+    auto const filename = generate(elements);
+    auto const load_ms = median_ms(runs, [&] {
+        auto doc = std::unique_ptr<SPDocument>(SPDocument::createNewDoc(filename.c_str(), false));
+        found += doc && doc->getObjectById("rect0");
+    });
+    std::printf("%-40s %12.1f\n", "SPDocument::createNewDoc", load_ms);
+    g_remove(filename.c_str());
+
+    // Keep the lookups from being optimised away.
+    return found ? 0 : 1;
+}
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4 :
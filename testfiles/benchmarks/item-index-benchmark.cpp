@@ -0,0 +1,177 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+/** @file
+ * Benchmark of the area queries of SPDocument.
+ *
+ * Usage: benchmark_item-index [--runs N] [--elements N]
+ *
+ * Loads a generated floor plan of rooms, each a group of a few rectangles, and times
+ * SPDocument::getItemsPartiallyInBox(), which uses the spatial index, against a walk over every
+ * item like the one it replaced, for boxes the size of a typical rubber band selection.
+ */
+/*
+ * Copyright (C) 2023 Authors
+ * Released under GNU GPL v2+, read the file 'COPYING' for more information.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <giomm/init.h>
+#include <glib/gstdio.h>
+#include <glibmm/miscutils.h>
+#include <2geom/rect.h>
+
+#include "document.h"
+#include "inkscape.h"
+#include "inkgc/gc-core.h"
+#include "object/sp-item-group.h"
+#include "object/sp-root.h"
+
+namespace {
+
+int constexpr room_size = 100;
+int constexpr items_per_room = 5;
+
+template <typename F>
+double median_ms(int runs, F &&f)
+{
+    std::vector<double> times;
+    for (int i = 0; i < runs; i++) {
+        auto const start = std::chrono::steady_clock::now();
+        f();
+        times.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    }
+    std::sort(times.begin(), times.end());
+    return times[times.size() / 2];
+}
+
+std::string generate(int rooms, int columns)
+{
+    auto const filename = Glib::build_filename(Glib::get_tmp_dir(), "inkscape-item-index-benchmark.svg");
+    std::ofstream out(filename);
+    out << "<svg xmlns=\"http://www.w3.org/2000/svg\" xmlns:inkscape=\"http://www.inkscape.org/namespaces/inkscape\">\n"
+        << "<g id=\"layer1\" inkscape:groupmode=\"layer\">\n";
+    for (int i = 0; i < rooms; i++) {
+        out << "<g id=\"room" << i << "\" transform=\"translate(" << i % columns * room_size << "," << i / columns * room_size << ")\">\n"
+            << "<rect width=\"100\" height=\"100\" style=\"fill:none;stroke:#000\"/>\n";
+        for (int j = 1; j < items_per_room; j++) {
+            out << "<rect x=\"" << j * 15 << "\" y=\"" << j * 10 << "\" width=\"10\" height=\"20\"/>\n";
+        }
+        out << "</g>\n";
+    }
+    out << "</g>\n</svg>\n";
+    return filename;
+}
+
+// The walk SPDocument::getItemsPartiallyInBox() used to do, for the default arguments.
+void walk(std::vector<SPItem *> &result, SPGroup *group, Geom::Rect const &area)
+{
+    for (auto &child : group->children) {
+        if (auto item = cast<SPItem>(&child)) {
+            if (item->isLocked() || item->isHidden()) {
+                continue;
+            }
+            if (auto childgroup = cast<SPGroup>(item)) {
+                if (childgroup->effectiveLayerMode(0) == SPGroup::LAYER) {
+                    walk(result, childgroup, area);
+                    continue;
+                }
+            }
+            if (auto box = item->documentVisualBounds(); box && area.intersects(*box)) {
+                result.push_back(item);
+            }
+        }
+    }
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    int runs = 5;
+    int elements = 200000;
+
+    for (int i = 1; i < argc; i++) {
+        if (!std::strcmp(argv[i], "--runs") && i + 1 < argc) {
+            runs = std::max(1, std::atoi(argv[++i]));
+        } else if (!std::strcmp(argv[i], "--elements") && i + 1 < argc) {
+            elements = std::max(items_per_room, std::atoi(argv[++i]));
+        } else {
+            std::printf("Usage: %s [--runs N] [--elements N]\n", argv[0]);
+            return std::strcmp(argv[i], "--help") ? 1 : 0;
+        }
+    }
+
+    Gio::init();
+    Inkscape::GC::init();
+    Inkscape::Application::create(false);
+
+    int const rooms = elements / items_per_room;
+    int const columns = std::max(1, static_cast<int>(std::sqrt(rooms)));
+    auto const filename = generate(rooms, columns);
+    auto doc = std::unique_ptr<SPDocument>(SPDocument::createNewDoc(filename.c_str(), false));
+    g_remove(filename.c_str());
+    if (!doc) {
+        std::fprintf(stderr, "Failed to load the generated document\n");
+        return 1;
+    }
+    doc->ensureUpToDate();
+
+    std::printf("%d items in %d rooms, %d runs\n", rooms * items_per_room, rooms, runs);
+    std::printf("%-40s %12s %10s\n", "operation", "median [ms]", "results");
+
+    std::size_t found = 0;
+    auto const first_ms = median_ms(1, [&] {
+        found = doc->getItemsPartiallyInBox(0, Geom::Rect(0, 0, 1, 1)).size();
+    });
+    std::printf("%-40s %12.2f %10zu\n", "first query (builds index)", first_ms, found);
+
+    for (int size : {1, 10, 100}) {
+        // A box of size x size rooms in the middle of the plan.
+        auto const origin = Geom::Point(columns / 2, rooms / columns / 2) * room_size;
+        auto const area = Geom::Rect(origin, origin + Geom::Point(size, size) * room_size);
+
+        auto const walk_ms = median_ms(runs, [&] {
+            std::vector<SPItem *> result;
+            walk(result, doc->getRoot(), area);
+            found = result.size();
+        });
+        std::printf("%-40s %12.2f %10zu\n", ("walk, " + std::to_string(size) + "x" + std::to_string(size) + " rooms").c_str(), walk_ms, found);
+
+        auto const index_ms = median_ms(runs, [&] {
+            found = doc->getItemsPartiallyInBox(0, area).size();
+        });
+        std::printf("%-40s %12.2f %10zu\n", ("index, " + std::to_string(size) + "x" + std::to_string(size) + " rooms").c_str(), index_ms, found);
+    }
+
+    // Moving one room and querying again re-indexes only that room.
+    auto room = cast<SPItem>(doc->getObjectById("room0"));
+    int step = 0;
+    auto const move_ms = median_ms(runs, [&] {
+        room->setAttribute("transform", "translate(" + std::to_string(++step) + ",0)");
+        doc->ensureUpToDate();
+        found = doc->getItemsPartiallyInBox(0, Geom::Rect(0, 0, room_size, room_size)).size();
+    });
+    std::printf("%-40s %12.2f %10zu\n", "move one room, update and query", move_ms, found);
+
+    return 0;
+}
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4 :
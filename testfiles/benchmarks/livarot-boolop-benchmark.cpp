@@ -0,0 +1,134 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+/** @file
+ * Benchmark of the boolean operations of livarot.
+ *
+ * Usage: benchmark_livarot-boolop [--runs N] [--seconds S] [--points N]
+ *
+ * Runs each operation of sp_pathvector_boolop(), forced through livarot, on the rectangles of
+ * path-boolop-test and on two self-intersecting stars of the given number of points, and prints
+ * the number of operations per second. Small inputs are dominated by the allocations of the
+ * sweep, large ones by the sweep itself.
+ */
+/*
+ * Copyright (C) 2023 Authors
+ * Released under GNU GPL v2+, read the file 'COPYING' for more information.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <2geom/path.h>
+#include <2geom/pathvector.h>
+
+#include "path/path-boolop.h"
+#include "svg/svg.h"
+
+namespace {
+
+// A star whose edges all cross each other, around (cx, cy).
+Geom::PathVector star(int points, double cx, double cy, double r)
+{
+    auto const step = (points / 2 - 1 + points % 2) * 2 * M_PI / points;
+    Geom::Path path(Geom::Point(cx + r, cy));
+    for (int i = 1; i < points; i++) {
+        path.appendNew<Geom::LineSegment>(Geom::Point(cx + r * std::cos(i * step), cy + r * std::sin(i * step)));
+    }
+    path.close();
+    return Geom::PathVector(path);
+}
+
+// Median of the number of operations per second over the runs, each of which lasts some time.
+double median_ops(int runs, double seconds, Geom::PathVector const &a, Geom::PathVector const &b, BooleanOp bop)
+{
+    std::vector<double> rates;
+    for (int i = 0; i < runs; i++) {
+        auto const start = std::chrono::steady_clock::now();
+        auto const end = start + std::chrono::duration<double>(seconds);
+        long ops = 0;
+        auto now = start;
+        do {
+            sp_pathvector_boolop(a, b, bop, fill_nonZero, fill_nonZero, true);
+            ops++;
+            now = std::chrono::steady_clock::now();
+        } while (now < end);
+        rates.push_back(ops / std::chrono::duration<double>(now - start).count());
+    }
+    std::sort(rates.begin(), rates.end());
+    return rates[rates.size() / 2];
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    int runs = 5;
+    double seconds = 0.5;
+    int points = 201;
+
+    for (int i = 1; i < argc; i++) {
+        if (!std::strcmp(argv[i], "--runs") && i + 1 < argc) {
+            runs = std::max(1, std::atoi(argv[++i]));
+        } else if (!std::strcmp(argv[i], "--seconds") && i + 1 < argc) {
+            seconds = std::max(0.01, std::atof(argv[++i]));
+        } else if (!std::strcmp(argv[i], "--points") && i + 1 < argc) {
+            points = std::max(5, std::atoi(argv[++i]));
+        } else {
+            std::printf("Usage: %s [--runs N] [--seconds S] [--points N]\n", argv[0]);
+            return std::strcmp(argv[i], "--help") ? 1 : 0;
+        }
+    }
+
+    struct Input
+    {
+        std::string name;
+        Geom::PathVector a, b;
+    };
+    // The inputs of path-boolop-test, and two overlapping stars.
+    auto const bigger = sp_svg_read_pathv("M 0,0 L 0,2 L 2,2 L 2,0 z");
+    auto const smaller = sp_svg_read_pathv("M 0.5,0.5 L 0.5,1.5 L 1.5,1.5 L 1.5,0.5 z");
+    auto const outside = sp_svg_read_pathv("M 0,1.5 L 0.5,1.5 L 0.5,2.5 L 0,2.5 z");
+    std::vector<Input> const inputs = {
+        {"rectangles, inside", bigger, smaller},
+        {"rectangles, outside", bigger, outside},
+        {"stars of " + std::to_string(points) + " points", star(points, 0, 0, 100), star(points, 30, 10, 100)},
+    };
+    struct Operation
+    {
+        char const *name;
+        BooleanOp bop;
+    };
+    Operation const operations[] = {
+        {"union", bool_op_union},
+        {"intersection", bool_op_inters},
+        {"difference", bool_op_diff},
+        {"exclusion", bool_op_symdiff},
+    };
+
+    std::printf("%d runs of %g s\n", runs, seconds);
+    std::printf("%-30s %-14s %12s\n", "input", "operation", "ops/s");
+    for (auto const &input : inputs) {
+        for (auto const &operation : operations) {
+            auto const ops = median_ops(runs, seconds, input.a, input.b, operation.bop);
+            std::printf("%-30s %-14s %12.0f\n", input.name.c_str(), operation.name, ops);
+        }
+    }
+
+    return 0;
+}
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4 :
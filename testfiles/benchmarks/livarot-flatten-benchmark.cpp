@@ -0,0 +1,151 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+/** @file
+ * Benchmark of the conversion of livarot paths to polylines.
+ *
+ * Usage: benchmark_livarot-flatten [--runs N] [--threshold T] [FILE.svg...]
+ *
+ * Converts the paths of the shapes in the given documents, by default some of the examples that
+ * come with Inkscape, the way boolean operations do, and prints the number of points and the
+ * time taken by subdividing curves into halves, by the adaptive approximation, and by copying
+ * from the cache of polylines as when the same paths are converted again.
+ */
+/*
+ * Copyright (C) 2023 Authors
+ * Released under GNU GPL v2+, read the file 'COPYING' for more information.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <giomm/init.h>
+#include <2geom/pathvector.h>
+
+#include "document.h"
+#include "inkscape.h"
+#include "inkgc/gc-core.h"
+#include "display/curve.h"
+#include "livarot/Path.h"
+#include "livarot/polyline-cache.h"
+#include "object/sp-root.h"
+#include "object/sp-shape.h"
+#include "path/path-util.h"
+
+namespace {
+
+template <typename F>
+double median_ms(int runs, F &&f)
+{
+    std::vector<double> times;
+    for (int i = 0; i < runs; i++) {
+        auto const start = std::chrono::steady_clock::now();
+        f();
+        times.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    }
+    std::sort(times.begin(), times.end());
+    return times[times.size() / 2];
+}
+
+void collect(std::vector<Geom::PathVector> &result, SPObject *object)
+{
+    if (auto shape = cast<SPShape>(object); shape && shape->curve()) {
+        result.push_back(shape->curve()->get_pathvector() * shape->i2doc_affine());
+    }
+    for (auto &child : object->children) {
+        collect(result, &child);
+    }
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    int runs = 5;
+    double threshold = 0.1;
+    std::vector<std::string> files;
+
+    for (int i = 1; i < argc; i++) {
+        if (!std::strcmp(argv[i], "--runs") && i + 1 < argc) {
+            runs = std::max(1, std::atoi(argv[++i]));
+        } else if (!std::strcmp(argv[i], "--threshold") && i + 1 < argc) {
+            threshold = std::max(1e-4, std::atof(argv[++i]));
+        } else if (argv[i][0] != '-') {
+            files.emplace_back(argv[i]);
+        } else {
+            std::printf("Usage: %s [--runs N] [--threshold T] [FILE.svg...]\n", argv[0]);
+            return std::strcmp(argv[i], "--help") ? 1 : 0;
+        }
+    }
+    if (files.empty()) {
+        for (auto name : {"art-nouveau-P3", "eastern-motive-P4G", "markers", "tesselation-P3"}) {
+            files.push_back(std::string(INKSCAPE_TESTS_DIR "/../share/examples/") + name + ".svg");
+        }
+    }
+
+    Gio::init();
+    Inkscape::GC::init();
+    Inkscape::Application::create(false);
+
+    auto &cache = PolylineCache::get();
+
+    std::printf("threshold %g, %d runs\n", threshold, runs);
+    std::printf("%-24s %8s %10s %10s %10s %10s %10s\n", "document", "paths", "points", "adaptive",
+                "halves[ms]", "adapt.[ms]", "cached[ms]");
+    for (auto const &file : files) {
+        auto doc = std::unique_ptr<SPDocument>(SPDocument::createNewDoc(file.c_str(), false));
+        if (!doc) {
+            std::fprintf(stderr, "Failed to load %s\n", file.c_str());
+            return 1;
+        }
+        doc->ensureUpToDate();
+
+        std::vector<Geom::PathVector> pathvs;
+        collect(pathvs, doc->getRoot());
+        std::vector<std::unique_ptr<Path>> paths;
+        for (auto const &pathv : pathvs) {
+            paths.push_back(Path_for_pathvector(pathv));
+        }
+
+        std::size_t points = 0;
+        std::size_t adaptive_points = 0;
+        auto convert = [&] (bool adaptive, std::size_t &count) {
+            count = 0;
+            for (auto &path : paths) {
+                path->ConvertWithBackData(threshold, adaptive);
+                count += path->pts.size();
+            }
+        };
+
+        // Without the cache, then with all polylines in it.
+        cache.setBudget(0);
+        auto const halves_ms = median_ms(runs, [&] { convert(false, points); });
+        auto const adaptive_ms = median_ms(runs, [&] { convert(true, adaptive_points); });
+        cache.setBudget(std::size_t{1} << 30);
+        convert(false, points);
+        auto const cached_ms = median_ms(runs, [&] { convert(false, points); });
+        cache.clear();
+        cache.setBudget(PolylineCache::default_budget);
+
+        auto name = file.substr(file.find_last_of('/') + 1);
+        std::printf("%-24s %8zu %10zu %10zu %10.2f %10.2f %10.2f\n", name.c_str(), paths.size(), points,
+                    adaptive_points, halves_ms, adaptive_ms, cached_ms);
+    }
+
+    return 0;
+}
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4 :
@@ -0,0 +1,219 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+/** @file
+ * Benchmark of the reading of SVG path data, in MB/s.
+ *
+ * Usage: benchmark_path-parse [--runs N] [--megabytes N] [FILE...]
+ *
+ * Reads the path data of the given SVG files, or else of generated paths in the styles that
+ * Inkscape, design tools and font converters write, both with lib2geom's SVGPathParser, which
+ * sp_svg_read_pathv() used before, and with sp_svg_read_pathv().
+ */
+/*
+ * Copyright (C) 2023 Authors
+ * Released under GNU GPL v2+, read the file 'COPYING' for more information.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <2geom/path-sink.h>
+#include <2geom/pathvector.h>
+#include <2geom/svg-path-parser.h>
+#include <giomm/init.h>
+
+#include "inkgc/gc-core.h"
+#include "svg/svg.h"
+#include "xml/node.h"
+#include "xml/repr.h"
+
+namespace {
+
+struct Sample
+{
+    char const *name;
+    std::vector<std::string> paths;
+    std::size_t bytes = 0;
+};
+
+/// Path data like that of Inkscape, relative with commas, and of design tools, compact and absolute.
+std::string generate_curves(std::mt19937 &rng, bool compact)
+{
+    std::uniform_real_distribution<double> coord(-50, 50);
+    auto const number = [&] {
+        char buf[32];
+        std::snprintf(buf, sizeof(buf), compact ? "%.2f" : "%.6g", coord(rng));
+        std::string str = buf;
+        if (compact && (str.compare(0, 2, "0.") == 0 || str.compare(0, 3, "-0.") == 0)) {
+            str.erase(str.find('0'), 1);
+        }
+        return str;
+    };
+    auto const pair = [&] {
+        auto const y = number();
+        return number() + (compact ? (y[0] == '-' ? "" : " ") : ",") + y;
+    };
+
+    std::string str = compact ? "M" + pair() : "m " + pair();
+    for (int i = 0; i < 200; i++) {
+        switch (rng() % 4) {
+            case 0:
+                str += compact ? "L" + pair() : " l " + pair();
+                break;
+            case 1:
+                str += compact ? "H" + number() : " h " + number();
+                break;
+            default:
+                str += compact ? "C" + pair() + " " + pair() + " " + pair()
+                               : " c " + pair() + " " + pair() + " " + pair();
+                break;
+        }
+    }
+    return str + (compact ? "Z" : " z");
+}
+
+/// Path data like that of converted fonts, of integers, quadratic curves and many subpaths.
+std::string generate_glyphs(std::mt19937 &rng)
+{
+    auto const coord = [&] { return std::to_string(static_cast<int>(rng() % 2048)); };
+    std::string str;
+    for (int contour = 0; contour < 20; contour++) {
+        str += "M" + coord() + " " + coord();
+        for (int i = 0; i < 12; i++) {
+            str += i % 3 ? "Q" + coord() + " " + coord() + " " + coord() + " " + coord() : "V" + coord();
+        }
+        str += "Z";
+    }
+    return str;
+}
+
+void collect_paths(Inkscape::XML::Node const *node, std::vector<std::string> &paths)
+{
+    if (auto d = node->attribute("d")) {
+        paths.emplace_back(d);
+    }
+    for (auto child = node->firstChild(); child; child = child->next()) {
+        collect_paths(child, paths);
+    }
+}
+
+template <typename F>
+double median_ms(int runs, F &&f)
+{
+    std::vector<double> times;
+    for (int i = 0; i < runs; i++) {
+        auto const start = std::chrono::steady_clock::now();
+        f();
+        times.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    }
+    std::sort(times.begin(), times.end());
+    return times[times.size() / 2];
+}
+
+Geom::PathVector read_with_2geom(char const *str)
+{
+    Geom::PathVector pathv;
+    Geom::PathBuilder builder(pathv);
+    Geom::SVGPathParser parser(builder);
+    parser.setZSnapThreshold(Geom::EPSILON);
+    try {
+        parser.parse(str);
+    } catch (Geom::SVGPathParseError &) {
+        builder.flush();
+    }
+    return pathv;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    int runs = 5;
+    int megabytes = 50;
+    std::vector<char const *> files;
+
+    for (int i = 1; i < argc; i++) {
+        if (!std::strcmp(argv[i], "--runs") && i + 1 < argc) {
+            runs = std::max(1, std::atoi(argv[++i]));
+        } else if (!std::strcmp(argv[i], "--megabytes") && i + 1 < argc) {
+            megabytes = std::max(1, std::atoi(argv[++i]));
+        } else if (argv[i][0] == '-') {
+            std::printf("Usage: %s [--runs N] [--megabytes N] [FILE...]\n", argv[0]);
+            return std::strcmp(argv[i], "--help") ? 1 : 0;
+        } else {
+            files.push_back(argv[i]);
+        }
+    }
+
+    Gio::init();
+    Inkscape::GC::init();
+
+    std::vector<Sample> samples;
+    for (auto file : files) {
+        auto doc = sp_repr_read_file(file, SP_SVG_NS_URI);
+        if (!doc) {
+            std::fprintf(stderr, "Failed to read %s\n", file);
+            return 1;
+        }
+        samples.push_back({file, {}});
+        collect_paths(doc->root(), samples.back().paths);
+        Inkscape::GC::release(doc);
+    }
+    if (files.empty()) {
+        std::mt19937 rng(1);
+        samples.push_back({"relative, with commas", {}});
+        samples.push_back({"absolute, compact", {}});
+        samples.push_back({"font glyphs", {}});
+        auto const bytes = megabytes * 1048576.0 / samples.size();
+        for (std::size_t i = 0; i < samples.size(); i++) {
+            for (std::size_t size = 0; size < bytes;) {
+                auto str = i == 2 ? generate_glyphs(rng) : generate_curves(rng, i == 1);
+                size += str.size();
+                samples[i].paths.push_back(std::move(str));
+            }
+        }
+    }
+
+    std::printf("%d runs\n", runs);
+    std::printf("%-32s %10s %18s %18s\n", "path data", "MiB", "SVGPathParser MB/s", "sp_svg_read_pathv MB/s");
+    for (auto &sample : samples) {
+        for (auto const &str : sample.paths) {
+            sample.bytes += str.size();
+        }
+        std::size_t segments[2] = {0, 0};
+        auto const throughput = [&] (Geom::PathVector (*read)(char const *), std::size_t &count) {
+            auto const ms = median_ms(runs, [&] {
+                count = 0;
+                for (auto const &str : sample.paths) {
+                    count += read(str.c_str()).curveCount();
+                }
+            });
+            return sample.bytes / 1e6 / (ms / 1000.0);
+        };
+        auto const before = throughput(&read_with_2geom, segments[0]);
+        auto const after = throughput(&sp_svg_read_pathv, segments[1]);
+        if (segments[0] != segments[1]) {
+            std::fprintf(stderr, "%s: %zu segments read by SVGPathParser, %zu by sp_svg_read_pathv\n", sample.name,
+                         segments[0], segments[1]);
+        }
+        std::printf("%-32.32s %10.1f %18.1f %18.1f\n", sample.name, sample.bytes / 1048576.0, before, after);
+    }
+    return 0;
+}
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4 :
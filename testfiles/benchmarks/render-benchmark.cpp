@@ -0,0 +1,471 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+/** @file
+ * Benchmark of offscreen rendering of a corpus of documents, with JSON output.
+ *
+ * Usage: benchmark_render [--runs N] [--elements N] [--zoom Z,...] [--threads T,...] [FILE|DIR ...]
+ *
+ * Without FILE or DIR arguments, the corpus is a set of generated documents exercising filters,
+ * gradients, meshes, text, patterns and large numbers of paths, plus the documents in
+ * testfiles/rendering_tests. Every document is rendered at every zoom level with every thread
+ * count, and the median time of each phase (load, update, render, encode) is reported together
+ * with the largest increase of the peak resident set size. Every run happens in a child process,
+ * so that runs do not share caches or memory.
+ *
+ * The JSON is written to standard output and is meant to be kept and compared between releases.
+ */
+/*
+ * Copyright (C) 2023 Authors
+ * Released under GNU GPL v2+, read the file 'COPYING' for more information.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <future>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <boost/asio/post.hpp>
+#include <boost/asio/thread_pool.hpp>
+#include <cairomm/surface.h>
+#include <2geom/int-rect.h>
+#include <2geom/transforms.h>
+
+#include <giomm/init.h>
+#include <glib/gstdio.h>
+#include <glibmm/fileutils.h>
+#include <glibmm/miscutils.h>
+#include <glibmm/stringutils.h>
+
+#include "document.h"
+#include "inkscape.h"
+#include "preferences.h"
+#include "display/drawing.h"
+#include "display/drawing-context.h"
+#include "inkgc/gc-core.h"
+#include "object/sp-root.h"
+
+namespace {
+
+struct Result
+{
+    bool ok;
+    int width, height;
+    double load_ms, update_ms, render_ms, encode_ms;
+    long peak_kib; ///< Increase of the peak resident set size during the run.
+};
+
+double ms_since(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+std::vector<double> parse_list(char const *arg)
+{
+    std::vector<double> result;
+    std::istringstream ss(arg);
+    for (std::string item; std::getline(ss, item, ',');) {
+        if (auto const value = std::atof(item.c_str()); value > 0) {
+            result.push_back(value);
+        }
+    }
+    return result;
+}
+
+/// Parse a list of thread counts, or return an empty list if one of them is not a whole number in
+/// the range of the threading preference.
+std::vector<int> parse_thread_counts(char const *arg)
+{
+    std::vector<int> result;
+    std::istringstream ss(arg);
+    for (std::string item; std::getline(ss, item, ',');) {
+        char *end = nullptr;
+        auto const value = std::strtol(item.c_str(), &end, 10);
+        if (end == item.c_str() || *end || value < 1 || value > 256) {
+            return {};
+        }
+        result.push_back(value);
+    }
+    return result;
+}
+
+std::string json_string(std::string const &s)
+{
+    std::string result = "\"";
+    for (auto c : s) {
+        if (c == '"' || c == '\\') {
+            result += '\\';
+        }
+        result += c;
+    }
+    return result + "\"";
+}
+
+constexpr char const *svg_header =
+    "<svg xmlns=\"http://www.w3.org/2000/svg\" xmlns:xlink=\"http://www.w3.org/1999/xlink\""
+    " width=\"1000\" height=\"1000\" viewBox=\"0 0 1000 1000\">\n";
+
+void generate_paths(std::ostream &out, int elements)
+{
+    out << svg_header;
+    for (int i = 0; i < elements; i++) {
+        out << "<path style=\"fill:#" << std::hex << (i * 2654435761u & 0xffffff) << std::dec
+            << ";stroke:#000;stroke-width:0.5\" d=\"M " << i % 1000 << "," << i * 7 % 1000;
+        for (int j = 0; j < 8; j++) {
+            out << " l " << (j * 7 + i) % 13 - 6 << "," << (j * 5 + i) % 11 - 5;
+        }
+        out << " z\"/>\n";
+    }
+    out << "</svg>\n";
+}
+
+void generate_gradients(std::ostream &out, int elements)
+{
+    out << svg_header << "<defs>\n"
+        << "<linearGradient id=\"l\"><stop offset=\"0\" stop-color=\"#f00\"/><stop offset=\"1\" stop-color=\"#00f\" stop-opacity=\"0.5\"/></linearGradient>\n"
+        << "<radialGradient id=\"r\"><stop offset=\"0\" stop-color=\"#ff0\"/><stop offset=\"1\" stop-color=\"#0f0\"/></radialGradient>\n"
+        << "</defs>\n";
+    for (int i = 0; i < elements / 10; i++) {
+        out << "<rect x=\"" << i * 37 % 950 << "\" y=\"" << i * 53 % 950 << "\" width=\"50\" height=\"50\" fill=\"url(#"
+            << (i % 2 ? 'l' : 'r') << ")\" transform=\"rotate(" << i % 90 << " 500 500)\"/>\n";
+    }
+    out << "</svg>\n";
+}
+
+void generate_filters(std::ostream &out, int elements)
+{
+    out << svg_header << "<defs>\n"
+        << "<filter id=\"blur\"><feGaussianBlur stdDeviation=\"4\"/></filter>\n"
+        << "<filter id=\"noise\"><feTurbulence baseFrequency=\"0.05\" numOctaves=\"3\"/>"
+        << "<feColorMatrix type=\"saturate\" values=\"0.3\"/><feComposite in2=\"SourceGraphic\" operator=\"in\"/></filter>\n"
+        << "<filter id=\"shadow\"><feOffset dx=\"3\" dy=\"3\"/><feGaussianBlur stdDeviation=\"2\" result=\"s\"/>"
+        << "<feMerge><feMergeNode in=\"s\"/><feMergeNode in=\"SourceGraphic\"/></feMerge></filter>\n"
+        << "</defs>\n";
+    char const *filters[] = { "blur", "noise", "shadow" };
+    for (int i = 0; i < elements / 100; i++) {
+        out << "<circle cx=\"" << i * 37 % 1000 << "\" cy=\"" << i * 53 % 1000 << "\" r=\"40\" fill=\"#48c\" filter=\"url(#"
+            << filters[i % 3] << ")\"/>\n";
+    }
+    out << "</svg>\n";
+}
+
+void generate_mesh(std::ostream &out, int elements)
+{
+    out << svg_header << "<defs><meshgradient id=\"m\" x=\"0\" y=\"0\" gradientUnits=\"userSpaceOnUse\">\n";
+    int const n = 4;
+    for (int row = 0; row < n; row++) {
+        out << "<meshrow>";
+        for (int col = 0; col < n; col++) {
+            out << "<meshpatch>";
+            if (row == 0) {
+                out << "<stop path=\"l 250,0\" stop-color=\"#" << (col % 2 ? "f00" : "0f0") << "\"/>";
+            }
+            out << "<stop path=\"l 0,250\" stop-color=\"#" << ((row + col) % 2 ? "00f" : "ff0") << "\"/>"
+                << "<stop path=\"l -250,0\" stop-color=\"#" << ((row + col) % 3 ? "0ff" : "f0f") << "\"/>";
+            if (col == 0) {
+                out << "<stop path=\"l 0,-250\" stop-color=\"#fff\"/>";
+            }
+            out << "</meshpatch>";
+        }
+        out << "</meshrow>\n";
+    }
+    out << "</meshgradient></defs>\n";
+    for (int i = 0; i < std::max(1, elements / 1000); i++) {
+        out << "<rect x=\"" << i * 10 % 500 << "\" y=\"" << i * 10 % 500 << "\" width=\"500\" height=\"500\" fill=\"url(#m)\"/>\n";
+    }
+    out << "</svg>\n";
+}
+
+void generate_text(std::ostream &out, int elements)
+{
+    out << svg_header;
+    for (int i = 0; i < elements / 20; i++) {
+        out << "<text x=\"" << i * 131 % 900 << "\" y=\"" << 12 + i * 17 % 980 << "\" style=\"font-family:sans-serif;font-size:"
+            << 8 + i % 5 * 2 << "px\">Line " << i << ": the quick brown fox jumps over the lazy dog</text>\n";
+    }
+    out << "</svg>\n";
+}
+
+void generate_patterns(std::ostream &out, int elements)
+{
+    out << svg_header << "<defs>\n"
+        << "<pattern id=\"p\" width=\"10\" height=\"10\" patternUnits=\"userSpaceOnUse\">"
+        << "<circle cx=\"5\" cy=\"5\" r=\"3\" fill=\"#c84\"/><path d=\"M0,0 L10,10\" stroke=\"#000\"/></pattern>\n"
+        << "<pattern id=\"q\" width=\"23\" height=\"17\" patternUnits=\"userSpaceOnUse\" patternTransform=\"rotate(30)\">"
+        << "<rect width=\"11\" height=\"8\" fill=\"url(#p)\"/></pattern>\n"
+        << "</defs>\n";
+    for (int i = 0; i < elements / 100; i++) {
+        out << "<rect x=\"" << i * 37 % 900 << "\" y=\"" << i * 53 % 900 << "\" width=\"100\" height=\"100\" fill=\"url(#"
+            << (i % 2 ? 'p' : 'q') << ")\"/>\n";
+    }
+    out << "</svg>\n";
+}
+
+std::vector<std::string> generate_corpus(int elements)
+{
+    struct
+    {
+        char const *name;
+        void (*generate)(std::ostream &, int);
+    } const generators[] = {
+        { "paths", &generate_paths },
+        { "gradients", &generate_gradients },
+        { "filters", &generate_filters },
+        { "mesh", &generate_mesh },
+        { "text", &generate_text },
+        { "patterns", &generate_patterns },
+    };
+
+    std::vector<std::string> files;
+    for (auto const &generator : generators) {
+        auto const filename = Glib::build_filename(Glib::get_tmp_dir(), std::string("inkscape-render-benchmark-") + generator.name + ".svg");
+        std::ofstream out(filename);
+        generator.generate(out, elements);
+        files.push_back(filename);
+    }
+    return files;
+}
+
+void add_files(std::vector<std::string> &files, std::string const &path)
+{
+    if (!Glib::file_test(path, Glib::FILE_TEST_IS_DIR)) {
+        files.push_back(path);
+        return;
+    }
+    std::vector<std::string> found;
+    for (auto const &name : Glib::Dir(path)) {
+        if (Glib::str_has_suffix(name, ".svg")) {
+            found.push_back(Glib::build_filename(path, name));
+        }
+    }
+    std::sort(found.begin(), found.end());
+    files.insert(files.end(), found.begin(), found.end());
+}
+
+/**
+ * Load, update, render and encode one document, as the export does.
+ */
+Result run(std::string const &filename, double zoom, int threads)
+{
+    Result result{};
+
+    auto prefs = Inkscape::Preferences::get();
+    prefs->setInt("/options/threading/numthreads", threads);
+
+    auto start = std::chrono::steady_clock::now();
+    auto doc = std::unique_ptr<SPDocument>(SPDocument::createNewDoc(filename.c_str(), false));
+    if (!doc) {
+        return result;
+    }
+    doc->ensureUpToDate();
+    result.load_ms = ms_since(start);
+
+    Geom::Point const origin(doc->getRoot()->x.computed, doc->getRoot()->y.computed);
+    auto const area = (Geom::Rect(origin, origin + doc->getDimensions()) * Geom::Scale(zoom)).roundOutwards();
+    if (area.hasZeroArea() || static_cast<double>(area.width()) * area.height() > (1 << 28)) {
+        return result;
+    }
+    result.width = area.width();
+    result.height = area.height();
+
+    start = std::chrono::steady_clock::now();
+    Inkscape::Drawing drawing;
+    auto const dkey = SPItem::display_key_new(1);
+    drawing.setRoot(doc->getRoot()->invoke_show(drawing, dkey, SP_ITEM_SHOW_DISPLAY));
+    drawing.root()->setTransform(Geom::Scale(zoom));
+    drawing.setExact();
+    drawing.update(area);
+    result.update_ms = ms_since(start);
+
+    // Render in strips on a pool, as the PNG export does.
+    start = std::chrono::steady_clock::now();
+    auto surface = Cairo::ImageSurface::create(Cairo::FORMAT_ARGB32, area.width(), area.height());
+    drawing.snapshot();
+    {
+        boost::asio::thread_pool pool(threads);
+        std::vector<std::future<void>> futures;
+        int const strip = 64;
+        for (int y = area.top(); y < area.bottom(); y += strip) {
+            auto const rect = Geom::IntRect(area.left(), y, area.right(), std::min(y + strip, area.bottom()));
+            auto task = std::make_shared<std::packaged_task<void()>>([&, rect] {
+                auto sub = Cairo::ImageSurface::create(surface->get_data() + (rect.top() - area.top()) * surface->get_stride(),
+                                                       Cairo::FORMAT_ARGB32, rect.width(), rect.height(), surface->get_stride());
+                auto dc = Inkscape::DrawingContext(sub->cobj(), rect.min());
+                drawing.render(dc, rect);
+                sub->flush();
+            });
+            futures.push_back(task->get_future());
+            boost::asio::post(pool, [task] { (*task)(); });
+        }
+        for (auto &future : futures) {
+            future.get();
+        }
+        pool.join();
+    }
+    drawing.unsnapshot();
+    surface->mark_dirty();
+    result.render_ms = ms_since(start);
+
+    start = std::chrono::steady_clock::now();
+    std::size_t encoded = 0;
+    surface->write_to_png_stream([&] (unsigned char const *, unsigned length) {
+        encoded += length;
+        return CAIRO_STATUS_SUCCESS;
+    });
+    result.encode_ms = ms_since(start);
+
+    doc->getRoot()->invoke_hide(dkey);
+    result.ok = encoded > 0;
+    return result;
+}
+
+Result measure(std::string const &filename, double zoom, int threads)
+{
+    Result result{};
+
+    int fds[2];
+    if (pipe(fds) != 0) {
+        return result;
+    }
+
+    auto const pid = fork();
+    if (pid == 0) {
+        close(fds[0]);
+        rusage before, after;
+        getrusage(RUSAGE_SELF, &before);
+        result = run(filename, zoom, threads);
+        getrusage(RUSAGE_SELF, &after);
+        result.peak_kib = after.ru_maxrss - before.ru_maxrss;
+        [[maybe_unused]] auto const written = write(fds[1], &result, sizeof(result));
+        _exit(0);
+    }
+
+    close(fds[1]);
+    if (pid < 0 || read(fds[0], &result, sizeof(result)) != sizeof(result)) {
+        result.ok = false;
+    }
+    close(fds[0]);
+    if (pid > 0) {
+        waitpid(pid, nullptr, 0);
+    }
+    return result;
+}
+
+double median(std::vector<double> values)
+{
+    std::sort(values.begin(), values.end());
+    return values[values.size() / 2];
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    int runs = 3;
+    int elements = 20000;
+    std::vector<double> zooms = { 0.5, 1.0, 4.0 };
+    std::vector<int> threads = { 1, 4 };
+    std::vector<std::string> files;
+
+    for (int i = 1; i < argc; i++) {
+        if (!std::strcmp(argv[i], "--runs") && i + 1 < argc) {
+            runs = std::max(1, std::atoi(argv[++i]));
+        } else if (!std::strcmp(argv[i], "--elements") && i + 1 < argc) {
+            elements = std::max(1, std::atoi(argv[++i]));
+        } else if (!std::strcmp(argv[i], "--zoom") && i + 1 < argc) {
+            zooms = parse_list(argv[++i]);
+        } else if (!std::strcmp(argv[i], "--threads") && i + 1 < argc) {
+            threads = parse_thread_counts(argv[++i]);
+            if (threads.empty()) {
+                std::fprintf(stderr, "--threads needs whole numbers from 1 to 256\n");
+                return 1;
+            }
+        } else if (argv[i][0] == '-') {
+            std::printf("Usage: %s [--runs N] [--elements N] [--zoom Z,...] [--threads T,...] [FILE|DIR ...]\n", argv[0]);
+            return std::strcmp(argv[i], "--help") ? 1 : 0;
+        } else {
+            add_files(files, argv[i]);
+        }
+    }
+    if (zooms.empty()) {
+        std::fprintf(stderr, "--zoom needs at least one positive value\n");
+        return 1;
+    }
+
+    Gio::init();
+    Inkscape::GC::init();
+    if (!Inkscape::Application::exists()) {
+        Inkscape::Application::create(false);
+    }
+    Inkscape::Preferences::get(); // Load preferences up front, so they are not part of the timings.
+
+    std::vector<std::string> generated;
+    if (files.empty()) {
+        generated = generate_corpus(elements);
+        files = generated;
+        add_files(files, INKSCAPE_TESTS_DIR "/rendering_tests");
+    }
+
+    int ret = 0;
+    bool first = true;
+    std::printf("{\n  \"runs\": %d,\n  \"results\": [", runs);
+    for (auto const &file : files) {
+        for (auto zoom : zooms) {
+            for (auto thread_count : threads) {
+                std::vector<double> load, update, render, encode, total;
+                long peak = 0;
+                Result result{};
+                for (int i = 0; i < runs; i++) {
+                    result = measure(file, zoom, thread_count);
+                    if (!result.ok) {
+                        break;
+                    }
+                    load.push_back(result.load_ms);
+                    update.push_back(result.update_ms);
+                    render.push_back(result.render_ms);
+                    encode.push_back(result.encode_ms);
+                    total.push_back(result.load_ms + result.update_ms + result.render_ms + result.encode_ms);
+                    peak = std::max(peak, result.peak_kib);
+                }
+                if (!result.ok) {
+                    std::fprintf(stderr, "Failed to render %s at zoom %g\n", file.c_str(), zoom);
+                    ret = 1;
+                    continue;
+                }
+                std::printf("%s\n    {\"file\": %s, \"zoom\": %g, \"threads\": %d, \"width\": %d, \"height\": %d, "
+                            "\"load_ms\": %.2f, \"update_ms\": %.2f, \"render_ms\": %.2f, \"encode_ms\": %.2f, "
+                            "\"total_ms\": %.2f, \"peak_rss_kib\": %ld}",
+                            first ? "" : ",", json_string(Glib::path_get_basename(file)).c_str(), zoom,
+                            thread_count, result.width, result.height, median(load), median(update),
+                            median(render), median(encode), median(total), peak);
+                std::fflush(stdout);
+                first = false;
+            }
+        }
+    }
+    std::printf("\n  ]\n}\n");
+
+    for (auto const &file : generated) {
+        g_remove(file.c_str());
+    }
+
+    return ret;
+}
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4 :
@@ -0,0 +1,163 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+/** @file
+ * Benchmark of the matching of style sheet rulesets against the elements of a document.
+ *
+ * Usage: benchmark_selector-index [--runs N] [--rules N] [--elements N]
+ *
+ * Loads a generated document like those exported by design tools, with a class rule per style
+ * and elements each using one of them, then times the matching of all elements through
+ * libcroco's selector engine, which tries every ruleset, against the SelectorIndex, which only
+ * tries the candidates. The load time is meant to be compared between builds.
+ */
+/*
+ * Copyright (C) 2023 Authors
+ * Released under GNU GPL v2+, read the file 'COPYING' for more information.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <giomm/init.h>
+#include <glib/gstdio.h>
+#include <glibmm/miscutils.h>
+
+#include "3rdparty/libcroco/src/cr-sel-eng.h"
+
+#include "document.h"
+#include "inkscape.h"
+#include "inkgc/gc-core.h"
+#include "object/selector-index.h"
+#include "object/sp-root.h"
+#include "xml/croco-node-iface.h"
+
+namespace {
+
+template <typename F>
+double median_ms(int runs, F &&f)
+{
+    std::vector<double> times;
+    for (int i = 0; i < runs; i++) {
+        auto const start = std::chrono::steady_clock::now();
+        f();
+        times.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    }
+    std::sort(times.begin(), times.end());
+    return times[times.size() / 2];
+}
+
+std::string generate(int rules, int elements)
+{
+    auto const filename = Glib::build_filename(Glib::get_tmp_dir(), "inkscape-selector-index-benchmark.svg");
+    std::ofstream out(filename);
+    out << "<svg xmlns=\"http://www.w3.org/2000/svg\">\n<style>\n";
+    for (int i = 0; i < rules; i++) {
+        char color[8];
+        std::snprintf(color, sizeof(color), "#%06x", i * 2654435761u % 0x1000000);
+        out << ".cls-" << i << "{fill:" << color << ";stroke-width:" << i % 5 << "}\n";
+    }
+    out << "</style>\n";
+    for (int i = 0; i < elements; i++) {
+        out << "<rect class=\"cls-" << i % rules << "\" x=\"" << i % 1000 << "\" y=\"" << i / 1000 << "\" width=\"1\" height=\"1\"/>\n";
+    }
+    out << "</svg>\n";
+    return filename;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    int runs = 3;
+    int rules = 5000;
+    int elements = 100000;
+
+    for (int i = 1; i < argc; i++) {
+        if (!std::strcmp(argv[i], "--runs") && i + 1 < argc) {
+            runs = std::max(1, std::atoi(argv[++i]));
+        } else if (!std::strcmp(argv[i], "--rules") && i + 1 < argc) {
+            rules = std::max(1, std::atoi(argv[++i]));
+        } else if (!std::strcmp(argv[i], "--elements") && i + 1 < argc) {
+            elements = std::max(1, std::atoi(argv[++i]));
+        } else {
+            std::printf("Usage: %s [--runs N] [--rules N] [--elements N]\n", argv[0]);
+            return std::strcmp(argv[i], "--help") ? 1 : 0;
+        }
+    }
+
+    Gio::init();
+    Inkscape::GC::init();
+    Inkscape::Application::create(false);
+
+    auto const filename = generate(rules, elements);
+    std::unique_ptr<SPDocument> doc;
+    auto const load_ms = median_ms(runs, [&] {
+        doc.reset(SPDocument::createNewDoc(filename.c_str(), false));
+    });
+    g_remove(filename.c_str());
+    if (!doc) {
+        std::fprintf(stderr, "Failed to load the generated document\n");
+        return 1;
+    }
+
+    std::vector<Inkscape::XML::Node *> nodes;
+    for (auto &child : doc->getRoot()->children) {
+        nodes.push_back(child.getRepr());
+    }
+
+    std::printf("%d rules, %zu elements, %d runs\n", rules, nodes.size(), runs);
+    std::printf("%-40s %12s %12s\n", "operation", "median [ms]", "properties");
+    std::printf("%-40s %12.1f %12s\n", "SPDocument::createNewDoc", load_ms, "");
+
+    auto sel_eng = cr_sel_eng_new(&Inkscape::XML::croco_node_iface);
+    auto const cascade = doc->getStyleCascade();
+
+    // Timed once only, as it tries every ruleset for every element.
+    std::size_t found = 0;
+    auto const engine_ms = median_ms(1, [&] {
+        found = 0;
+        for (auto node : nodes) {
+            CRPropList *props = nullptr;
+            cr_sel_eng_get_matched_properties_from_cascade(sel_eng, cascade, node, &props);
+            for (auto pair = props; pair; pair = cr_prop_list_get_next(pair)) {
+                found++;
+            }
+            cr_prop_list_destroy(props);
+        }
+    });
+    std::printf("%-40s %12.1f %12zu\n", "selector engine, all elements", engine_ms, found);
+
+    auto const index_ms = median_ms(runs, [&] {
+        auto index = Inkscape::SelectorIndex();
+        found = 0;
+        for (auto node : nodes) {
+            CRPropList *props = nullptr;
+            index.matchedProperties(sel_eng, cascade, node, &props);
+            for (auto pair = props; pair; pair = cr_prop_list_get_next(pair)) {
+                found++;
+            }
+            cr_prop_list_destroy(props);
+        }
+    });
+    std::printf("%-40s %12.1f %12zu\n", "index (incl. building), all elements", index_ms, found);
+
+    cr_sel_eng_destroy(sel_eng);
+    return 0;
+}
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4 :
@@ -0,0 +1,129 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+/** @file
+ * Report of the memory the styles of a document take.
+ *
+ * Usage: benchmark_style-memory [--elements N]
+ *
+ * Loads a generated document of identically styled paths in a group that sets the font, and
+ * reports the bytes of style per object, now that styles share their string values and the
+ * table of their properties, against what they took when each style had its own.
+ */
+/*
+ * Copyright (C) 2023 Authors
+ * Released under GNU GPL v2+, read the file 'COPYING' for more information.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <giomm/init.h>
+#include <glib/gstdio.h>
+#include <glibmm/miscutils.h>
+
+#include "document.h"
+#include "inkscape.h"
+#include "style.h"
+#include "inkgc/gc-core.h"
+#include "object/sp-root.h"
+
+namespace {
+
+std::string generate(int elements)
+{
+    auto const filename = Glib::build_filename(Glib::get_tmp_dir(), "inkscape-style-memory-benchmark.svg");
+    std::ofstream out(filename);
+    out << "<svg xmlns=\"http://www.w3.org/2000/svg\">\n"
+        << "<g style=\"font-family:'DejaVu Sans';-inkscape-font-specification:'DejaVu Sans Bold'\">\n";
+    for (int i = 0; i < elements; i++) {
+        out << "<path d=\"M " << i % 1000 << "," << i / 1000 << " h 1 v 1 z\""
+            << " style=\"fill:#ff0000;stroke:#000000;stroke-width:0.1;font-feature-settings:'liga' 0\"/>\n";
+    }
+    out << "</g>\n</svg>\n";
+    return filename;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    int elements = 300000;
+
+    for (int i = 1; i < argc; i++) {
+        if (!std::strcmp(argv[i], "--elements") && i + 1 < argc) {
+            elements = std::max(1, std::atoi(argv[++i]));
+        } else {
+            std::printf("Usage: %s [--elements N]\n", argv[0]);
+            return std::strcmp(argv[i], "--help") ? 1 : 0;
+        }
+    }
+
+    Gio::init();
+    Inkscape::GC::init();
+    Inkscape::Application::create(false);
+
+    auto const filename = generate(elements);
+    auto const start = std::chrono::steady_clock::now();
+    auto doc = std::unique_ptr<SPDocument>(SPDocument::createNewDoc(filename.c_str(), false));
+    auto const load_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    g_remove(filename.c_str());
+    if (!doc) {
+        std::fprintf(stderr, "Failed to load the generated document\n");
+        return 1;
+    }
+
+    std::size_t strings = 0;
+    auto const properties = doc->getRoot()->style->properties();
+    for (auto property : properties) {
+        strings += dynamic_cast<SPIString *>(property) != nullptr;
+    }
+
+    // Every object has a style, so count them all.
+    std::size_t objects = 0;
+    std::vector<SPObject *> todo = {doc->getRoot()};
+    while (!todo.empty()) {
+        auto object = todo.back();
+        todo.pop_back();
+        objects++;
+        for (auto &child : object->children) {
+            todo.push_back(&child);
+        }
+    }
+
+    // What the styles take now: the styles themselves, and the distinct string values.
+    auto const stats = SPIString::statistics();
+    double const now = sizeof(SPStyle) + static_cast<double>(stats.bytes) / objects;
+
+    // What they took before: each style had a vector of pointers to its properties and its own
+    // copy of each string value, held by a plain pointer rather than a shared one.
+    double const before = sizeof(SPStyle)
+                        + sizeof(std::vector<SPIBase *>) + properties.size() * sizeof(SPIBase *)
+                        - strings * (sizeof(std::shared_ptr<char>) - sizeof(char *))
+                        + static_cast<double>(stats.unshared_bytes) / objects;
+
+    std::printf("%zu objects loaded in %.1f ms\n", objects, load_ms);
+    std::printf("%zu properties, %zu of them strings; %zu string values held %zu times\n",
+                properties.size(), strings, stats.values, stats.references);
+    std::printf("%-40s %12s %12s\n", "style bytes per object", "before", "now");
+    std::printf("%-40s %12.1f %12.1f\n", "(not counting allocator overhead)", before, now);
+    std::printf("%-40s %12.1f %12.1f\n", "total [MiB]", before * objects / (1 << 20), now * objects / (1 << 20));
+
+    return 0;
+}
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4 :
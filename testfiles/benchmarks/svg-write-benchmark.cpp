@@ -0,0 +1,164 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+/** @file
+ * Benchmark of the writing of the numbers of path data and styles, and of saving a document.
+ *
+ * Usage: benchmark_svg-write [--runs N] [--megabytes N]
+ *
+ * Builds a document of cubic Bézier paths with random coordinates, of about the given size once
+ * saved, then times the writing of their path data with sp_svg_write_path(), of their styles
+ * with SVGOStringStream, and the saving of the whole document with sp_repr_save_file(). The
+ * times are meant to be compared between builds.
+ */
+/*
+ * Copyright (C) 2023 Authors
+ * Released under GNU GPL v2+, read the file 'COPYING' for more information.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <2geom/pathvector.h>
+#include <giomm/init.h>
+#include <glib/gstdio.h>
+#include <glibmm/miscutils.h>
+
+#include "inkgc/gc-core.h"
+#include "preferences.h"
+#include "svg/stringstream.h"
+#include "svg/svg.h"
+#include "xml/document.h"
+#include "xml/node.h"
+#include "xml/repr.h"
+
+namespace {
+
+int const SEGMENTS = 64;  ///< Per path, of about 60 bytes each once written.
+int const SHAPES = 1000;  ///< Distinct paths, which the elements take turns at.
+
+template <typename F>
+double median_ms(int runs, F &&f)
+{
+    std::vector<double> times;
+    for (int i = 0; i < runs; i++) {
+        auto const start = std::chrono::steady_clock::now();
+        f();
+        times.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    }
+    std::sort(times.begin(), times.end());
+    return times[times.size() / 2];
+}
+
+std::vector<Geom::PathVector> generate_shapes()
+{
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<double> coord(0, 1000);
+
+    std::vector<Geom::PathVector> shapes(SHAPES);
+    for (auto &shape : shapes) {
+        Geom::Path path(Geom::Point(coord(rng), coord(rng)));
+        for (int i = 0; i < SEGMENTS; i++) {
+            path.appendNew<Geom::CubicBezier>(Geom::Point(coord(rng), coord(rng)), Geom::Point(coord(rng), coord(rng)),
+                                              Geom::Point(coord(rng), coord(rng)));
+        }
+        path.close();
+        shape.push_back(path);
+    }
+    return shapes;
+}
+
+std::string write_style(int i)
+{
+    Inkscape::SVGOStringStream os;
+    os << "fill:#" << std::hex << (i * 2654435761u & 0xffffff) << std::dec << ";stroke-width:" << 0.1 + i % 97 / 7.0
+       << ";opacity:" << i % 89 / 88.0;
+    return os.str();
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    int runs = 3;
+    int megabytes = 200;
+
+    for (int i = 1; i < argc; i++) {
+        if (!std::strcmp(argv[i], "--runs") && i + 1 < argc) {
+            runs = std::max(1, std::atoi(argv[++i]));
+        } else if (!std::strcmp(argv[i], "--megabytes") && i + 1 < argc) {
+            megabytes = std::max(1, std::atoi(argv[++i]));
+        } else {
+            std::printf("Usage: %s [--runs N] [--megabytes N]\n", argv[0]);
+            return std::strcmp(argv[i], "--help") ? 1 : 0;
+        }
+    }
+
+    Gio::init();
+    Inkscape::GC::init();
+    Inkscape::Preferences::get(); // Load preferences up front, so they are not part of the timings.
+
+    auto const shapes = generate_shapes();
+    auto const bytes_per_element = sp_svg_write_path(shapes.front()).size() + write_style(0).size() + 40;
+    auto const elements = static_cast<int>(megabytes * 1048576.0 / bytes_per_element);
+
+    std::vector<std::string> data(elements);
+    std::vector<std::string> styles(elements);
+    auto const path_ms = median_ms(runs, [&] {
+        for (int i = 0; i < elements; i++) {
+            data[i] = sp_svg_write_path(shapes[i % SHAPES]);
+        }
+    });
+    auto const style_ms = median_ms(runs, [&] {
+        for (int i = 0; i < elements; i++) {
+            styles[i] = write_style(i);
+        }
+    });
+
+    auto doc = sp_repr_document_new("svg:svg");
+    for (int i = 0; i < elements; i++) {
+        auto repr = doc->createElement("svg:path");
+        repr->setAttribute("style", styles[i]);
+        repr->setAttribute("d", data[i]);
+        doc->root()->appendChild(repr);
+        Inkscape::GC::release(repr);
+    }
+    data.clear();
+    styles.clear();
+
+    auto const filename = Glib::build_filename(Glib::get_tmp_dir(), "inkscape-svg-write-benchmark.svg");
+    bool saved = true;
+    auto const save_ms = median_ms(runs, [&] {
+        saved = saved && sp_repr_save_file(doc, filename.c_str(), SP_SVG_NS_URI);
+    });
+    auto const size = std::ifstream(filename, std::ios::binary | std::ios::ate).tellg();
+    g_remove(filename.c_str());
+    Inkscape::GC::release(doc);
+    if (!saved) {
+        std::fprintf(stderr, "Failed to save the document to %s\n", filename.c_str());
+        return 1;
+    }
+
+    std::printf("%d elements of %d segments, %.1f MiB saved, %d runs\n", elements, SEGMENTS, size / 1048576.0, runs);
+    std::printf("%-40s %12s\n", "operation", "median [ms]");
+    std::printf("%-40s %12.1f\n", "sp_svg_write_path, all elements", path_ms);
+    std::printf("%-40s %12.1f\n", "SVGOStringStream styles, all elements", style_ms);
+    std::printf("%-40s %12.1f\n", "sp_repr_save_file", save_ms);
+    return 0;
+}
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4 :
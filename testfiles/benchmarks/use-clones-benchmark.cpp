@@ -0,0 +1,153 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+/** @file
+ * Benchmark of the loading of a document of many clones of few symbols.
+ *
+ * Usage: benchmark_use-clones [--runs N] [--symbols N] [--uses N]
+ *
+ * Loads a generated document like a map or a floor plan, with symbols of detailed paths and many
+ * <use> elements of them, then reports the load time, the growth of the resident memory and the
+ * number of distinct curves the clones hold. The numbers are meant to be compared between builds,
+ * e.g. before and after the sharing of the curves of clones, which is all that is shared so far.
+ */
+/*
+ * Copyright (C) 2023 Authors
+ * Released under GNU GPL v2+, read the file 'COPYING' for more information.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include <giomm/init.h>
+#include <glib/gstdio.h>
+#include <glibmm/miscutils.h>
+
+#include "document.h"
+#include "inkscape.h"
+#include "inkgc/gc-core.h"
+#include "object/sp-path.h"
+#include "object/sp-root.h"
+#include "object/sp-use.h"
+
+namespace {
+
+template <typename F>
+double median_ms(int runs, F &&f)
+{
+    std::vector<double> times;
+    for (int i = 0; i < runs; i++) {
+        auto const start = std::chrono::steady_clock::now();
+        f();
+        times.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    }
+    std::sort(times.begin(), times.end());
+    return times[times.size() / 2];
+}
+
+/// The resident memory of the process in MiB, or 0 where /proc is not available.
+double resident_mib()
+{
+    std::ifstream statm("/proc/self/statm");
+    long pages = 0;
+    long resident = 0;
+    if (!(statm >> pages >> resident)) {
+        return 0;
+    }
+    return resident * 4096.0 / 1048576.0;
+}
+
+std::string generate(int symbols, int uses)
+{
+    auto const filename = Glib::build_filename(Glib::get_tmp_dir(), "inkscape-use-clones-benchmark.svg");
+    std::ofstream out(filename);
+    out << "<svg xmlns=\"http://www.w3.org/2000/svg\" xmlns:xlink=\"http://www.w3.org/1999/xlink\">\n<defs>\n";
+    for (int i = 0; i < symbols; i++) {
+        out << "<symbol id=\"s" << i << "\"><path d=\"M 0," << i;
+        for (int j = 0; j < 100; j++) {
+            out << " c " << j % 7 << "," << (i + j) % 5 << " " << j % 3 << "," << j % 11 << " " << (j * i) % 13 << ",1";
+        }
+        out << " z\"/></symbol>\n";
+    }
+    out << "</defs>\n";
+    for (int i = 0; i < uses; i++) {
+        out << "<use xlink:href=\"#s" << i % symbols << "\" x=\"" << i % 1000 * 20 << "\" y=\"" << i / 1000 * 20
+            << "\"/>\n";
+    }
+    out << "</svg>\n";
+    return filename;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    int runs = 3;
+    int symbols = 50;
+    int uses = 100000;
+
+    for (int i = 1; i < argc; i++) {
+        if (!std::strcmp(argv[i], "--runs") && i + 1 < argc) {
+            runs = std::max(1, std::atoi(argv[++i]));
+        } else if (!std::strcmp(argv[i], "--symbols") && i + 1 < argc) {
+            symbols = std::max(1, std::atoi(argv[++i]));
+        } else if (!std::strcmp(argv[i], "--uses") && i + 1 < argc) {
+            uses = std::max(1, std::atoi(argv[++i]));
+        } else {
+            std::printf("Usage: %s [--runs N] [--symbols N] [--uses N]\n", argv[0]);
+            return std::strcmp(argv[i], "--help") ? 1 : 0;
+        }
+    }
+
+    Gio::init();
+    Inkscape::GC::init();
+    Inkscape::Application::create(false);
+
+    auto const filename = generate(symbols, uses);
+    std::unique_ptr<SPDocument> doc;
+    double growth = 0;
+    auto const load_ms = median_ms(runs, [&] {
+        doc.reset();
+        auto const before = resident_mib();
+        doc.reset(SPDocument::createNewDoc(filename.c_str(), false));
+        growth = resident_mib() - before;
+    });
+    g_remove(filename.c_str());
+    if (!doc) {
+        std::fprintf(stderr, "Failed to load the generated document\n");
+        return 1;
+    }
+
+    std::unordered_set<SPCurve const *> curves;
+    for (auto &child : doc->getRoot()->children) {
+        if (auto use = cast<SPUse>(&child); use && use->child && use->child->firstChild()) {
+            if (auto path = cast<SPPath>(use->child->firstChild())) {
+                curves.insert(path->curve());
+            }
+        }
+    }
+
+    std::printf("%d symbols, %d uses, %d runs\n", symbols, uses, runs);
+    std::printf("%-40s %12s\n", "measure", "value");
+    std::printf("%-40s %12.1f\n", "SPDocument::createNewDoc, median [ms]", load_ms);
+    std::printf("%-40s %12.1f\n", "resident memory growth, last run [MiB]", growth);
+    std::printf("%-40s %12zu\n", "distinct curves of the clones", curves.size());
+    return 0;
+}
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4 :
@@ -0,0 +1,187 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+/** @file
+ * Compare load time and peak memory of sp_repr_read_file() and sp_repr_read_file_stream().
+ *
+ * Usage: benchmark_xml-read [--runs N] [--elements N] [FILE]
+ *
+ * Without FILE, a synthetic document with the given number of path elements is generated.
+ * Every load runs in a child process, so that the peak resident set size of one load
+ * is not hidden by that of an earlier one.
+ */
+/*
+ * Copyright (C) 2023 Authors
+ * Released under GNU GPL v2+, read the file 'COPYING' for more information.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <giomm/init.h>
+#include <glib/gstdio.h>
+#include <glibmm/miscutils.h>
+
+#include "inkgc/gc-core.h"
+#include "preferences.h"
+#include "xml/repr.h"
+
+namespace {
+
+struct Result
+{
+    bool ok;
+    double seconds;
+    long peak_kib; ///< Increase of the peak resident set size during the load.
+};
+
+using Loader = Inkscape::XML::Document *(*)(char const *, char const *, bool);
+
+std::string generate(int elements)
+{
+    auto const filename = Glib::build_filename(Glib::get_tmp_dir(), "inkscape-xml-read-benchmark.svg");
+    std::ofstream out(filename);
+    out << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+        << "<svg xmlns=\"http://www.w3.org/2000/svg\" xmlns:inkscape=\"http://www.inkscape.org/namespaces/inkscape\""
+        << " width=\"1000\" height=\"1000\">\n";
+    for (int i = 0; i < elements; i++) {
+        if (i % 100 == 0) {
+            out << (i ? "  </g>\n" : "") << "  <g id=\"layer" << i / 100 << "\" inkscape:groupmode=\"layer\">\n";
+        }
+        out << "    <path id=\"path" << i << "\" style=\"fill:#" << std::hex << (i * 2654435761u & 0xffffff) << std::dec
+            << ";stroke:none\" d=\"M " << i % 1000 << "," << i / 1000;
+        for (int j = 0; j < 16; j++) {
+            out << " l " << (j * 7 + i) % 13 - 6 << "," << (j * 5 + i) % 11 - 5;
+        }
+        out << " z\" />\n";
+    }
+    out << "  </g>\n</svg>\n";
+    return filename;
+}
+
+Result measure(Loader load, std::string const &filename)
+{
+    Result result{};
+
+    int fds[2];
+    if (pipe(fds) != 0) {
+        return result;
+    }
+
+    auto const pid = fork();
+    if (pid == 0) {
+        close(fds[0]);
+
+        rusage before, after;
+        getrusage(RUSAGE_SELF, &before);
+        auto const start = std::chrono::steady_clock::now();
+        auto doc = load(filename.c_str(), SP_SVG_NS_URI, false);
+        auto const end = std::chrono::steady_clock::now();
+        getrusage(RUSAGE_SELF, &after);
+
+        result.ok = doc != nullptr;
+        result.seconds = std::chrono::duration<double>(end - start).count();
+        result.peak_kib = after.ru_maxrss - before.ru_maxrss;
+        [[maybe_unused]] auto const written = write(fds[1], &result, sizeof(result));
+        _exit(0);
+    }
+
+    close(fds[1]);
+    if (pid < 0 || read(fds[0], &result, sizeof(result)) != sizeof(result)) {
+        result.ok = false;
+    }
+    close(fds[0]);
+    if (pid > 0) {
+        waitpid(pid, nullptr, 0);
+    }
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    int runs = 5;
+    int elements = 200000;
+    std::string filename;
+
+    for (int i = 1; i < argc; i++) {
+        if (!std::strcmp(argv[i], "--runs") && i + 1 < argc) {
+            runs = std::max(1, std::atoi(argv[++i]));
+        } else if (!std::strcmp(argv[i], "--elements") && i + 1 < argc) {
+            elements = std::max(1, std::atoi(argv[++i]));
+        } else if (argv[i][0] == '-') {
+            std::printf("Usage: %s [--runs N] [--elements N] [FILE]\n", argv[0]);
+            return std::strcmp(argv[i], "--help") ? 1 : 0;
+        } else {
+            filename = argv[i];
+        }
+    }
+
+    Gio::init();
+    Inkscape::GC::init();
+    Inkscape::Preferences::get(); // Load preferences up front, so they are not part of the timings.
+
+    bool const generated = filename.empty();
+    if (generated) {
+        filename = generate(elements);
+    }
+
+    auto const size = std::ifstream(filename, std::ios::binary | std::ios::ate).tellg();
+    std::printf("%s: %.1f MiB, %d runs\n", filename.c_str(), size / 1048576.0, runs);
+    std::printf("%-26s %12s %12s %16s\n", "loader", "min [ms]", "median [ms]", "peak RSS [MiB]");
+
+    struct
+    {
+        char const *name;
+        Loader load;
+    } const loaders[] = {
+        { "sp_repr_read_file", &sp_repr_read_file },
+        { "sp_repr_read_file_stream", &sp_repr_read_file_stream },
+    };
+
+    int ret = 0;
+    for (auto const &loader : loaders) {
+        std::vector<double> times;
+        long peak = 0;
+        for (int i = 0; i < runs; i++) {
+            auto const result = measure(loader.load, filename);
+            if (!result.ok) {
+                std::fprintf(stderr, "%s failed to load %s\n", loader.name, filename.c_str());
+                ret = 1;
+                break;
+            }
+            times.push_back(result.seconds * 1000.0);
+            peak = std::max(peak, result.peak_kib);
+        }
+        if (times.empty()) {
+            continue;
+        }
+        std::sort(times.begin(), times.end());
+        std::printf("%-26s %12.1f %12.1f %16.1f\n", loader.name, times.front(), times[times.size() / 2], peak / 1024.0);
+    }
+
+    if (generated) {
+        g_remove(filename.c_str());
+    }
+
+    return ret;
+}
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4 :
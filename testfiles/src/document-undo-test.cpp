@@ -0,0 +1,172 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+/** @file
+ * Test the undo history, which stores attribute changes compactly and within a memory limit.
+ */
+/*
+ * Copyright (C) 2023 Authors
+ *
+ * Released under GNU GPL v2+, read the file 'COPYING' for more information.
+ */
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "document.h"
+#include "document-undo.h"
+#include "inkscape.h"
+#include "preferences.h"
+#include "object/sp-object.h"
+
+using namespace Inkscape;
+
+namespace {
+
+char const *const svg = R"(
+<svg xmlns="http://www.w3.org/2000/svg" width="1000" height="1000">
+  <path id="path" d="M 0,0 L 1,1"/>
+  <rect id="rect" x="0" y="0" width="10" height="10"/>
+</svg>)";
+
+class DocumentUndoTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        if (!Application::exists()) {
+            Application::create(false);
+        }
+        Preferences::get()->setInt("/options/undo/memorylimit", 256);
+        doc.reset(SPDocument::createNewDocFromMem(svg, std::strlen(svg), false));
+        ASSERT_TRUE(doc);
+        path = doc->getObjectById("path");
+        rect = doc->getObjectById("rect");
+    }
+
+    void TearDown() override
+    {
+        Preferences::get()->setInt("/options/undo/memorylimit", 256);
+    }
+
+    // A long path with one of its nodes at x.
+    static std::string long_path(int x)
+    {
+        std::string d = "M 0,0";
+        for (int i = 1; i < 1000; i++) {
+            d += " L " + std::to_string(i == 500 ? x : i) + "," + std::to_string(i);
+        }
+        return d;
+    }
+
+    std::unique_ptr<SPDocument> doc;
+    SPObject *path = nullptr;
+    SPObject *rect = nullptr;
+};
+
+} // namespace
+
+TEST_F(DocumentUndoTest, CompactAttributeChanges)
+{
+    std::vector<std::string> values = {path->getAttribute("d")};
+    for (int step = 0; step < 10; step++) {
+        values.push_back(long_path(step));
+        path->setAttribute("d", values.back());
+        rect->setAttribute("x", std::to_string(step));
+        DocumentUndo::done(doc.get(), "Edit", "");
+    }
+
+    // All but the last step store the path deflated, and of the path before only the changed node.
+    EXPECT_LT(DocumentUndo::getUndoMemory(doc.get()), 6 * values.back().size());
+
+    for (int step = 9; step >= 0; step--) {
+        ASSERT_TRUE(DocumentUndo::undo(doc.get()));
+        EXPECT_EQ(path->getAttribute("d"), values[step]);
+        EXPECT_EQ(rect->getAttribute("x"), step ? std::to_string(step - 1) : "0");
+    }
+    EXPECT_FALSE(DocumentUndo::undo(doc.get()));
+
+    for (int step = 1; step <= 10; step++) {
+        ASSERT_TRUE(DocumentUndo::redo(doc.get()));
+        EXPECT_EQ(path->getAttribute("d"), values[step]);
+    }
+    EXPECT_FALSE(DocumentUndo::redo(doc.get()));
+}
+
+TEST_F(DocumentUndoTest, CompactChangesWrittenOverWithoutUndo)
+{
+    auto const original = std::string(path->getAttribute("d"));
+    path->setAttribute("d", long_path(1));
+    DocumentUndo::done(doc.get(), "Edit", "");
+    path->setAttribute("d", long_path(2));
+    DocumentUndo::done(doc.get(), "Edit", "");
+
+    // Such as a path effect or a connector updating the path.
+    {
+        DocumentUndo::ScopedInsensitive no_undo(doc.get());
+        path->setAttribute("d", long_path(5));
+    }
+    rect->setAttribute("x", "5");
+    DocumentUndo::done(doc.get(), "Edit", "");
+
+    // The steps before are compacted, and still restore their values.
+    ASSERT_TRUE(DocumentUndo::undo(doc.get()));
+    EXPECT_EQ(path->getAttribute("d"), long_path(5));
+    EXPECT_STREQ(rect->getAttribute("x"), "0");
+    ASSERT_TRUE(DocumentUndo::undo(doc.get()));
+    EXPECT_EQ(path->getAttribute("d"), long_path(1));
+    ASSERT_TRUE(DocumentUndo::undo(doc.get()));
+    EXPECT_EQ(path->getAttribute("d"), original);
+
+    ASSERT_TRUE(DocumentUndo::redo(doc.get()));
+    EXPECT_EQ(path->getAttribute("d"), long_path(1));
+    ASSERT_TRUE(DocumentUndo::redo(doc.get()));
+    EXPECT_EQ(path->getAttribute("d"), long_path(2));
+}
+
+TEST_F(DocumentUndoTest, MergeRepeatedChanges)
+{
+    // Changes of the same attribute within one step are merged, even with others in between.
+    for (int i = 0; i < 100; i++) {
+        path->setAttribute("d", long_path(i));
+        rect->setAttribute("x", std::to_string(i));
+    }
+    DocumentUndo::done(doc.get(), "Edit", "");
+    EXPECT_LT(DocumentUndo::getUndoMemory(doc.get()), 3 * long_path(0).size());
+
+    ASSERT_TRUE(DocumentUndo::undo(doc.get()));
+    EXPECT_STREQ(path->getAttribute("d"), "M 0,0 L 1,1");
+    EXPECT_STREQ(rect->getAttribute("x"), "0");
+}
+
+TEST_F(DocumentUndoTest, MemoryLimit)
+{
+    Preferences::get()->setInt("/options/undo/memorylimit", 1);
+
+    // Values that have nothing in common, so they cannot be compacted.
+    for (int step = 0; step < 100; step++) {
+        rect->setAttribute("data-test", std::string(50000, 'a' + step % 26));
+        DocumentUndo::done(doc.get(), "Edit", "");
+    }
+    EXPECT_LE(DocumentUndo::getUndoMemory(doc.get()), std::size_t{1} << 20);
+
+    int steps = 0;
+    while (DocumentUndo::undo(doc.get())) {
+        steps++;
+    }
+    EXPECT_GT(steps, 0);
+    EXPECT_LT(steps, 100);
+    EXPECT_EQ(rect->getAttribute("data-test"), std::string(50000, 'a' + (99 - steps) % 26));
+}
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4 :
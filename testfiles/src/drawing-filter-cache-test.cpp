@@ -0,0 +1,128 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+/**
+ * @file
+ * Test that re-rendering the dirty part of the cache of a filtered item gives the same pixels as
+ * rendering it from scratch.
+ */
+/*
+ * Copyright (C) 2023 Authors
+ *
+ * Released under GNU GPL v2+, read the file 'COPYING' for more information.
+ */
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <cairomm/surface.h>
+#include <2geom/int-rect.h>
+
+#include "document.h"
+#include "inkscape.h"
+#include "display/drawing.h"
+#include "display/drawing-context.h"
+#include "display/drawing-surface.h"
+#include "display/nr-filter-gaussian.h"
+#include "object/sp-root.h"
+
+using namespace Inkscape;
+
+namespace {
+
+// The blurred group is large enough to score above the caching threshold.
+char const *const svg = R"(
+<svg xmlns="http://www.w3.org/2000/svg" width="300" height="200">
+  <filter id="blur" x="-0.5" y="-0.5" width="2" height="2">
+    <feGaussianBlur stdDeviation="12"/>
+  </filter>
+  <g filter="url(#blur)">
+    <rect x="40" y="40" width="220" height="120" fill="#c03"/>
+    <rect id="spot" x="130" y="80" width="20" height="20" fill="#00f"/>
+  </g>
+</svg>)";
+
+/// A drawing of a document with caching enabled, hidden again before it is destroyed.
+struct CachedDrawing
+{
+    SPDocument *doc;
+    unsigned key;
+    Drawing drawing;
+
+    CachedDrawing(SPDocument *doc, int blur_quality)
+        : doc(doc)
+        , key(SPItem::display_key_new(1))
+    {
+        drawing.setCacheBudget(64 << 20);
+        drawing.setBlurQuality(blur_quality);
+        drawing.setRoot(doc->getRoot()->invoke_show(drawing, key, SP_ITEM_SHOW_DISPLAY));
+    }
+
+    ~CachedDrawing() { doc->getRoot()->invoke_hide(key); }
+
+    Cairo::RefPtr<Cairo::ImageSurface> render()
+    {
+        auto const area = Geom::IntRect::from_xywh(0, 0, 300, 200);
+        drawing.update();
+        auto surface = Cairo::ImageSurface::create(Cairo::FORMAT_ARGB32, area.width(), area.height());
+        auto ds = DrawingSurface(surface->cobj(), area.min());
+        auto dc = DrawingContext(ds);
+        drawing.render(dc, area);
+        surface->flush();
+        return surface;
+    }
+};
+
+int max_difference(Cairo::RefPtr<Cairo::ImageSurface> const &a, Cairo::RefPtr<Cairo::ImageSurface> const &b)
+{
+    int result = 0;
+    for (int y = 0; y < a->get_height(); y++) {
+        auto p = a->get_data() + y * a->get_stride();
+        auto q = b->get_data() + y * b->get_stride();
+        for (int x = 0; x < a->get_width() * 4; x++) {
+            result = std::max(result, std::abs(p[x] - q[x]));
+        }
+    }
+    return result;
+}
+
+} // namespace
+
+TEST(DrawingFilterCacheTest, PartialRerenderMatchesFull)
+{
+    if (!Application::exists()) {
+        Application::create(false);
+    }
+    auto doc = std::unique_ptr<SPDocument>(SPDocument::createNewDocFromMem(svg, std::strlen(svg), false));
+    ASSERT_TRUE(doc);
+
+    // Normal quality blurs at full resolution, the worst subsamples.
+    for (auto quality : { Filters::BLUR_QUALITY_NORMAL, Filters::BLUR_QUALITY_WORST }) {
+        SCOPED_TRACE(quality);
+        doc->getObjectById("spot")->setAttribute("x", "130");
+        doc->ensureUpToDate();
+
+        CachedDrawing cached(doc.get(), quality);
+        auto const before = cached.render();
+
+        // Moving the spot dirties the cache of the group around its old and new places only.
+        doc->getObjectById("spot")->setAttribute("x", "170");
+        doc->ensureUpToDate();
+        auto const partial = cached.render();
+        EXPECT_GT(max_difference(before, partial), 16);
+
+        auto const full = CachedDrawing(doc.get(), quality).render();
+        EXPECT_LE(max_difference(partial, full), 2);
+    }
+}
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4 :
@@ -0,0 +1,78 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+/**
+ * @file
+ * Test picking in large drawing groups, which goes through a spatial index of the children.
+ */
+/*
+ * Copyright (C) 2023 Authors
+ *
+ * Released under GNU GPL v2+, read the file 'COPYING' for more information.
+ */
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+#include <2geom/int-rect.h>
+#include <2geom/rect.h>
+
+#include "display/curve.h"
+#include "display/drawing.h"
+#include "display/drawing-group.h"
+#include "display/drawing-shape.h"
+
+using namespace Inkscape;
+
+TEST(DrawingPickTest, LargeGroup)
+{
+    auto drawing = Drawing();
+    auto root = new DrawingGroup(drawing);
+    root->setPickChildren(true);
+    drawing.setRoot(root);
+
+    // A row of squares, the first two of which overlap.
+    std::vector<DrawingShape *> shapes;
+    for (int i = 0; i < 1000; i++) {
+        auto shape = new DrawingShape(drawing);
+        auto const x = i == 0 ? 10 : i * 10;
+        shape->setPath(std::make_shared<SPCurve>(Geom::Rect::from_xywh(x, 0, 5, 5)));
+        root->appendChild(shape);
+        shapes.push_back(shape);
+    }
+    drawing.update();
+
+    auto const pick = [&] (double x, double y) {
+        return drawing.pick(Geom::Point(x, y), 0, DrawingItem::PICK_AS_CLIP);
+    };
+
+    auto const picks = drawing.pickCount();
+    auto const visited = drawing.pickVisitedCount();
+    EXPECT_EQ(pick(502, 2), shapes[50]);
+    EXPECT_EQ(pick(9992, 2), shapes[999]);
+    EXPECT_EQ(pick(507, 2), nullptr);
+    EXPECT_EQ(pick(502, 20), nullptr);
+    EXPECT_EQ(drawing.pickCount(), picks + 4);
+    // The root and a few children, rather than all of them.
+    EXPECT_LT(drawing.pickVisitedCount() - visited, 20u);
+
+    // Of overlapping children, the first one is picked, also after reordering.
+    EXPECT_EQ(pick(12, 2), shapes[0]);
+    shapes[1]->setZOrder(0);
+    EXPECT_EQ(pick(12, 2), shapes[1]);
+
+    // Moving a child.
+    shapes[50]->setPath(std::make_shared<SPCurve>(Geom::Rect::from_xywh(500, 20, 5, 5)));
+    drawing.update();
+    EXPECT_EQ(pick(502, 2), nullptr);
+    EXPECT_EQ(pick(502, 22), shapes[50]);
+}
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4 :
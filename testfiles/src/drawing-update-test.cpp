@@ -0,0 +1,111 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+/**
+ * @file
+ * Test that parallel and serial updates of a drawing agree.
+ */
+/*
+ * Copyright (C) 2023 Authors
+ *
+ * Released under GNU GPL v2+, read the file 'COPYING' for more information.
+ */
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+#include <cairomm/surface.h>
+#include <2geom/int-rect.h>
+#include <2geom/rect.h>
+#include <2geom/transforms.h>
+
+#include "preferences.h"
+#include "display/curve.h"
+#include "display/drawing.h"
+#include "display/drawing-context.h"
+#include "display/drawing-group.h"
+#include "display/drawing-shape.h"
+#include "display/drawing-surface.h"
+
+using namespace Inkscape;
+
+namespace {
+
+struct TestDrawing
+{
+    Drawing drawing;
+    std::vector<DrawingItem *> items;
+
+    TestDrawing()
+    {
+        // Groups of groups of shapes, enough of them for the children of the root to be updated in parallel.
+        auto root = new DrawingGroup(drawing);
+        drawing.setRoot(root);
+        for (int i = 0; i < 300; i++) {
+            auto group = new DrawingGroup(drawing);
+            group->setTransform(Geom::Translate(i * 10, 0));
+            root->appendChild(group);
+            items.push_back(group);
+            for (int j = 0; j < 4; j++) {
+                auto shape = new DrawingShape(drawing);
+                shape->setPath(std::make_shared<SPCurve>(Geom::Rect::from_xywh(0, j * 10, 5 + i % 5, 5 + j % 3)));
+                group->appendChild(shape);
+                items.push_back(shape);
+            }
+        }
+    }
+};
+
+} // namespace
+
+TEST(DrawingUpdateTest, ParallelMatchesSerial)
+{
+    auto prefs = Preferences::get();
+
+    prefs->setInt("/options/threading/numthreads", 1);
+    auto serial = TestDrawing();
+    prefs->setInt("/options/threading/numthreads", 4);
+    auto parallel = TestDrawing();
+
+    EXPECT_FALSE(parallel.drawing.firstUpdateTime());
+    EXPECT_FALSE(parallel.drawing.firstRenderTime());
+
+    auto compare = [&] {
+        EXPECT_EQ(parallel.drawing.root()->bbox(), serial.drawing.root()->bbox());
+        ASSERT_EQ(parallel.items.size(), serial.items.size());
+        for (size_t i = 0; i < serial.items.size(); i++) {
+            EXPECT_EQ(parallel.items[i]->bbox(), serial.items[i]->bbox());
+            EXPECT_EQ(parallel.items[i]->drawbox(), serial.items[i]->drawbox());
+            EXPECT_EQ(parallel.items[i]->ctm(), serial.items[i]->ctm());
+        }
+    };
+
+    // First update, which is decided on by the number of children of the root.
+    serial.drawing.update(Geom::IntRect::infinite(), Geom::Scale(2.0));
+    parallel.drawing.update(Geom::IntRect::infinite(), Geom::Scale(2.0));
+    EXPECT_TRUE(parallel.drawing.firstUpdateTime());
+    compare();
+
+    // Later update, which is decided on by the complexity computed in the first one.
+    serial.drawing.update(Geom::IntRect::infinite(), Geom::Scale(3.0), DrawingItem::STATE_ALL, DrawingItem::STATE_ALL);
+    parallel.drawing.update(Geom::IntRect::infinite(), Geom::Scale(3.0), DrawingItem::STATE_ALL, DrawingItem::STATE_ALL);
+    compare();
+
+    // Picking requires an up-to-date state on every item.
+    EXPECT_NE(parallel.drawing.pick(Geom::Point(2, 2), 0, DrawingItem::PICK_AS_CLIP), nullptr);
+
+    auto const area = Geom::IntRect::from_xywh(0, 0, 64, 64);
+    auto surface = Cairo::ImageSurface::create(Cairo::FORMAT_ARGB32, area.width(), area.height());
+    auto dc = DrawingContext(surface->cobj(), area.min());
+    parallel.drawing.render(dc, area);
+    EXPECT_TRUE(parallel.drawing.firstRenderTime());
+}
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4 :
@@ -0,0 +1,194 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+/**
+ * @file
+ * Tests for the glyph mask cache, and for text composited from it against text filled from its
+ * outlines.
+ */
+/*
+ * Copyright (C) 2023 Authors
+ *
+ * Released under GNU GPL v2+, read the file 'COPYING' for more information.
+ */
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <cairomm/surface.h>
+#include <2geom/int-rect.h>
+#include <2geom/pathvector.h>
+#include <2geom/rect.h>
+#include <2geom/transforms.h>
+
+#include "document.h"
+#include "inkscape.h"
+#include "display/drawing.h"
+#include "display/drawing-context.h"
+#include "display/drawing-surface.h"
+#include "display/glyph-cache.h"
+#include "object/sp-root.h"
+
+using namespace Inkscape;
+
+namespace {
+
+Geom::PathVector square()
+{
+    return Geom::PathVector(Geom::Path(Geom::Rect(0, 0, 1, 1)));
+}
+
+auto get(GlyphCache &cache, std::shared_ptr<void const> const &font, int glyph, double scale, Geom::IntPoint subpixel = {0, 0})
+{
+    return cache.get(font, glyph, square(), Geom::Scale(scale), subpixel, CAIRO_FILL_RULE_WINDING, CAIRO_ANTIALIAS_DEFAULT);
+}
+
+struct Difference
+{
+    int max = 0;         ///< Largest difference of a channel.
+    double mean = 0;     ///< Mean difference of the channels of the pixels either rendering covers.
+    double large = 0;    ///< Fraction of those pixels with a channel differing by more than 16.
+};
+
+// Renders a text with the glyph cache and without it, and compares the results.
+Difference compare_text(std::string const &text)
+{
+    if (!Application::exists()) {
+        Application::create(false);
+    }
+    auto const svg = R"(<svg xmlns="http://www.w3.org/2000/svg" width="200" height="100">)" + text + "</svg>";
+    auto doc = std::unique_ptr<SPDocument>(SPDocument::createNewDocFromMem(svg.c_str(), svg.size(), false));
+    EXPECT_TRUE(doc);
+    doc->ensureUpToDate();
+
+    auto const area = Geom::IntRect::from_xywh(0, 0, 200, 100);
+    auto const render = [&] (std::size_t budget) {
+        Drawing drawing;
+        drawing.setGlyphCacheBudget(budget);
+        auto const key = SPItem::display_key_new(1);
+        drawing.setRoot(doc->getRoot()->invoke_show(drawing, key, SP_ITEM_SHOW_DISPLAY));
+        drawing.update();
+        EXPECT_EQ(drawing.glyphCache() != nullptr, budget != 0);
+
+        auto surface = Cairo::ImageSurface::create(Cairo::FORMAT_ARGB32, area.width(), area.height());
+        auto ds = DrawingSurface(surface->cobj(), area.min());
+        auto dc = DrawingContext(ds);
+        drawing.render(dc, area);
+        surface->flush();
+        doc->getRoot()->invoke_hide(key);
+        return surface;
+    };
+    auto const cached = render(1 << 20);
+    auto const filled = render(0);
+
+    Difference result;
+    long covered = 0;
+    long large = 0;
+    long total = 0;
+    for (int y = 0; y < area.height(); y++) {
+        auto p = cached->get_data() + y * cached->get_stride();
+        auto q = filled->get_data() + y * filled->get_stride();
+        for (int x = 0; x < area.width(); x++, p += 4, q += 4) {
+            if (!p[3] && !q[3]) {
+                continue;
+            }
+            covered++;
+            int pixel_max = 0;
+            for (int c = 0; c < 4; c++) {
+                auto const diff = std::abs(p[c] - q[c]);
+                pixel_max = std::max(pixel_max, diff);
+                total += diff;
+            }
+            result.max = std::max(result.max, pixel_max);
+            large += pixel_max > 16;
+        }
+    }
+    EXPECT_GT(covered, 100);
+    if (covered) {
+        result.mean = static_cast<double>(total) / (4 * covered);
+        result.large = static_cast<double>(large) / covered;
+    }
+    return result;
+}
+
+} // namespace
+
+TEST(GlyphCacheTest, Lookup)
+{
+    GlyphCache cache(1 << 20);
+    auto font = std::make_shared<int>(0);
+
+    auto a = get(cache, font, 1, 10.0);
+    ASSERT_TRUE(a);
+    EXPECT_EQ(a->surface->get_format(), Cairo::FORMAT_A8);
+    EXPECT_GE(a->surface->get_width(), 10);
+    EXPECT_GT(cache.size(), 0u);
+
+    // Same glyph at the same scale and position is shared.
+    EXPECT_EQ(get(cache, font, 1, 10.0), a);
+
+    // Anything else is not.
+    EXPECT_NE(get(cache, font, 2, 10.0), a);
+    EXPECT_NE(get(cache, font, 1, 11.0), a);
+    EXPECT_NE(get(cache, font, 1, 10.0, {1, 0}), a);
+    EXPECT_NE(get(cache, std::make_shared<int>(0), 1, 10.0), a);
+
+    // A pixel-aligned square covers whole pixels, one shifted by half a pixel does not.
+    auto const data = a->surface->get_data();
+    auto const stride = a->surface->get_stride();
+    auto const inside = Geom::IntPoint(5, 5) - a->origin;
+    EXPECT_EQ(data[inside.y() * stride + inside.x()], 255);
+    auto const edge = Geom::IntPoint(0, 5) - a->origin;
+    EXPECT_EQ(data[edge.y() * stride + edge.x()], 255);
+    auto b = get(cache, font, 1, 10.0, {GlyphCache::subpixel_steps / 2, 0});
+    auto const b_edge = Geom::IntPoint(0, 5) - b->origin;
+    EXPECT_NEAR(b->surface->get_data()[b_edge.y() * b->surface->get_stride() + b_edge.x()], 128, 2);
+}
+
+TEST(GlyphCacheTest, Budget)
+{
+    GlyphCache cache(64 << 10);
+    auto font = std::make_shared<int>(0);
+
+    for (int i = 0; i < 200; i++) {
+        EXPECT_TRUE(get(cache, font, i, 20.0));
+        EXPECT_LE(cache.size(), 64u << 10);
+    }
+
+    // Glyphs too large to be worth caching are refused.
+    EXPECT_FALSE(get(cache, font, 0, 1000.0));
+
+    cache.setBudget(0);
+    EXPECT_EQ(cache.size(), 0u);
+    EXPECT_TRUE(get(cache, font, 0, 20.0)); // Still rendered, just not kept.
+    EXPECT_EQ(cache.size(), 0u);
+}
+
+TEST(GlyphCacheTest, SameAsFilled)
+{
+    // Glyphs apart, at whole pixels, are placed exactly and come out as when filled.
+    auto const apart = compare_text(R"(<text x="10 50 90 130" y="60" style="font-family:sans-serif;font-size:30px;fill:#204080">Abgy</text>)");
+    EXPECT_LE(apart.max, 2);
+
+    // Overlapping glyphs of a translucent fill are filled once, not once for each glyph.
+    auto const overlapping = compare_text(R"(<text x="10 16 22 28 34" y="60" style="font-family:sans-serif;font-size:40px;fill:#000000;fill-opacity:0.5">MMMMM</text>)");
+    EXPECT_LT(overlapping.mean, 2.0);
+    EXPECT_LT(overlapping.large, 0.05);
+
+    // Connected glyphs at fractional positions are only moved by a fraction of a pixel.
+    auto const joined = compare_text(R"(<text x="10.3" y="60.6" style="font-family:serif;font-size:27.3px;fill:#000000">mmmm_____</text>)");
+    EXPECT_LE(joined.max, 255 / GlyphCache::subpixel_steps);
+    EXPECT_LT(joined.mean, 4.0);
+}
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4 :
@@ -0,0 +1,130 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+/** @file
+ * Test the area queries of SPDocument, which go through its spatial index.
+ */
+/*
+ * Copyright (C) 2023 Authors
+ *
+ * Released under GNU GPL v2+, read the file 'COPYING' for more information.
+ */
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+#include <2geom/rect.h>
+
+#include "document.h"
+#include "inkscape.h"
+#include "object/item-index.h"
+#include "object/sp-item.h"
+
+using namespace Inkscape;
+
+namespace {
+
+char const *const svg = R"(
+<svg xmlns="http://www.w3.org/2000/svg" xmlns:inkscape="http://www.inkscape.org/namespaces/inkscape"
+     width="1000" height="1000">
+  <defs>
+    <rect id="def" x="0" y="0" width="10" height="10"/>
+  </defs>
+  <g id="layer1" inkscape:groupmode="layer">
+    <rect id="a" x="0" y="0" width="10" height="10"/>
+    <rect id="b" x="100" y="0" width="10" height="10"/>
+    <g id="group">
+      <rect id="c" x="0" y="20" width="10" height="10"/>
+      <rect id="d" x="500" y="20" width="10" height="10"/>
+    </g>
+    <rect id="hidden" x="0" y="40" width="10" height="10" style="display:none"/>
+  </g>
+  <g id="layer2" inkscape:groupmode="layer" style="display:none">
+    <rect id="e" x="0" y="0" width="10" height="10"/>
+  </g>
+</svg>)";
+
+class ItemIndexTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        if (!Application::exists()) {
+            Application::create(false);
+        }
+        doc.reset(SPDocument::createNewDocFromMem(svg, std::strlen(svg), false));
+        ASSERT_TRUE(doc);
+        doc->ensureUpToDate();
+    }
+
+    std::vector<std::string> ids(std::vector<SPItem *> const &items)
+    {
+        std::vector<std::string> result;
+        for (auto item : items) {
+            result.emplace_back(item->getId());
+        }
+        return result;
+    }
+
+    std::unique_ptr<SPDocument> doc;
+};
+
+using Ids = std::vector<std::string>;
+
+} // namespace
+
+TEST_F(ItemIndexTest, Queries)
+{
+    auto const area = Geom::Rect(-1, -1, 50, 50);
+
+    EXPECT_EQ(ids(doc->getItemsPartiallyInBox(0, area)), (Ids{"a", "group"}));
+    EXPECT_EQ(ids(doc->getItemsInBox(0, area)), Ids{"a"});
+    EXPECT_EQ(ids(doc->getItemsPartiallyInBox(0, area, false, false, false, true)), (Ids{"a", "c"}));
+    EXPECT_EQ(ids(doc->getItemsPartiallyInBox(0, area, true, false, true, true)), (Ids{"a", "c", "group", "hidden", "e"}));
+    EXPECT_EQ(ids(doc->getItemsPartiallyInBox(0, Geom::Rect(200, 0, 300, 10))), Ids{});
+    EXPECT_GT(doc->getItemIndex().size(), 0u);
+}
+
+TEST_F(ItemIndexTest, Updates)
+{
+    auto const area = Geom::Rect(90, -1, 120, 15);
+    EXPECT_EQ(ids(doc->getItemsPartiallyInBox(0, area)), Ids{"b"});
+
+    // Moving an item.
+    doc->getObjectById("a")->setAttribute("x", "95");
+    doc->ensureUpToDate();
+    EXPECT_EQ(ids(doc->getItemsPartiallyInBox(0, area)), (Ids{"a", "b"}));
+
+    // Moving a group moves its children.
+    doc->getObjectById("group")->setAttribute("transform", "translate(100,-20)");
+    doc->ensureUpToDate();
+    EXPECT_EQ(ids(doc->getItemsPartiallyInBox(0, area)), (Ids{"a", "b", "group"}));
+    EXPECT_EQ(ids(doc->getItemsPartiallyInBox(0, area, false, false, false, true)), (Ids{"a", "b", "c"}));
+
+    // Deleting an item.
+    doc->getObjectById("b")->deleteObject();
+    doc->ensureUpToDate();
+    EXPECT_EQ(ids(doc->getItemsPartiallyInBox(0, area)), (Ids{"a", "group"}));
+
+    // Adding an item.
+    auto repr = doc->getReprDoc()->createElement("svg:rect");
+    repr->setAttribute("id", "f");
+    repr->setAttribute("x", "110");
+    repr->setAttribute("width", "5");
+    repr->setAttribute("height", "5");
+    doc->getObjectById("layer1")->getRepr()->appendChild(repr);
+    Inkscape::GC::release(repr);
+    doc->ensureUpToDate();
+    EXPECT_EQ(ids(doc->getItemsPartiallyInBox(0, area)), (Ids{"a", "group", "f"}));
+}
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4 :
@@ -0,0 +1,181 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+/** @file
+ * Test the conversion of livarot paths to polylines: the adaptive approximation of curves and the
+ * cache of polylines.
+ */
+/*
+ * Copyright (C) 2023 Authors
+ *
+ * Released under GNU GPL v2+, read the file 'COPYING' for more information.
+ */
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <vector>
+#include <2geom/bezier-curve.h>
+#include <2geom/point.h>
+
+#include "livarot/Path.h"
+#include "livarot/path-description.h"
+#include "livarot/polyline-cache.h"
+
+namespace {
+
+// Curves of all kinds: an arc, a gentle S, a U-turn, one with a cusp and one with a loop.
+std::vector<Geom::CubicBezier> const curves = {
+    {{0, 0}, {0, 55.23}, {44.77, 100}, {100, 100}},
+    {{0, 0}, {40, 30}, {60, -30}, {100, 0}},
+    {{0, 0}, {300, 0}, {300, 300}, {0, 300}},
+    {{0, 0}, {100, 100}, {0, 100}, {100, 0}},
+    {{0, 0}, {150, 100}, {-50, 100}, {100, 0}},
+};
+
+std::unique_ptr<Path> make_path(std::vector<Geom::CubicBezier> const &beziers, Geom::Point const &offset = {})
+{
+    auto path = std::make_unique<Path>();
+    for (auto const &bezier : beziers) {
+        path->MoveTo(bezier[0] + offset);
+        path->CubicTo(bezier[3] + offset, 3 * (bezier[1] - bezier[0]), 3 * (bezier[3] - bezier[2]));
+    }
+    return path;
+}
+
+// Distance of a point from a polyline.
+double distance(Geom::Point const &p, std::vector<Geom::Point> const &polyline)
+{
+    double result = std::numeric_limits<double>::max();
+    for (std::size_t i = 0; i + 1 < polyline.size(); i++) {
+        auto const a = polyline[i];
+        auto const ab = polyline[i + 1] - a;
+        auto const l = Geom::dot(ab, ab);
+        auto const t = l > 0 ? std::clamp(Geom::dot(p - a, ab) / l, 0.0, 1.0) : 0.0;
+        result = std::min(result, Geom::L2(p - (a + t * ab)));
+    }
+    return result;
+}
+
+// The largest distance of a curve from its polyline, and the number of points inside the curve.
+std::pair<double, std::size_t> approximate(Geom::CubicBezier const &bezier, double threshold, bool adaptive)
+{
+    auto path = make_path({bezier});
+    path->ConvertWithBackData(threshold, adaptive);
+
+    std::vector<Geom::Point> polyline;
+    for (auto const &pt : path->pts) {
+        polyline.push_back(pt.p);
+    }
+
+    double error = 0;
+    for (int i = 0; i <= 1000; i++) {
+        error = std::max(error, distance(bezier.pointAt(i / 1000.0), polyline));
+    }
+    return {error, polyline.size() - 2};
+}
+
+class LivarotFlattenTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        PolylineCache::get().clear();
+        PolylineCache::get().resetStatistics();
+    }
+};
+
+} // namespace
+
+TEST_F(LivarotFlattenTest, AdaptiveFewerPoints)
+{
+    for (double threshold : {0.1, 1.0}) {
+        std::size_t bisected = 0;
+        std::size_t adaptive = 0;
+        for (auto const &bezier : curves) {
+            auto const [error, count] = approximate(bezier, threshold, true);
+            // The flatness test bounds the distance of a curve from its chord by a quarter of the
+            // threshold.
+            EXPECT_LE(error, threshold / 4 + 1e-9);
+            adaptive += count;
+            bisected += approximate(bezier, threshold, false).second;
+        }
+        EXPECT_LT(adaptive, bisected);
+    }
+}
+
+TEST_F(LivarotFlattenTest, BackData)
+{
+    auto path = make_path({curves[1]});
+    path->ConvertWithBackData(0.1, true);
+    auto const &pts = path->pts;
+    ASSERT_GT(pts.size(), 2u);
+    for (std::size_t i = 1; i + 1 < pts.size(); i++) {
+        EXPECT_EQ(pts[i].piece, 1);
+        EXPECT_LT(pts[i - 1].t, pts[i].t);
+        EXPECT_TRUE(Geom::are_near(curves[1].pointAt(pts[i].t), pts[i].p, 1e-9));
+    }
+}
+
+TEST_F(LivarotFlattenTest, Cache)
+{
+    auto path = make_path(curves);
+    path->ConvertWithBackData(0.1);
+    auto const pts = path->pts;
+    EXPECT_EQ(PolylineCache::get().statistics().misses, 1u);
+
+    // The same geometry in another path.
+    auto copy = make_path(curves);
+    copy->ConvertWithBackData(0.1);
+    EXPECT_EQ(PolylineCache::get().statistics().hits, 1u);
+    ASSERT_EQ(copy->pts.size(), pts.size());
+    for (std::size_t i = 0; i < pts.size(); i++) {
+        EXPECT_EQ(copy->pts[i].p, pts[i].p);
+        EXPECT_EQ(copy->pts[i].piece, pts[i].piece);
+        EXPECT_EQ(copy->pts[i].t, pts[i].t);
+    }
+
+    // Another threshold, way of conversion or geometry is another polyline.
+    copy->ConvertWithBackData(0.2);
+    copy->ConvertWithBackData(0.1, true);
+    copy->Convert(0.1);
+    auto moved = make_path(curves, {0, 1});
+    moved->ConvertWithBackData(0.1);
+    EXPECT_EQ(PolylineCache::get().statistics().hits, 1u);
+    EXPECT_EQ(PolylineCache::get().statistics().misses, 5u);
+
+    // Without back data, the points associated with the commands are restored too.
+    std::vector<int> associated;
+    for (auto cmd : copy->descr_cmd) {
+        associated.push_back(cmd->associated);
+        cmd->associated = -1;
+    }
+    copy->Convert(0.1);
+    EXPECT_EQ(PolylineCache::get().statistics().hits, 2u);
+    for (std::size_t i = 0; i < associated.size(); i++) {
+        EXPECT_EQ(copy->descr_cmd[i]->associated, associated[i]);
+    }
+
+    // Paths without curves are not cached.
+    Path lines;
+    lines.MoveTo(Geom::Point(0, 0));
+    lines.LineTo(Geom::Point(10, 0));
+    lines.Convert(0.1);
+    EXPECT_EQ(PolylineCache::get().statistics().misses, 5u);
+
+    EXPECT_GT(PolylineCache::get().size(), 0u);
+    PolylineCache::get().setBudget(0);
+    EXPECT_EQ(PolylineCache::get().size(), 0u);
+    PolylineCache::get().setBudget(PolylineCache::default_budget);
+}
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4 :
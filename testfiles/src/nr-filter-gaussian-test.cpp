@@ -0,0 +1,98 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+/** @file
+ * Tests comparing the vectorized Gaussian blur kernels with the scalar ones.
+ */
+/*
+ * Authors: see git history
+ *
+ * Copyright (C) 2023 Authors
+ * Released under GNU GPL v2+, read the file 'COPYING' for more information.
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdlib>
+#include <cairo.h>
+#include <glib.h>
+
+#include "display/nr-filter-gaussian.h"
+
+using Inkscape::Filters::gaussian_blur_pass;
+
+/// Fill an ARGB32 surface with random premultiplied pixels, with some flat areas mixed in.
+static cairo_surface_t *random_surface(int width, int height)
+{
+    auto surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, width, height);
+    cairo_surface_flush(surface);
+    auto data = cairo_image_surface_get_data(surface);
+    int const stride = cairo_image_surface_get_stride(surface);
+    for (int y = 0; y < height; ++y) {
+        auto px = reinterpret_cast<guint32 *>(data + y * stride);
+        for (int x = 0; x < width; ++x) {
+            if (x < width / 3) {
+                px[x] = 0x80402010; // flat premultiplied colour
+                continue;
+            }
+            guint32 a = g_random_int_range(0, 256);
+            guint32 r = a ? g_random_int_range(0, a + 1) : 0;
+            guint32 g = a ? g_random_int_range(0, a + 1) : 0;
+            guint32 b = a ? g_random_int_range(0, a + 1) : 0;
+            px[x] = a << 24 | r << 16 | g << 8 | b;
+        }
+    }
+    cairo_surface_mark_dirty(surface);
+    return surface;
+}
+
+static int max_channel_difference(cairo_surface_t *a, cairo_surface_t *b)
+{
+    cairo_surface_flush(a);
+    cairo_surface_flush(b);
+    int const width = cairo_image_surface_get_width(a);
+    int const height = cairo_image_surface_get_height(a);
+    int const stride = cairo_image_surface_get_stride(a);
+    int result = 0;
+    for (int y = 0; y < height; ++y) {
+        auto pa = cairo_image_surface_get_data(a) + y * stride;
+        auto pb = cairo_image_surface_get_data(b) + y * stride;
+        for (int i = 0; i < width * 4; ++i) {
+            result = std::max(result, std::abs(pa[i] - pb[i]));
+        }
+    }
+    return result;
+}
+
+TEST(GaussianBlurTest, SimdMatchesScalar)
+{
+    // Deviations up to 3 use the FIR filter, larger ones the IIR filter.
+    for (double deviation : { 0.4, 1.0, 2.5, 3.0, 4.0, 10.0, 30.0 }) {
+        auto scalar = random_surface(123, 77);
+        auto vectorized = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, 123, 77);
+        auto cr = cairo_create(vectorized);
+        cairo_set_source_surface(cr, scalar, 0, 0);
+        cairo_set_operator(cr, CAIRO_OPERATOR_SOURCE);
+        cairo_paint(cr);
+        cairo_destroy(cr);
+
+        for (auto d : { Geom::X, Geom::Y }) {
+            gaussian_blur_pass(scalar, d, deviation, false);
+            gaussian_blur_pass(vectorized, d, deviation, true);
+        }
+
+        EXPECT_LE(max_channel_difference(scalar, vectorized), 1) << "deviation " << deviation;
+
+        cairo_surface_destroy(scalar);
+        cairo_surface_destroy(vectorized);
+    }
+}
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
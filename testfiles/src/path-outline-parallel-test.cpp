@@ -0,0 +1,154 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+/** @file
+ * Test stroke to path of large selections, which outlines the shapes on worker threads.
+ */
+/*
+ * Copyright (C) 2023 Authors
+ *
+ * Released under GNU GPL v2+, read the file 'COPYING' for more information.
+ */
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "document.h"
+#include "inkscape.h"
+#include "preferences.h"
+#include "object/object-set.h"
+#include "object/sp-item.h"
+#include "object/sp-root.h"
+
+using namespace Inkscape;
+
+namespace {
+
+class PathOutlineParallelTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        if (!Application::exists()) {
+            Application::create(false);
+        }
+    }
+
+    void TearDown() override
+    {
+        Preferences::get()->remove("/options/threading/numthreads");
+    }
+
+    // Stroked circles and stars, some of them in groups.
+    static std::string shapes_svg()
+    {
+        std::string svg = R"(<svg xmlns="http://www.w3.org/2000/svg" width="1000" height="1000">)";
+        for (int i = 0; i < 100; i++) {
+            auto const x = std::to_string(i % 10 * 100 + 50);
+            auto const y = std::to_string(i / 10 * 100 + 50);
+            auto const style = R"(" style="fill:#f00;stroke:#000;stroke-width:)" + std::to_string(1 + i % 7) + R"("/>)";
+            if (i % 3 == 0) {
+                svg += "<g>";
+            }
+            svg += R"(<circle cx=")" + x + R"(" cy=")" + y + R"(" r="30)" + style;
+            svg += R"(<path d="M )" + x + "," + y + " c 20,-40 40,40 -10,30 s -30,-50 10,-20 z" + style;
+            if (i % 3 == 0) {
+                svg += "</g>";
+            }
+        }
+        svg += "</svg>";
+        return svg;
+    }
+
+    // Stroked paths that turn back on themselves, whose outlines have joins at half turns.
+    static std::string half_turns_svg()
+    {
+        std::string svg = R"(<svg xmlns="http://www.w3.org/2000/svg" width="1000" height="1000">)";
+        for (int i = 0; i < 100; i++) {
+            auto const x = std::to_string(i % 10 * 100 + 50);
+            auto const y = std::to_string(i / 10 * 100 + 50);
+            svg += R"(<path d="M )" + x + "," + y + R"( l 30,0 l -30,0 l 0,30 l 0,-30 l -20,-20 l 20,20")" +
+                   R"( style="fill:none;stroke:#000;stroke-linejoin:round;stroke-width:)" + std::to_string(2 + i % 5) +
+                   R"("/>)";
+        }
+        svg += "</svg>";
+        return svg;
+    }
+
+    static std::unique_ptr<SPDocument> make_document(std::string const &svg = shapes_svg())
+    {
+        auto doc = std::unique_ptr<SPDocument>(SPDocument::createNewDocFromMem(svg.c_str(), svg.size(), false));
+        doc->ensureUpToDate();
+        return doc;
+    }
+
+    static std::vector<SPItem *> top_items(SPDocument *doc)
+    {
+        std::vector<SPItem *> items;
+        for (auto &child : doc->getRoot()->children) {
+            if (auto item = cast<SPItem>(&child)) {
+                items.push_back(item);
+            }
+        }
+        return items;
+    }
+
+    // The path data of the converted selection, in document order.
+    static std::vector<std::string> strokes_to_paths(int threads, std::string const &svg = shapes_svg())
+    {
+        Preferences::get()->setInt("/options/threading/numthreads", threads);
+        auto doc = make_document(svg);
+        auto set = ObjectSet(doc.get());
+        auto const items = top_items(doc.get());
+        set.add(items.begin(), items.end());
+        EXPECT_TRUE(set.strokesToPaths(false, true));
+
+        std::vector<std::string> result;
+        for (auto item : top_items(doc.get())) {
+            std::vector<SPObject *> todo = {item};
+            while (!todo.empty()) {
+                auto object = todo.back();
+                todo.pop_back();
+                if (auto d = object->getAttribute("d")) {
+                    result.emplace_back(d);
+                }
+                for (auto &child : object->children) {
+                    todo.push_back(&child);
+                }
+            }
+        }
+        return result;
+    }
+};
+
+} // namespace
+
+TEST_F(PathOutlineParallelTest, SameAsSerial)
+{
+    auto const serial = strokes_to_paths(1);
+    auto const parallel = strokes_to_paths(4);
+    // A fill and a stroke for each of the shapes.
+    EXPECT_EQ(serial.size(), 400u);
+    EXPECT_EQ(parallel, serial);
+}
+
+TEST_F(PathOutlineParallelTest, HalfTurns)
+{
+    // The outlines of half turns depend on the joins before them in the same outline only.
+    auto const serial = strokes_to_paths(1, half_turns_svg());
+    EXPECT_EQ(serial.size(), 100u);
+    for (int i = 0; i < 4; i++) {
+        EXPECT_EQ(strokes_to_paths(4, half_turns_svg()), serial) << i;
+    }
+}
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4 :
@@ -0,0 +1,112 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+/** @file
+ * Test the union of many paths, which unites them pairwise in parallel and leaves paths that
+ * overlap no others as they are.
+ */
+/*
+ * Copyright (C) 2023 Authors
+ *
+ * Released under GNU GPL v2+, read the file 'COPYING' for more information.
+ */
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <2geom/pathvector.h>
+#include <2geom/rect.h>
+
+#include "document.h"
+#include "inkscape.h"
+#include "display/curve.h"
+#include "object/object-set.h"
+#include "object/sp-path.h"
+#include "object/sp-root.h"
+
+using namespace Inkscape;
+
+namespace {
+
+class PathUnionTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        if (!Application::exists()) {
+            Application::create(false);
+        }
+        char const *const svg = R"(<svg xmlns="http://www.w3.org/2000/svg" width="1000" height="1000"></svg>)";
+        doc.reset(SPDocument::createNewDocFromMem(svg, std::strlen(svg), false));
+        ASSERT_TRUE(doc);
+    }
+
+    void addRect(ObjectSet &set, double x, double y, double width, double height)
+    {
+        auto repr = doc->getReprDoc()->createElement("svg:rect");
+        repr->setAttribute("x", std::to_string(x));
+        repr->setAttribute("y", std::to_string(y));
+        repr->setAttribute("width", std::to_string(width));
+        repr->setAttribute("height", std::to_string(height));
+        set.add(doc->getRoot()->appendChildRepr(repr));
+        Inkscape::GC::release(repr);
+    }
+
+    Geom::PathVector unite(ObjectSet &set)
+    {
+        doc->ensureUpToDate();
+        EXPECT_TRUE(set.pathUnion(true, true));
+        auto path = cast<SPPath>(set.singleItem());
+        EXPECT_TRUE(path);
+        return path ? path->curve()->get_pathvector() : Geom::PathVector();
+    }
+
+    std::unique_ptr<SPDocument> doc;
+};
+
+} // namespace
+
+TEST_F(PathUnionTest, OverlappingAndDisjoint)
+{
+    auto set = ObjectSet(doc.get());
+
+    // A bar of overlapping squares, and a row of squares apart from each other, interleaved.
+    for (int i = 0; i < 6; i++) {
+        addRect(set, i * 5, 0, 10, 10);
+        addRect(set, 100 + i * 20, 0, 10, 10);
+    }
+
+    auto const pathv = unite(set);
+    ASSERT_EQ(pathv.size(), 7u);
+    EXPECT_EQ(*pathv.boundsExact(), Geom::Rect(0, 0, 210, 10));
+
+    auto const bar = std::count_if(pathv.begin(), pathv.end(), [] (auto const &path) {
+        return *path.boundsExact() == Geom::Rect(0, 0, 35, 10);
+    });
+    EXPECT_EQ(bar, 1);
+}
+
+TEST_F(PathUnionTest, Nested)
+{
+    auto set = ObjectSet(doc.get());
+
+    // Squares within squares unite into the outermost one.
+    for (int i = 0; i < 10; i++) {
+        addRect(set, i, i, 100 - 2 * i, 100 - 2 * i);
+    }
+
+    auto const pathv = unite(set);
+    ASSERT_EQ(pathv.size(), 1u);
+    EXPECT_EQ(*pathv.boundsExact(), Geom::Rect(0, 0, 100, 100));
+}
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4 :
@@ -0,0 +1,151 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+/** @file
+ * Test the index of the rulesets of the style cascade, which must give the same properties as
+ * libcroco's selector engine while trying fewer rulesets.
+ */
+/*
+ * Copyright (C) 2023 Authors
+ *
+ * Released under GNU GPL v2+, read the file 'COPYING' for more information.
+ */
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "3rdparty/libcroco/src/cr-sel-eng.h"
+
+#include "document.h"
+#include "inkscape.h"
+#include "style.h"
+#include "object/selector-index.h"
+#include "object/sp-object.h"
+#include "object/sp-root.h"
+#include "xml/croco-node-iface.h"
+
+using namespace Inkscape;
+
+namespace {
+
+char const *const svg = R"(
+<svg xmlns="http://www.w3.org/2000/svg" width="100" height="100">
+  <style>
+    * { stroke-width: 1 }
+    rect { fill: red }
+    .a { fill: green; stroke: blue !important }
+    .b { fill: yellow }
+    .a.b { opacity: 0.5 }
+    #r2 { fill: black }
+    g > .a { stroke: red }
+    g rect { stroke-width: 2 }
+    circle:first-child, .c { fill: purple }
+    [data-x] { display: none }
+    text.a { font-size: 10px }
+  </style>
+  <style>
+    .b { fill: orange }
+    rect.unused { fill: white }
+  </style>
+  <rect id="r1" class="a" width="1" height="1"/>
+  <rect id="r2" class="a b" width="1" height="1" style="fill: gray"/>
+  <g id="g">
+    <rect id="r3" class=" b  a " width="1" height="1"/>
+    <circle id="c1" r="1"/>
+    <circle id="c2" class="c" r="1" data-x="1"/>
+  </g>
+  <text id="t" class="a">Text</text>
+</svg>)";
+
+class SelectorIndexTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        if (!Application::exists()) {
+            Application::create(false);
+        }
+        doc.reset(SPDocument::createNewDocFromMem(svg, std::strlen(svg), false));
+        ASSERT_TRUE(doc);
+        sel_eng = cr_sel_eng_new(&XML::croco_node_iface);
+    }
+
+    void TearDown() override
+    {
+        cr_sel_eng_destroy(sel_eng);
+    }
+
+    static std::vector<CRDeclaration *> declarations(CRPropList *props)
+    {
+        std::vector<CRDeclaration *> result;
+        for (auto pair = props; pair; pair = cr_prop_list_get_next(pair)) {
+            CRDeclaration *decl = nullptr;
+            cr_prop_list_get_decl(pair, &decl);
+            result.push_back(decl);
+        }
+        cr_prop_list_destroy(props);
+        return result;
+    }
+
+    std::unique_ptr<SPDocument> doc;
+    CRSelEng *sel_eng = nullptr;
+};
+
+} // namespace
+
+TEST_F(SelectorIndexTest, SameAsSelectorEngine)
+{
+    auto index = SelectorIndex();
+    auto const cascade = doc->getStyleCascade();
+
+    std::vector<SPObject *> todo = {doc->getRoot()};
+    while (!todo.empty()) {
+        auto object = todo.back();
+        todo.pop_back();
+        for (auto &child : object->children) {
+            todo.push_back(&child);
+        }
+
+        CRPropList *expected = nullptr;
+        ASSERT_EQ(cr_sel_eng_get_matched_properties_from_cascade(sel_eng, cascade, object->getRepr(), &expected), CR_OK);
+        CRPropList *props = nullptr;
+        ASSERT_EQ(index.matchedProperties(sel_eng, cascade, object->getRepr(), &props), CR_OK);
+        EXPECT_EQ(declarations(props), declarations(expected)) << object->getRepr()->name();
+    }
+    EXPECT_EQ(index.size(), 13u);
+}
+
+TEST_F(SelectorIndexTest, TriesCandidatesOnly)
+{
+    auto index = SelectorIndex();
+    CRPropList *props = nullptr;
+    ASSERT_EQ(index.matchedProperties(sel_eng, doc->getStyleCascade(), doc->getObjectById("r1")->getRepr(), &props), CR_OK);
+    cr_prop_list_destroy(props);
+
+    // *, rect, .a, .a.b, g > .a, g rect, [data-x] and text.a, of the 13 rulesets.
+    EXPECT_EQ(index.triedCount(), 8u);
+}
+
+TEST_F(SelectorIndexTest, StyleSheetChanges)
+{
+    auto rect = doc->getObjectById("r1");
+    EXPECT_STREQ(rect->style->fill.get_value().c_str(), "#008000");
+
+    // Editing a style sheet invalidates the document's index.
+    auto style = doc->getObjectsByElement("style").front();
+    style->getRepr()->firstChild()->setContent("#r1 { fill: blue }");
+    doc->ensureUpToDate();
+    EXPECT_STREQ(rect->style->fill.get_value().c_str(), "#0000ff");
+}
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4 :
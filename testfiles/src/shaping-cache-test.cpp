@@ -0,0 +1,112 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+/** @file
+ * Test the cache of shaped runs of text, which is shared by all text layouts.
+ */
+/*
+ * Copyright (C) 2023 Authors
+ *
+ * Released under GNU GPL v2+, read the file 'COPYING' for more information.
+ */
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <2geom/rect.h>
+
+#include "document.h"
+#include "inkscape.h"
+#include "libnrtype/shaping-cache.h"
+#include "object/sp-item.h"
+
+using namespace Inkscape;
+using Inkscape::Text::ShapingCache;
+
+namespace {
+
+class ShapingCacheTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        if (!Application::exists()) {
+            Application::create(false);
+        }
+        ShapingCache::get().clear();
+        ShapingCache::get().resetStatistics();
+    }
+
+    std::unique_ptr<SPDocument> load(std::string const &body)
+    {
+        auto const svg = "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"1000\" height=\"1000\">" + body + "</svg>";
+        auto doc = std::unique_ptr<SPDocument>(SPDocument::createNewDocFromMem(svg.c_str(), svg.size(), false));
+        doc->ensureUpToDate();
+        return doc;
+    }
+
+    static Geom::OptRect bounds(SPDocument *doc, char const *id)
+    {
+        return cast<SPItem>(doc->getObjectById(id))->documentVisualBounds();
+    }
+};
+
+} // namespace
+
+TEST_F(ShapingCacheTest, IdenticalLabels)
+{
+    std::string body;
+    for (int i = 0; i < 20; i++) {
+        body += "<text id=\"t" + std::to_string(i) + "\" x=\"" + std::to_string(i * 50) +
+                "\" y=\"100\" style=\"font-family:sans-serif;font-size:12px\">Label</text>";
+    }
+    auto doc = load(body);
+
+    // The first label is shaped, the others are copied.
+    auto const statistics = ShapingCache::get().statistics();
+    EXPECT_EQ(statistics.misses, 1u);
+    EXPECT_GE(statistics.hits, 19u);
+    EXPECT_GT(ShapingCache::get().size(), 0u);
+
+    auto const first = bounds(doc.get(), "t0");
+    auto const last = bounds(doc.get(), "t19");
+    ASSERT_TRUE(first && last);
+    EXPECT_NEAR(first->width(), last->width(), 1e-6);
+    EXPECT_NEAR(first->height(), last->height(), 1e-6);
+}
+
+TEST_F(ShapingCacheTest, KeyedByFontAndText)
+{
+    auto doc = load("<text id=\"a\" y=\"100\" style=\"font-family:sans-serif;font-size:12px\">Label</text>"
+                    "<text id=\"b\" y=\"200\" style=\"font-family:sans-serif;font-size:24px\">Label</text>"
+                    "<text id=\"c\" y=\"300\" style=\"font-family:sans-serif;font-size:12px\">Lab</text>");
+
+    EXPECT_EQ(ShapingCache::get().statistics().misses, 3u);
+
+    auto const a = bounds(doc.get(), "a");
+    auto const b = bounds(doc.get(), "b");
+    auto const c = bounds(doc.get(), "c");
+    ASSERT_TRUE(a && b && c);
+    EXPECT_GT(b->width(), a->width());
+    EXPECT_GT(a->width(), c->width());
+}
+
+TEST_F(ShapingCacheTest, Budget)
+{
+    auto doc = load("<text style=\"font-family:sans-serif;font-size:12px\">Label</text>");
+    EXPECT_GT(ShapingCache::get().size(), 0u);
+
+    ShapingCache::get().setBudget(0);
+    EXPECT_EQ(ShapingCache::get().size(), 0u);
+    ShapingCache::get().setBudget(ShapingCache::default_budget);
+}
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4 :
@@ -0,0 +1,114 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+/** @file
+ * Test that the search for snap candidates only visits the items near the snapped points.
+ */
+/*
+ * Copyright (C) 2023 Authors
+ *
+ * Released under GNU GPL v2+, read the file 'COPYING' for more information.
+ */
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <2geom/rect.h>
+
+#include "document.h"
+#include "inkscape.h"
+#include "snap.h"
+#include "display/drawing.h"
+#include "object/sp-item.h"
+#include "object/sp-root.h"
+
+using namespace Inkscape;
+
+namespace {
+
+/// A grid of 30 by 30 squares, an ignored square and a hidden one over the square of column and row 10.
+std::string grid_svg()
+{
+    std::string svg = R"(<svg xmlns="http://www.w3.org/2000/svg" xmlns:inkscape="http://www.inkscape.org/namespaces/inkscape" width="600" height="600">)";
+    svg += R"(<g id="layer" inkscape:groupmode="layer">)";
+    for (int y = 0; y < 30; y++) {
+        svg += "<g>";
+        for (int x = 0; x < 30; x++) {
+            auto const id = "r" + std::to_string(x) + "_" + std::to_string(y);
+            svg += "<rect id=\"" + id + "\" x=\"" + std::to_string(x * 20) + "\" y=\"" + std::to_string(y * 20) +
+                   "\" width=\"10\" height=\"10\"/>";
+        }
+        svg += "</g>";
+    }
+    svg += R"(<rect id="ignored" x="200" y="200" width="10" height="10"/>)";
+    svg += R"(<g style="display:none"><rect id="hidden" x="200" y="200" width="10" height="10"/></g>)";
+    svg += "</g></svg>";
+    return svg;
+}
+
+class SnapCandidatesTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        if (!Application::exists()) {
+            Application::create(false);
+        }
+        auto const svg = grid_svg();
+        doc.reset(SPDocument::createNewDocFromMem(svg.c_str(), svg.size(), false));
+        ASSERT_TRUE(doc);
+        doc->ensureUpToDate();
+
+        // Items count as hidden for the views they are not shown in.
+        key = SPItem::display_key_new(1);
+        drawing.setRoot(doc->getRoot()->invoke_show(drawing, key, SP_ITEM_SHOW_DISPLAY));
+    }
+
+    void TearDown() override
+    {
+        doc->getRoot()->invoke_hide(key);
+    }
+
+    std::vector<std::string> visit(Geom::Rect const &area)
+    {
+        std::vector<SPObject const *> ignored = { doc->getObjectById("ignored") };
+        std::vector<std::string> ids;
+        SnapManager::visitCandidateItems(doc.get(), key, &ignored, area, [&] (SPItem *item) {
+            ids.emplace_back(item->getId());
+        });
+        return ids;
+    }
+
+    std::unique_ptr<SPDocument> doc;
+    Drawing drawing;
+    unsigned key = 0;
+};
+
+} // namespace
+
+TEST_F(SnapCandidatesTest, VisitsOnlyNearbyItems)
+{
+    // A point on the square of column and row 10, with a snapping tolerance of 5.
+    auto near = Geom::Rect::from_xywh(205, 205, 0, 0);
+    near.expandBy(5);
+    EXPECT_EQ(visit(near), std::vector<std::string>{ "r10_10" });
+
+    // Nothing is visited between the squares.
+    EXPECT_TRUE(visit(Geom::Rect::from_xywh(212, 212, 4, 4)).empty());
+}
+
+TEST_F(SnapCandidatesTest, VisitsInDocumentOrder)
+{
+    auto const ids = visit(Geom::Rect::from_xywh(195, 195, 30, 30));
+    EXPECT_EQ(ids, (std::vector<std::string>{ "r10_10", "r11_10", "r10_11", "r11_11" }));
+}
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4 :
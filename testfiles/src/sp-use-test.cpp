@@ -0,0 +1,119 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+/** @file
+ * Test the clones of <use> elements, whose paths share their curves.
+ */
+/*
+ * Copyright (C) 2023 Authors
+ *
+ * Released under GNU GPL v2+, read the file 'COPYING' for more information.
+ */
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <memory>
+
+#include "display/curve.h"
+#include "document.h"
+#include "inkscape.h"
+#include "object/sp-path.h"
+#include "object/sp-use.h"
+
+using namespace Inkscape;
+
+namespace {
+
+char const *const svg = R"(
+<svg xmlns="http://www.w3.org/2000/svg" xmlns:xlink="http://www.w3.org/1999/xlink" width="100" height="100">
+  <defs>
+    <path id="p" d="M 0,0 L 10,0 L 10,10 Z"/>
+    <symbol id="s">
+      <path id="sp" d="M 0,0 C 5,5 10,5 10,0 Z"/>
+    </symbol>
+  </defs>
+  <use id="u1" xlink:href="#p"/>
+  <use id="u2" xlink:href="#p" x="20"/>
+  <use id="u3" xlink:href="#p" x="40" style="fill:red"/>
+  <use id="v1" xlink:href="#s"/>
+  <use id="v2" xlink:href="#s" x="20"/>
+</svg>)";
+
+class SPUseTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        if (!Application::exists()) {
+            Application::create(false);
+        }
+        doc.reset(SPDocument::createNewDocFromMem(svg, std::strlen(svg), false));
+        ASSERT_TRUE(doc);
+    }
+
+    /// The path a <use> shows, either its child or the first child of its symbol.
+    SPPath *clonedPath(char const *id)
+    {
+        auto use = cast<SPUse>(doc->getObjectById(id));
+        if (!use || !use->child) {
+            return nullptr;
+        }
+        if (auto path = cast<SPPath>(use->child)) {
+            return path;
+        }
+        return cast<SPPath>(use->child->firstChild());
+    }
+
+    std::unique_ptr<SPDocument> doc;
+};
+
+} // namespace
+
+TEST_F(SPUseTest, ClonesShareCurve)
+{
+    auto original = cast<SPPath>(doc->getObjectById("p"));
+    auto u1 = clonedPath("u1");
+    auto u2 = clonedPath("u2");
+    auto u3 = clonedPath("u3");
+    ASSERT_TRUE(original && u1 && u2 && u3);
+    ASSERT_TRUE(u1->curve());
+
+    EXPECT_TRUE(u1->cloned);
+    EXPECT_EQ(u1->curve(), u2->curve());
+    EXPECT_EQ(u1->curve(), u3->curve());
+    EXPECT_EQ(u1->curve()->get_pathvector(), original->curve()->get_pathvector());
+
+    // The original may be edited in place, so it keeps a curve of its own.
+    EXPECT_FALSE(original->cloned);
+    EXPECT_NE(u1->curve(), original->curve());
+
+    auto v1 = clonedPath("v1");
+    auto v2 = clonedPath("v2");
+    ASSERT_TRUE(v1 && v2);
+    EXPECT_EQ(v1->curve(), v2->curve());
+    EXPECT_NE(v1->curve(), u1->curve());
+}
+
+TEST_F(SPUseTest, ClonesFollowOriginal)
+{
+    auto original = cast<SPPath>(doc->getObjectById("p"));
+    ASSERT_TRUE(original);
+    original->setAttribute("d", "M 0,0 L 20,0 L 20,20 Z");
+    doc->ensureUpToDate();
+
+    auto u1 = clonedPath("u1");
+    auto u2 = clonedPath("u2");
+    ASSERT_TRUE(u1 && u2 && u1->curve());
+    EXPECT_EQ(u1->curve(), u2->curve());
+    EXPECT_EQ(u1->curve()->get_pathvector(), original->curve()->get_pathvector());
+    EXPECT_DOUBLE_EQ(u1->curve()->get_pathvector().boundsExact()->width(), 20);
+}
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4 :
@@ -70,6 +70,33 @@ TEST(StyleInternalTest, testSPIDashArrayValidity)
     // EXPECT_FALSE(array23.is_valid()); // negative total: invalid and removed by 'read'
 }
 
+TEST(StyleInternalTest, testSPIStringSharedValues)
+{
+    auto const before = SPIString::statistics();
+    {
+        SPIString read1, read2, inherited;
+        read1.read("style-internal-test");
+        read2.read("style-internal-test");
+        inherited.cascade(&read1);
+
+        // Equal values are one copy.
+        EXPECT_EQ(read1.value(), read2.value());
+        EXPECT_EQ(inherited.value(), read1.value());
+        auto const stats = SPIString::statistics();
+        EXPECT_EQ(stats.values, before.values + 1);
+        EXPECT_EQ(stats.references, before.references + 3);
+
+        // Which changes for one of them only.
+        read2.read("style-internal-test-2");
+        EXPECT_STREQ(read1.value(), "style-internal-test");
+        EXPECT_STREQ(read2.value(), "style-internal-test-2");
+        EXPECT_STREQ(inherited.value(), "style-internal-test");
+        EXPECT_TRUE(read1 == inherited);
+        EXPECT_FALSE(read1 == read2);
+    }
+    EXPECT_EQ(SPIString::statistics().values, before.values);
+}
+
 /*
   Local Variables:
   mode:c++
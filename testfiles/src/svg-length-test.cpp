@@ -210,6 +210,22 @@ TEST(SvgLengthTest, testPlaces)
     testd_t const precTests[] = {
         {"760", 761.92918978947023, 2, -8},
         {"761.9", 761.92918978947023, 4, -8},
+        {"0", 0.0, 8, -8},
+        {"0", 1e-9, 8, -8},
+        {"-4.5", -4.5, 8, -8},
+        {"1.2345679", 1.23456789, 8, -8},
+        {"12345679", 12345678.9, 8, -8},
+        {"1.2346e8", 123456789, 5, -8},
+        {"0.00123457", 0.00123456789, 8, -8},
+        {"1.2345679e-4", 0.000123456789, 8, -8},
+        {"10", 9.999999999, 8, -8},
+        {"123000", 123000, 3, -8},
+        // Rounded once, not again after rounding to the digits of the fraction.
+        {"-507890", -507894.69563231542, 5, -8},
+        // Rounding up to the next power of ten.
+        {"1e-4", 0.000099999999, 3, -8},
+        // More integral digits than fit an unsigned int.
+        {"10000000000", 1e10, 16, -8},
     };
 
     for (size_t i = 0; i < G_N_ELEMENTS(precTests); i++) {
@@ -221,6 +237,15 @@ TEST(SvgLengthTest, testPlaces)
     }
 }
 
+TEST(SvgLengthTest, testAppendNumber)
+{
+    std::string buf = "M";
+    sp_svg_number_append_de(buf, 761.92918978947023, 4, -8);
+    buf += ',';
+    sp_svg_number_append_de(buf, -0.5, 8, -8);
+    ASSERT_EQ(buf, "M761.9,-0.5");
+}
+
 // TODO: More tests
 
 // vim: filetype=cpp:expandtab:shiftwidth=4:softtabstop=4:fileencoding=utf-8:textwidth=99 :
@@ -338,7 +338,6 @@ TEST_F(SvgPathGeomTest, testReadErrorMisplacedCharacter)
     pv = sp_svg_read_pathv(path_str);
     ASSERT_TRUE(bpathEqual(pv, rectanglepvclosed)) << path_str;
 }
-/*FAIL ??
 TEST_F(SvgPathGeomTest, testReadErrorUnrecognizedCharacter)
 {
     char const *path_str;
@@ -367,7 +366,7 @@ TEST_F(SvgPathGeomTest, testReadErrorTypo)
     pv = sp_svg_read_pathv(path_str);
     ASSERT_TRUE(bpathEqual(pv, rectanglepvopen)) << path_str;
 }
-*/
+
 TEST_F(SvgPathGeomTest, testReadErrorIllformedNumbers)
 {
     char const *path_str;
@@ -411,7 +410,6 @@ TEST_F(SvgPathGeomTest, testReadErrorJunk)
     pv = sp_svg_read_pathv(path_str);
     ASSERT_TRUE(bpathEqual(pv, rectanglepvclosed)) << path_str;
 }
-/* FAIL ???
 TEST_F(SvgPathGeomTest, testReadErrorStopReading)
 {
     char const *path_str;
@@ -434,7 +432,39 @@ TEST_F(SvgPathGeomTest, testReadErrorStopReading)
     pv = sp_svg_read_pathv(path_str);
     ASSERT_TRUE(bpathEqual(pv, rectanglepvopen)) << path_str;
 }
-*/
+
+TEST_F(SvgPathGeomTest, testReadArcs)
+{
+    // Flags need not be separated from what follows them
+    Geom::PathVector pv = sp_svg_read_pathv("M 0,0 a 5,5 0 0010,0 A 5 5 0 1 1 20 0 a 1,1 0 0 0 0,0");
+    ASSERT_EQ(pv.size(), 1u);
+    // The arc ending where it starts is omitted
+    ASSERT_EQ(pv[0].size(), 2u);
+    auto arc = dynamic_cast<Geom::EllipticalArc const *>(&pv[0][0]);
+    ASSERT_TRUE(arc);
+    EXPECT_FALSE(arc->largeArc());
+    EXPECT_FALSE(arc->sweep());
+    EXPECT_EQ(arc->finalPoint(), Geom::Point(10, 0));
+    arc = dynamic_cast<Geom::EllipticalArc const *>(&pv[0][1]);
+    ASSERT_TRUE(arc);
+    EXPECT_TRUE(arc->largeArc());
+    EXPECT_TRUE(arc->sweep());
+    EXPECT_EQ(arc->finalPoint(), Geom::Point(20, 0));
+}
+
+TEST_F(SvgPathGeomTest, testReadClosePathSnapsRelative)
+{
+    // Relative coordinates that nearly return to the start end exactly there when closed
+    Geom::PathVector pv = sp_svg_read_pathv("m 0,0 l 0.1,0 l 0.2,0 l -0.3,0.0000001 z");
+    ASSERT_EQ(pv.size(), 1u);
+    ASSERT_EQ(pv[0].size_open(), 3u);
+    EXPECT_EQ(pv[0][2].finalPoint(), Geom::Point(0, 0));
+
+    // Absolute ones are as given
+    pv = sp_svg_read_pathv("M 0,0 L 10,0 L 0,0.0000001 Z");
+    ASSERT_EQ(pv.size(), 1u);
+    EXPECT_EQ(pv[0][1].finalPoint(), Geom::Point(0, 0.0000001));
+}
 
 TEST_F(SvgPathGeomTest, testRoundTrip)
 {
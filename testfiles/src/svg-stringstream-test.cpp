@@ -125,6 +125,15 @@ TEST(SVGOStringStreamTest, tostring)
     assert_tostring_eq<S, double>(-3.5e9, "-3.5e+09");
 }
 
+TEST(SVGOStringStreamTest, fixed)
+{
+    Inkscape::SVGOStringStream os;
+    os.setf(std::ios::fixed);
+    os.precision(3);
+    os << 1234.56789 << ' ' << 0.5 << ' ' << 3e9 << ' ' << 1e-9;
+    ASSERT_EQ(os.str(), "1234.568 0.5 3000000000 0");
+}
+
 template <typename S>
 void test_concat()
 {
@@ -0,0 +1,168 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+/** @file
+ * Test that the texts of a document laid out in parallel end up where serial layout puts them, and
+ * that the bounding boxes of their ancestors take their layouts into account.
+ */
+/*
+ * Copyright (C) 2023 Authors
+ *
+ * Released under GNU GPL v2+, read the file 'COPYING' for more information.
+ */
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <2geom/rect.h>
+
+#include "document.h"
+#include "inkscape.h"
+#include "preferences.h"
+#include "display/drawing.h"
+#include "display/drawing-item.h"
+#include "object/sp-item.h"
+#include "object/sp-root.h"
+
+using namespace Inkscape;
+
+namespace {
+
+int constexpr count = 64;
+
+class TextLayoutParallelTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        if (!Application::exists()) {
+            Application::create(false);
+        }
+        numthreads = Preferences::get()->getInt("/options/threading/numthreads", 0);
+    }
+
+    void TearDown() override
+    {
+        if (numthreads) {
+            Preferences::get()->setInt("/options/threading/numthreads", numthreads);
+        } else {
+            Preferences::get()->remove("/options/threading/numthreads");
+        }
+    }
+
+    // Lays out a document with texts in several fonts, sizes and directions on the given number
+    // of threads, then changes all of them and lays them out again.
+    std::vector<Geom::OptRect> layout(int threads)
+    {
+        Preferences::get()->setInt("/options/threading/numthreads", threads);
+
+        static char const *const families[] = {"sans-serif", "serif", "monospace"};
+        std::string svg = "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"1000\" height=\"1000\">";
+        for (int i = 0; i < count; i++) {
+            svg += "<text id=\"t" + std::to_string(i) + "\" x=\"10\" y=\"" + std::to_string(20 * i) +
+                   "\" style=\"font-family:" + families[i % 3] + ";font-size:" + std::to_string(8 + i % 7) + "px" +
+                   (i % 5 == 0 ? ";writing-mode:vertical-rl" : "") + "\">Text number " + std::to_string(i) +
+                   "<tspan style=\"font-weight:bold\"> in bold</tspan></text>";
+        }
+        svg += "</svg>";
+
+        auto doc = std::unique_ptr<SPDocument>(SPDocument::createNewDocFromMem(svg.c_str(), svg.size(), false));
+        EXPECT_TRUE(doc);
+        doc->ensureUpToDate();
+
+        std::vector<Geom::OptRect> result;
+        for (int i = 0; i < count; i++) {
+            result.push_back(cast<SPItem>(doc->getObjectById("t" + std::to_string(i)))->documentVisualBounds());
+        }
+        for (int i = 0; i < count; i++) {
+            doc->getObjectById("t" + std::to_string(i))->setAttribute("style", "font-family:serif;font-size:20px");
+        }
+        doc->ensureUpToDate();
+        for (int i = 0; i < count; i++) {
+            result.push_back(cast<SPItem>(doc->getObjectById("t" + std::to_string(i)))->documentVisualBounds());
+        }
+        return result;
+    }
+
+    // The area of the filter of a group of texts, as the drawing has it after the first update of
+    // the document and after the texts were enlarged.
+    std::vector<Geom::OptRect> filterAreas(int threads)
+    {
+        Preferences::get()->setInt("/options/threading/numthreads", threads);
+
+        std::string svg = "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"1000\" height=\"1000\">"
+                          "<filter id=\"f\"><feGaussianBlur stdDeviation=\"2\"/></filter>"
+                          "<g id=\"g\" style=\"filter:url(#f)\">";
+        for (int i = 0; i < count; i++) {
+            svg += "<text id=\"t" + std::to_string(i) + "\" x=\"10\" y=\"" + std::to_string(20 * i) +
+                   "\" style=\"font-size:10px\">Text number " + std::to_string(i) + "</text>";
+        }
+        svg += "</g></svg>";
+
+        auto doc = std::unique_ptr<SPDocument>(SPDocument::createNewDocFromMem(svg.c_str(), svg.size(), false));
+        EXPECT_TRUE(doc);
+        auto group = cast<SPItem>(doc->getObjectById("g"));
+        EXPECT_TRUE(group);
+
+        // Shown before the first update, as a window shows a document it opens.
+        Drawing drawing;
+        auto const key = SPItem::display_key_new(1);
+        drawing.setRoot(doc->getRoot()->invoke_show(drawing, key, SP_ITEM_SHOW_DISPLAY));
+
+        std::vector<Geom::OptRect> result;
+        doc->ensureUpToDate();
+        EXPECT_EQ(group->get_arenaitem(key)->itemBounds(), group->geometricBounds());
+        result.push_back(group->get_arenaitem(key)->itemBounds());
+
+        for (int i = 0; i < count; i++) {
+            doc->getObjectById("t" + std::to_string(i))->setAttribute("style", "font-size:40px");
+        }
+        doc->ensureUpToDate();
+        EXPECT_EQ(group->get_arenaitem(key)->itemBounds(), group->geometricBounds());
+        result.push_back(group->get_arenaitem(key)->itemBounds());
+
+        doc->getRoot()->invoke_hide(key);
+        return result;
+    }
+
+    int numthreads = 0;
+};
+
+} // namespace
+
+TEST_F(TextLayoutParallelTest, SameAsSerial)
+{
+    auto const serial = layout(1);
+    auto const parallel = layout(4);
+    ASSERT_EQ(serial.size(), parallel.size());
+    for (std::size_t i = 0; i < serial.size(); i++) {
+        ASSERT_TRUE(serial[i]) << i;
+        ASSERT_TRUE(parallel[i]) << i;
+        EXPECT_TRUE(Geom::are_near(*serial[i], *parallel[i], 1e-6)) << i;
+    }
+}
+
+TEST_F(TextLayoutParallelTest, AncestorBounds)
+{
+    auto const serial = filterAreas(1);
+    auto const parallel = filterAreas(4);
+    ASSERT_EQ(serial.size(), 2u);
+    ASSERT_EQ(parallel.size(), 2u);
+    for (int i = 0; i < 2; i++) {
+        ASSERT_TRUE(serial[i]) << i;
+        ASSERT_TRUE(parallel[i]) << i;
+        EXPECT_TRUE(Geom::are_near(*serial[i], *parallel[i], 1e-6)) << i;
+    }
+    // Enlarging the texts enlarges the area of the filter.
+    EXPECT_GT(parallel[1]->width(), 2 * parallel[0]->width());
+}
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4 :
@@ -13,8 +13,14 @@
  * Released under GNU GPL v2+, read the file 'COPYING' for more information.
  */
 
+#include <map>
+#include <random>
+
 #include "gtest/gtest.h"
+#include "util/flat_hash_map.h"
+#include "util/interner.h"
 #include "util/longest-common-suffix.h"
+#include "util/lru-cache.h"
 #include "util/parse-int-range.h"
 
 TEST(UtilTest, NearestCommonAncestor)
@@ -112,4 +118,116 @@ TEST(UtilTest, ParseIntRangeTest)
     ASSERT_EQ(Inkscape::parseIntRange("2-4,7-9", 1, 10), std::set<unsigned int>({2,3,4,7,8,9}));
 }
 
+TEST(UtilTest, FlatHashMap)
+{
+    Inkscape::Util::flat_hash_map<std::string, int, Inkscape::Util::string_hash, std::equal_to<>> map;
+    ASSERT_TRUE(map.empty());
+    ASSERT_EQ(map.find("a"), nullptr);
+    ASSERT_FALSE(map.erase("a"));
+
+    ASSERT_TRUE(map.insert("a", 1));
+    ASSERT_FALSE(map.insert("a", 2));
+    ASSERT_EQ(*map.find("a"), 1);
+    ASSERT_EQ(*map.find(std::string_view("ab").substr(0, 1)), 1);
+
+    // Random insertions and erasures, checked against std::map. The small key range makes
+    // for long probe sequences and frequent backward shifts on erasure.
+    std::map<std::string, int> expected{{"a", 1}};
+    std::mt19937 gen(0);
+    for (int i = 0; i < 100000; i++) {
+        auto const key = "id" + std::to_string(gen() % 1000);
+        switch (gen() % 3) {
+            case 0:
+                ASSERT_EQ(map.insert(key, i), expected.emplace(key, i).second);
+                break;
+            case 1:
+                ASSERT_EQ(map.erase(std::string_view(key)), expected.erase(key) == 1);
+                break;
+            default: {
+                auto const found = map.find(key.c_str());
+                auto const it = expected.find(key);
+                ASSERT_EQ(found != nullptr, it != expected.end());
+                if (found) {
+                    ASSERT_EQ(*found, it->second);
+                }
+            }
+        }
+    }
+    ASSERT_EQ(map.size(), expected.size());
+
+    // Pointer keys, whose low bits are all alike.
+    std::vector<double> values(1000);
+    Inkscape::Util::flat_hash_map<double *, int> pointers;
+    for (int i = 0; i < 1000; i++) {
+        ASSERT_TRUE(pointers.insert(&values[i], i));
+    }
+    for (int i = 0; i < 1000; i += 2) {
+        ASSERT_TRUE(pointers.erase(&values[i]));
+    }
+    for (int i = 0; i < 1000; i++) {
+        ASSERT_EQ(pointers.contains(&values[i]), i % 2 == 1);
+    }
+}
+
+TEST(UtilTest, Interner)
+{
+    Inkscape::Util::Interner<std::string> strings;
+    auto const a = strings.intern("value");
+    auto const b = strings.intern(std::string("value").c_str());
+    ASSERT_EQ(a, b);
+    ASSERT_EQ(*a, "value");
+    ASSERT_NE(strings.intern("other"), a);
+
+    int held = 0;
+    strings.for_each([&] (std::string_view key, long references) {
+        ASSERT_EQ(key, "value");
+        ASSERT_EQ(references, 2);
+        held++;
+    });
+    ASSERT_EQ(held, 1);
+
+    // Values are made once while they are held, and made again once they are not.
+    Inkscape::Util::Interner<std::string, std::vector<int>> vectors;
+    int made = 0;
+    auto const make = [&] { made++; return std::vector<int>(3); };
+    auto v = vectors.intern("three", make);
+    ASSERT_EQ(vectors.intern("three", make), v);
+    ASSERT_EQ(made, 1);
+    v.reset();
+    ASSERT_EQ(vectors.intern("three", make)->size(), 3u);
+    ASSERT_EQ(made, 2);
+}
+
+TEST(UtilTest, LRUCache)
+{
+    std::vector<std::string> evicted;
+    Inkscape::Util::LRUCache<std::string, int> cache(100, [&] (std::string const &key, int &) {
+        evicted.push_back(key);
+    });
+    cache.insert("a", 1, 40);
+    cache.insert("b", 2, 40);
+
+    // Visiting "a" makes "b" the least recently used.
+    int value = 0;
+    ASSERT_TRUE(cache.visit("a", [&] (int v) { value = v; }));
+    ASSERT_EQ(value, 1);
+    ASSERT_FALSE(cache.visit("c", [] (int) {}));
+    cache.insert("c", 3, 40);
+    ASSERT_EQ(evicted, std::vector<std::string>{"b"});
+    ASSERT_EQ(cache.size(), 80u);
+
+    // Replacing a value does not evict it; values larger than the budget are not cached.
+    cache.insert("c", 4, 50);
+    cache.insert("d", 5, 101);
+    ASSERT_EQ(evicted, std::vector<std::string>{"b"});
+    ASSERT_FALSE(cache.contains("d"));
+
+    ASSERT_EQ(cache.statistics().hits, 1u);
+    ASSERT_EQ(cache.statistics().misses, 1u);
+
+    cache.setBudget(0);
+    ASSERT_EQ(cache.size(), 0u);
+    ASSERT_EQ(evicted.size(), 3u);
+}
+
 // vim: filetype=cpp:expandtab:shiftwidth=4:softtabstop=4:fileencoding=utf-8:textwidth=99 :
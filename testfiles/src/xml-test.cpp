@@ -72,6 +72,25 @@ TEST(XmlTest, nodeiter)
     ASSERT_EQ(testdoc->root()->findChildPath(path), nullptr);
 }
 
+TEST(XmlTest, readFileStream)
+{
+    // Namespaces, entities, comments, processing instructions, CDATA and xml:space handling.
+    auto const filename = INKSCAPE_TESTS_DIR "/data/xml-read.svg";
+
+    auto tree = std::shared_ptr<Inkscape::XML::Document>(sp_repr_read_file(filename, SP_SVG_NS_URI));
+    auto stream = std::shared_ptr<Inkscape::XML::Document>(sp_repr_read_file_stream(filename, SP_SVG_NS_URI));
+    ASSERT_TRUE(tree);
+    ASSERT_TRUE(stream);
+
+    ASSERT_STREQ(stream->root()->name(), "svg:svg");
+    ASSERT_EQ(sp_repr_save_buf(stream.get()), sp_repr_save_buf(tree.get()));
+
+    // Both loaders skip empty attributes.
+    ASSERT_EQ(stream->root()->attribute("empty"), nullptr);
+
+    ASSERT_EQ(sp_repr_read_file_stream(INKSCAPE_TESTS_DIR "/data/does-not-exist.svg", SP_SVG_NS_URI), nullptr);
+}
+
 /*
   Local Variables:
   mode:c++